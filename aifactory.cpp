@@ -11,28 +11,166 @@
  * @license MIT License
  */
 
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+#include <utility>
 #include "aifactory.h"
+#include "alloctracker.h"
+#include "metrics.h"
 #include "minimaxai.h"
 #include "randomai.h"
+#include "rng.h"
 
 namespace tictactoe {
 
+    namespace {
+        const Metrics::Id AIS_CREATED = Metrics::getInstance().counter("tictactoe_ais_created_total", "AIs constructed by AIFactory");
+        const Metrics::Id AI_POOL_HITS = Metrics::getInstance().counter("tictactoe_ai_pool_hits_total", "AIs handed out warm from the pool");
+
+        using PoolKey = std::pair<AIType, int>; // AI type and board size
+        using Pool = std::map<PoolKey, std::vector<std::unique_ptr<GameAI>>>;
+
+        /**
+         * @brief Gets the AI pool of the calling thread.
+         *
+         * The pool is per thread so game threads never contend on a lock.
+         */
+        Pool& threadPool() {
+            thread_local Pool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Seeds of the AIs handed out by one thread, the run seed and a counter.
+         */
+        struct SeedStream {
+            uint64_t seed;
+            uint64_t count = 0;
+        };
+
+        /**
+         * @brief Gets the seed stream of the calling thread.
+         *
+         * Threads that never call setSeed start from a random seed, so independent runs play differently.
+         */
+        SeedStream& threadSeeds() {
+            thread_local SeedStream stream{ (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}() };
+            return stream;
+        }
+
+        /**
+         * @brief Gets the seed of the next AI handed out by the calling thread.
+         */
+        uint64_t nextSeed() {
+            SeedStream& stream = threadSeeds();
+            return Rng::derive(stream.seed, stream.count++);
+        }
+    }
+
     /**
      * @brief Create an instance of GameAI based on the given type.
      *
+     * AIs that play randomly are seeded from the calling thread's seed stream.
+     *
      * @param type The type of AI to create.
      * @return std::unique_ptr<GameAI> A unique pointer to the created AI instance.
      */
     std::unique_ptr<GameAI> AIFactory::createAI(AIType type) {
+        ALLOC_SCOPE("AIFactory::createAI");
         switch (type) {
-        case AIType::Random: // Random AI
-            return std::make_unique<RandomAI>();
+        case AIType::Random: { // Random AI
+            Metrics::getInstance().add(AIS_CREATED);
+            auto ai = std::make_unique<RandomAI>();
+            ai->setSeed(nextSeed());
+            return ai;
+        }
         case AIType::Minimax: // Minimax AI
+            Metrics::getInstance().add(AIS_CREATED);
             return std::make_unique<MinimaxAI>();
         default:
-            Logger::getInstance().logError("Invalid AI Type", LOG_LOCATION);
+            LOG_ERROR("Invalid AI Type");
             return nullptr;
         }
     }
 
+    /**
+     * @brief Gets a warm AI from the pool, creating one if the pool is empty.
+     *
+     * A pooled AI is reset and reseeded before it is handed out, so it plays exactly like a
+     * new one, but keeps its transposition table and scratch memory.
+     *
+     * @param type The type of AI to get.
+     * @param boardSize The size of the board the AI will play on.
+     * @return std::unique_ptr<GameAI> A unique pointer to the AI instance.
+     */
+    std::unique_ptr<GameAI> AIFactory::acquireAI(AIType type, int boardSize) {
+        Pool& pool = threadPool();
+        auto it = pool.find(PoolKey(type, boardSize));
+        if (it != pool.end() && !it->second.empty()) {
+            std::unique_ptr<GameAI> ai = std::move(it->second.back());
+            it->second.pop_back();
+            ai->reset();
+            ai->setSeed(nextSeed());
+            Metrics::getInstance().add(AI_POOL_HITS);
+            return ai;
+        }
+        return createAI(type);
+    }
+
+    /**
+     * @brief Returns an AI to the pool for reuse by later games.
+     *
+     * @param ai The AI to return, destroyed if the pool for its key is full.
+     * @param boardSize The size of the board the AI played on.
+     */
+    void AIFactory::releaseAI(std::unique_ptr<GameAI> ai, int boardSize) {
+        if (!ai) {
+            return;
+        }
+        std::vector<std::unique_ptr<GameAI>>& idle = threadPool()[PoolKey(ai->getType(), boardSize)];
+        if (static_cast<int>(idle.size()) < MAX_POOLED_PER_KEY) {
+            idle.push_back(std::move(ai));
+        }
+    }
+
+    /**
+     * @brief Creates AIs in advance so the first games do not pay for their creation.
+     *
+     * @param type The type of AI to create.
+     * @param boardSize The size of the board the AIs will play on.
+     * @param count The number of idle AIs to have in the pool.
+     */
+    void AIFactory::reservePool(AIType type, int boardSize, int count) {
+        std::vector<std::unique_ptr<GameAI>>& idle = threadPool()[PoolKey(type, boardSize)];
+        count = std::min(count, MAX_POOLED_PER_KEY);
+        while (static_cast<int>(idle.size()) < count) {
+            std::unique_ptr<GameAI> ai = createAI(type);
+            if (!ai) {
+                return;
+            }
+            idle.push_back(std::move(ai));
+        }
+    }
+
+    /**
+     * @brief Destroys all pooled AIs of the calling thread.
+     */
+    void AIFactory::clearPool() {
+        threadPool().clear();
+    }
+
+    /**
+     * @brief Seeds the AIs the calling thread creates or acquires from now on.
+     *
+     * The n-th AI handed out after this call gets Rng::derive(seed, n), so a thread that
+     * acquires its AIs in a fixed order plays the same games for the same seed.
+     *
+     * @param seed The seed of the stream.
+     */
+    void AIFactory::setSeed(uint64_t seed) {
+        threadSeeds() = SeedStream{ seed, 0 };
+    }
+
 }  // namespace tictactoe
@@ -20,13 +20,46 @@ namespace tictactoe{
 
     /**
     * @brief The AIFactory class.
+    *
+    * Besides creating new AIs, the factory keeps a per-thread pool of released AIs for each
+    * AI type and board size, so their tables and scratch memory are reused by later games.
     */
     class AIFactory{
     public:
+        /**
+         * @brief Maximum number of idle AIs kept per AI type and board size.
+         */
+        static constexpr int MAX_POOLED_PER_KEY = 4;
+
         /**
          * @brief Creates an instance of GameAI based on the provided AIType.
          */
         static std::unique_ptr<GameAI> createAI(AIType type);
+
+        /**
+         * @brief Gets a warm AI from the pool, creating one if the pool is empty.
+         */
+        static std::unique_ptr<GameAI> acquireAI(AIType type, int boardSize);
+
+        /**
+         * @brief Returns an AI to the pool for reuse by later games.
+         */
+        static void releaseAI(std::unique_ptr<GameAI> ai, int boardSize);
+
+        /**
+         * @brief Creates AIs in advance so the first games do not pay for their creation.
+         */
+        static void reservePool(AIType type, int boardSize, int count);
+
+        /**
+         * @brief Destroys all pooled AIs of the calling thread.
+         */
+        static void clearPool();
+
+        /**
+         * @brief Seeds the AIs the calling thread creates or acquires from now on.
+         */
+        static void setSeed(uint64_t seed);
     };
 
 } // namespace tictactoe
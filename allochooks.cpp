@@ -0,0 +1,130 @@
+/**
+ * @file allochooks.cpp
+ * @brief Implementation file for the allocation tracking hooks.
+ *
+ * This file contains replacements of the global operator new and delete that allocate with
+ * malloc and count every call in the AllocTracker. It is built as its own object library and
+ * linked only into the executables built with the TICTACTOE_ALLOC_TRACKING CMake option, so
+ * the engine library and the other programs keep the standard allocator.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "alloctracker.h"
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+using tictactoe::AllocTracker;
+
+namespace {
+
+    const bool HOOKED = (AllocTracker::setHooked(), true);
+
+    /**
+     * @brief Gets the bytes the allocator reserved for a block, which free gives back.
+     */
+    inline size_t usableSize(void* ptr, size_t alignment){
+#if defined(_WIN32)
+        return (alignment > alignof(std::max_align_t)) ? _aligned_msize(ptr, alignment, 0) : _msize(ptr);
+#elif defined(__APPLE__)
+        (void)alignment;
+        return malloc_size(ptr);
+#else
+        (void)alignment;
+        return malloc_usable_size(ptr);
+#endif
+    }
+
+    /**
+     * @brief Allocates and counts a block, nullptr if the memory is exhausted.
+     */
+    void* allocate(size_t size, size_t alignment){
+        if (0 == size){
+            size = 1; // Every new returns a distinct pointer
+        }
+        void* ptr = nullptr;
+        if (alignment <= alignof(std::max_align_t)){
+            ptr = std::malloc(size);
+        }
+        else{
+#if defined(_WIN32)
+            ptr = _aligned_malloc(size, alignment);
+#else
+            if (0 != posix_memalign(&ptr, alignment, size)){
+                ptr = nullptr;
+            }
+#endif
+        }
+        if (ptr){
+            AllocTracker::recordAlloc(size, usableSize(ptr, alignment));
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief Allocates a block, calling the new handler or throwing like the standard operator new.
+     */
+    void* allocateOrThrow(size_t size, size_t alignment){
+        while (true){
+            void* ptr = allocate(size, alignment);
+            if (ptr){
+                return ptr;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler){
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    /**
+     * @brief Counts and frees a block.
+     */
+    void release(void* ptr, size_t alignment){
+        if (!ptr){
+            return;
+        }
+        AllocTracker::recordFree(usableSize(ptr, alignment));
+#if defined(_WIN32)
+        if (alignment > alignof(std::max_align_t)){
+            _aligned_free(ptr);
+            return;
+        }
+#endif
+        std::free(ptr);
+    }
+
+} // namespace
+
+void* operator new(size_t size) { return allocateOrThrow(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return allocateOrThrow(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* ptr) noexcept { release(ptr, alignof(std::max_align_t)); }
+void operator delete[](void* ptr) noexcept { release(ptr, alignof(std::max_align_t)); }
+void operator delete(void* ptr, size_t) noexcept { release(ptr, alignof(std::max_align_t)); }
+void operator delete[](void* ptr, size_t) noexcept { release(ptr, alignof(std::max_align_t)); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { release(ptr, alignof(std::max_align_t)); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { release(ptr, alignof(std::max_align_t)); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept { release(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { release(ptr, static_cast<size_t>(alignment)); }
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { release(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { release(ptr, static_cast<size_t>(alignment)); }
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { release(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { release(ptr, static_cast<size_t>(alignment)); }
@@ -0,0 +1,118 @@
+/**
+ * @file alloctracker.cpp
+ * @brief Implementation file for the AllocTracker class.
+ *
+ * This file contains the registry of the allocation scopes and the formatting of their totals.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "alloctracker.h"
+
+namespace tictactoe{
+
+    AllocTracker::ScopeTotals AllocTracker::totals[AllocTracker::MAX_SCOPES];
+    std::atomic<int> AllocTracker::scopeCount{ 0 };
+
+    /**
+     * @brief Gets the id of a scope name, registering it on first use.
+     *
+     * Called once per ALLOC_SCOPE site, so the lookup takes a lock. It must not allocate,
+     * as it runs inside the allocation hooks' bookkeeping.
+     *
+     * @param name The name of the scope, a string literal.
+     * @return The id, -1 if MAX_SCOPES names are registered already.
+     */
+    int AllocTracker::scopeId(const char* name){
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+        const int count = scopeCount.load(std::memory_order_relaxed);
+        for (int id = 0; id < count; id++){
+            if (0 == std::strcmp(totals[id].name.load(std::memory_order_relaxed), name)){
+                return id;
+            }
+        }
+        if (count >= MAX_SCOPES){
+            return -1;
+        }
+        totals[count].name.store(name, std::memory_order_relaxed);
+        scopeCount.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Adds a finished run of a scope to its totals.
+     *
+     * @param id The id of the scope, runs of -1 are dropped.
+     * @param delta The counts of the run.
+     * @param peakBytes The most memory held at once during the run.
+     */
+    void AllocTracker::addRun(int id, const AllocCounts& delta, int64_t peakBytes){
+        if (id < 0){
+            return;
+        }
+        ScopeTotals& scope = totals[id];
+        scope.calls.fetch_add(1, std::memory_order_relaxed);
+        scope.allocations.fetch_add(delta.allocations, std::memory_order_relaxed);
+        scope.bytes.fetch_add(delta.bytes, std::memory_order_relaxed);
+        int64_t peak = scope.peakBytes.load(std::memory_order_relaxed);
+        while (peakBytes > peak && !scope.peakBytes.compare_exchange_weak(peak, peakBytes, std::memory_order_relaxed)){
+        }
+    }
+
+    /**
+     * @brief Gets the totals of every scope entered so far.
+     *
+     * @return The totals in the order the scopes were first entered.
+     */
+    std::vector<AllocScopeStats> AllocTracker::scopes(){
+        std::vector<AllocScopeStats> result;
+        const int count = scopeCount.load(std::memory_order_acquire);
+        for (int id = 0; id < count; id++){
+            AllocScopeStats stats;
+            stats.name = totals[id].name.load(std::memory_order_relaxed);
+            stats.calls = totals[id].calls.load(std::memory_order_relaxed);
+            stats.allocations = totals[id].allocations.load(std::memory_order_relaxed);
+            stats.bytes = totals[id].bytes.load(std::memory_order_relaxed);
+            stats.peakBytes = totals[id].peakBytes.load(std::memory_order_relaxed);
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Clears the totals of every scope, e.g. after a warm-up.
+     */
+    void AllocTracker::resetScopes(){
+        const int count = scopeCount.load(std::memory_order_acquire);
+        for (int id = 0; id < count; id++){
+            totals[id].calls.store(0, std::memory_order_relaxed);
+            totals[id].allocations.store(0, std::memory_order_relaxed);
+            totals[id].bytes.store(0, std::memory_order_relaxed);
+            totals[id].peakBytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Formats the totals of every scope, one line each.
+     *
+     * @return For example "MinimaxAI::makeMove  120 calls, 0 allocations (0/call), 0 bytes, peak 0 bytes".
+     */
+    std::string AllocTracker::scopesToString(){
+        std::string result;
+        char line[256];
+        for (const AllocScopeStats& stats : scopes()){
+            const double perCall = stats.calls > 0 ? static_cast<double>(stats.allocations) / static_cast<double>(stats.calls) : 0.0;
+            std::snprintf(line, sizeof(line), "%-24s %llu calls, %llu allocations (%.2f/call), %llu bytes, peak %lld bytes\n",
+                stats.name, static_cast<unsigned long long>(stats.calls), static_cast<unsigned long long>(stats.allocations),
+                perCall, static_cast<unsigned long long>(stats.bytes), static_cast<long long>(stats.peakBytes));
+            result += line;
+        }
+        return result;
+    }
+
+} // namespace tictactoe
@@ -0,0 +1,214 @@
+/**
+ * @file alloctracker.h
+ * @brief Header file for the AllocTracker class.
+ *
+ * This file contains the declaration of the AllocTracker class, which counts the heap
+ * allocations of each thread and attributes them to named scopes of the engine. The counts
+ * come from replacements of the global operator new and delete in allochooks.cpp, which only
+ * the executables built with the TICTACTOE_ALLOC_TRACKING CMake option link; the ALLOC_SCOPE
+ * macros compile to nothing without that option.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 1 to compile the allocation scopes in, 0 to leave them out
+#ifndef TICTACTOE_ALLOC_TRACKING
+#define TICTACTOE_ALLOC_TRACKING 0
+#endif
+
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+
+#if TICTACTOE_ALLOC_TRACKING
+#define ALLOC_SCOPE(name) \
+    static const int ALLOC_CONCAT(allocScopeId, __LINE__) = ::tictactoe::AllocTracker::scopeId(name); \
+    ::tictactoe::AllocScope ALLOC_CONCAT(allocScope, __LINE__)(ALLOC_CONCAT(allocScopeId, __LINE__))
+#else
+#define ALLOC_SCOPE(name) ((void)0)
+#endif
+
+namespace tictactoe{
+
+    /**
+     * @brief Allocations of one thread, or the difference between two points of a thread.
+     */
+    struct AllocCounts{
+        uint64_t allocations = 0; /**< Calls of operator new. */
+        uint64_t frees = 0; /**< Calls of operator delete with a pointer. */
+        uint64_t bytes = 0; /**< Bytes requested from operator new. */
+        int64_t liveBytes = 0; /**< Bytes allocated minus bytes freed, negative if other threads' memory was freed. */
+
+        /**
+         * @brief Gets the counts from another sample to this one.
+         */
+        AllocCounts operator-(const AllocCounts& earlier) const{
+            AllocCounts delta;
+            delta.allocations = allocations - earlier.allocations;
+            delta.frees = frees - earlier.frees;
+            delta.bytes = bytes - earlier.bytes;
+            delta.liveBytes = liveBytes - earlier.liveBytes;
+            return delta;
+        }
+    };
+
+    /**
+     * @brief Allocation totals of a named scope over all its runs.
+     */
+    struct AllocScopeStats{
+        const char* name = nullptr;
+        uint64_t calls = 0; /**< Times the scope was entered. */
+        uint64_t allocations = 0; /**< Allocations inside the scope, including nested scopes. */
+        uint64_t bytes = 0; /**< Bytes requested inside the scope. */
+        int64_t peakBytes = 0; /**< Most memory held at once above the level at the start of a run. */
+    };
+
+    /**
+     * @brief The AllocTracker class holds the allocation counts of every thread and scope.
+     *
+     * Counting takes no lock: each thread updates its own counters and a scope adds its
+     * difference to shared atomic totals when it ends. Freed bytes are counted by the thread
+     * freeing them, so live bytes are exact per thread only for memory it frees itself.
+     */
+    class AllocTracker{
+    public:
+        static constexpr int MAX_SCOPES = 32; // Distinct scope names
+
+        /**
+         * @brief Checks whether the allocation scopes are compiled in.
+         */
+        static constexpr bool isCompiledIn() { return 0 != TICTACTOE_ALLOC_TRACKING; }
+
+        /**
+         * @brief Checks whether operator new and delete are counted, i.e. the hooks are linked.
+         */
+        inline static bool isHooked() { return hooked.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Marks the hooks as linked, called by allochooks.cpp at startup.
+         */
+        inline static void setHooked() { hooked.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Counts an allocation of the calling thread.
+         *
+         * @param requested The bytes asked for.
+         * @param usable The bytes the allocator reserved, counted as live until freed.
+         */
+        inline static void recordAlloc(size_t requested, size_t usable){
+            counts.allocations++;
+            counts.bytes += requested;
+            counts.liveBytes += static_cast<int64_t>(usable);
+            if (counts.liveBytes > peakMark){
+                peakMark = counts.liveBytes;
+            }
+        }
+
+        /**
+         * @brief Counts a release of the calling thread.
+         *
+         * @param usable The bytes the allocator had reserved.
+         */
+        inline static void recordFree(size_t usable){
+            counts.frees++;
+            counts.liveBytes -= static_cast<int64_t>(usable);
+        }
+
+        /**
+         * @brief Gets the counts of the calling thread since it started.
+         */
+        inline static const AllocCounts& threadCounts() { return counts; }
+
+        /**
+         * @brief Gets the id of a scope name, registering it on first use.
+         */
+        static int scopeId(const char* name);
+
+        /**
+         * @brief Gets the totals of every scope entered so far.
+         */
+        static std::vector<AllocScopeStats> scopes();
+
+        /**
+         * @brief Clears the totals of every scope, e.g. after a warm-up.
+         */
+        static void resetScopes();
+
+        /**
+         * @brief Formats the totals of every scope, one line each.
+         */
+        static std::string scopesToString();
+
+    private:
+        friend class AllocScope;
+
+        /**
+         * @brief Totals of one scope, updated by the threads leaving it.
+         */
+        struct ScopeTotals{
+            std::atomic<const char*> name{ nullptr };
+            std::atomic<uint64_t> calls{ 0 };
+            std::atomic<uint64_t> allocations{ 0 };
+            std::atomic<uint64_t> bytes{ 0 };
+            std::atomic<int64_t> peakBytes{ 0 };
+        };
+
+        /**
+         * @brief Adds a finished run of a scope to its totals.
+         */
+        static void addRun(int id, const AllocCounts& delta, int64_t peakBytes);
+
+    private:
+        static inline std::atomic<bool> hooked{ false };
+        static inline thread_local AllocCounts counts; // Counts of the calling thread
+        static inline thread_local int64_t peakMark = 0; // Highest live bytes since the innermost scope started
+        static ScopeTotals totals[MAX_SCOPES];
+        static std::atomic<int> scopeCount;
+    };
+
+    /**
+     * @brief Attributes the allocations during the lifetime of a scope, used through ALLOC_SCOPE.
+     */
+    class AllocScope{
+    public:
+        /**
+         * @brief Starts a run of the scope with the given id.
+         */
+        explicit AllocScope(int id_i)
+            : id(id_i), start(AllocTracker::counts), outerPeak(AllocTracker::peakMark){
+            AllocTracker::peakMark = start.liveBytes;
+        }
+
+        /**
+         * @brief Adds the allocations since the start to the scope's totals.
+         */
+        ~AllocScope(){
+            const int64_t peak = AllocTracker::peakMark;
+            AllocTracker::addRun(id, AllocTracker::counts - start, peak - start.liveBytes);
+            // The outer scope's peak covers this one's
+            AllocTracker::peakMark = (peak > outerPeak) ? peak : outerPeak;
+        }
+
+        AllocScope(const AllocScope&) = delete;
+        AllocScope& operator=(const AllocScope&) = delete;
+
+    private:
+        int id;
+        AllocCounts start;
+        int64_t outerPeak;
+    };
+
+} // namespace tictactoe
+
+#endif // ALLOCTRACKER_H
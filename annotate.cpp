@@ -0,0 +1,360 @@
+/**
+ * @file annotate.cpp
+ * @brief Implementation file for the batch annotator of recorded games.
+ *
+ * This file contains a command line tool that re-analyzes every move of a game record file
+ * with a configurable AI and search depth, spread over all cores, and flags blunders: moves
+ * that score worse than the best move, so that they change the value of the game from a win
+ * to a draw or loss, or from a draw to a loss. Annotated games are written in file order as
+ * soon as all their moves are analyzed, as text and optionally as a record file with scores.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "aifactory.h"
+#include "gamerecord.h"
+#include "notation.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Settings of an annotation run.
+     */
+    struct Config{
+        const char* input = nullptr;
+        const char* output = nullptr;
+        const char* recordPath = nullptr;
+        AIType type = AIType::Minimax;
+        GameLevel level = GameLevel::MASTER;
+        int threads = 0;
+        bool blundersOnly = false;
+    };
+
+    /**
+     * @brief The analysis of one played move.
+     */
+    struct MoveAnnotation{
+        int16_t score; /**< Score of the played move for the mover. */
+        int16_t best; /**< Score of the best move for the mover. */
+        CellPos bestMove; /**< The first move with the best score. */
+    };
+
+    /**
+     * @brief Positions handed to a worker at once, consecutive plies mostly of the same game.
+     */
+    const size_t CHUNK_POSITIONS = 256;
+
+    /**
+     * @brief Chunks that may be analyzed ahead of the writer, bounding the memory of the run.
+     */
+    const size_t WINDOW_CHUNKS = 256;
+
+    /**
+     * @brief Work shared between the workers and the writer.
+     *
+     * Every move of every game is one position, numbered in file order. Workers take chunks
+     * of positions in order, so the work is balanced however long the games are, and write
+     * their results into a ring of chunk slots that the writer drains in order.
+     */
+    struct Schedule{
+        std::vector<uint64_t> firstPosition; // Position number of the first move of every game, plus the total
+        size_t chunkCount = 0;
+
+        std::mutex mutex;
+        std::condition_variable workerWait;
+        std::condition_variable writerWait;
+        size_t nextChunk = 0; // Next chunk to hand out
+        size_t drainedChunks = 0; // Chunks the writer has consumed
+        std::vector<std::vector<MoveAnnotation>> slots = std::vector<std::vector<MoveAnnotation>>(WINDOW_CHUNKS);
+        std::vector<char> done = std::vector<char>(WINDOW_CHUNKS, 0);
+    };
+
+    /**
+     * @brief Analyzes chunks of positions until none are left.
+     *
+     * The worker keeps its AI, whose transposition table carries over between positions, and
+     * keeps the board of the game it is in; the next ply of the same game is reached by
+     * playing one move instead of replaying the game.
+     */
+    void analyzePositions(const Config& config, const GameRecordReader& reader, Schedule& schedule){
+        std::unique_ptr<GameAI> ai = AIFactory::createAI(config.type);
+        ai->setLevel(config.level);
+
+        GameRecord record;
+        Board board;
+        size_t game = SIZE_MAX; // Game on the board
+        size_t ply = 0; // Moves of that game on the board
+        std::vector<MoveAnnotation> annotations;
+
+        while (true){
+            size_t chunk = 0;
+            {
+                std::unique_lock<std::mutex> lock(schedule.mutex);
+                schedule.workerWait.wait(lock, [&schedule](){
+                    return schedule.nextChunk >= schedule.chunkCount || schedule.nextChunk < schedule.drainedChunks + WINDOW_CHUNKS;
+                });
+                if (schedule.nextChunk >= schedule.chunkCount){
+                    return;
+                }
+                chunk = schedule.nextChunk++;
+            }
+
+            const uint64_t first = chunk * CHUNK_POSITIONS;
+            const uint64_t last = std::min<uint64_t>(first + CHUNK_POSITIONS, schedule.firstPosition.back());
+            annotations.clear();
+            for (uint64_t position = first; position < last; position++){
+                const size_t positionGame = static_cast<size_t>(std::upper_bound(schedule.firstPosition.begin(),
+                    schedule.firstPosition.end(), position) - schedule.firstPosition.begin()) - 1;
+                const size_t positionPly = static_cast<size_t>(position - schedule.firstPosition[positionGame]);
+                if (positionGame != game || positionPly != ply){
+                    // Not the next ply of the game on the board, replay from the start
+                    game = positionGame;
+                    reader.readGame(game, record);
+                    board.startNewGame(record.size);
+                    for (ply = 0; ply < positionPly; ply++){
+                        board.makeMove(record.moves[ply].pos, (0 == ply % 2) ? record.firstMover : board.getOpponent(record.firstMover));
+                    }
+                }
+
+                const CellPos played = record.moves[ply].pos;
+                const Symbol mover = (0 == ply % 2) ? record.firstMover : board.getOpponent(record.firstMover);
+                MoveAnnotation annotation{ 0, 0, played };
+                bool scored = false;
+                bool legal = false;
+                for (const MoveScore& moveScore : ai->analyze(board, mover)){
+                    if (!scored || moveScore.score > annotation.best){
+                        annotation.best = static_cast<int16_t>(moveScore.score);
+                        annotation.bestMove = moveScore.move;
+                        scored = true;
+                    }
+                    if (moveScore.move == played){
+                        annotation.score = static_cast<int16_t>(moveScore.score);
+                        legal = true;
+                    }
+                }
+                if (!legal){
+                    annotation.score = annotation.best; // Malformed game, nothing to judge
+                }
+                annotations.push_back(annotation);
+
+                if (!board.makeMove(played, mover)){
+                    game = SIZE_MAX;
+                }
+                ply++;
+            }
+
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            schedule.slots[chunk % WINDOW_CHUNKS].swap(annotations);
+            schedule.done[chunk % WINDOW_CHUNKS] = 1;
+            schedule.writerWait.notify_one();
+        }
+    }
+
+    /**
+     * @brief Formats an annotated game as "<index> <size> <result> <move>[?] ...".
+     *
+     * Every move is followed by its score and, for blunders, by "?" and the best move with its score.
+     */
+    std::string formatGame(size_t index, const GameRecord& record, const std::vector<MoveAnnotation>& annotations, int& blunders){
+        const char* result = !record.finished ? "*" : Symbol::X == record.winner ? "x" : Symbol::O == record.winner ? "o" : "draw";
+        std::string line = std::to_string(index) + " " + std::to_string(record.size) + " " + result;
+        blunders = 0;
+        for (size_t i = 0; i < annotations.size(); i++){
+            const MoveAnnotation& annotation = annotations[i];
+            line += " " + toNotation(record.moves[i].pos) + "=" + std::to_string(annotation.score);
+            if (annotation.score < annotation.best){
+                line += "?(" + toNotation(annotation.bestMove) + "=" + std::to_string(annotation.best) + ")";
+                blunders++;
+            }
+        }
+        return line;
+    }
+
+    int run(const Config& config){
+        GameRecordReader reader;
+        if (!reader.open(config.input)){
+            return 1;
+        }
+        std::FILE* output = stdout;
+        if (config.output && !(output = std::fopen(config.output, "w"))){
+            std::fprintf(stderr, "cannot create %s\n", config.output);
+            return 1;
+        }
+        GameRecordWriter recordWriter;
+        if (config.recordPath && !recordWriter.open(config.recordPath)){
+            return 1;
+        }
+
+        // Number the positions, a move of a game is one position
+        Schedule schedule;
+        GameRecord record;
+        schedule.firstPosition.reserve(reader.getGameCount() + 1);
+        uint64_t positions = 0;
+        for (size_t game = 0; game < reader.getGameCount(); game++){
+            schedule.firstPosition.push_back(positions);
+            if (reader.readGame(game, record)){
+                positions += record.moves.size();
+            }
+        }
+        schedule.firstPosition.push_back(positions);
+        schedule.chunkCount = static_cast<size_t>((positions + CHUNK_POSITIONS - 1) / CHUNK_POSITIONS);
+
+        int threads = config.threads;
+        if (0 == threads){
+            threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++){
+            workers.emplace_back(analyzePositions, std::cref(config), std::cref(reader), std::ref(schedule));
+        }
+
+        // Drain the chunks in order and write every game once its last move is analyzed
+        size_t game = 0;
+        std::vector<MoveAnnotation> gameAnnotations;
+        std::vector<MoveAnnotation> chunkAnnotations;
+        long long blunders = 0;
+        long long blunderGames = 0;
+        auto writeReadyGames = [&](){
+            while (game < reader.getGameCount()
+                   && gameAnnotations.size() == schedule.firstPosition[game + 1] - schedule.firstPosition[game]){
+                if (reader.readGame(game, record)){
+                    int gameBlunders = 0;
+                    const std::string line = formatGame(game, record, gameAnnotations, gameBlunders);
+                    if (!config.blundersOnly || gameBlunders > 0){
+                        std::fprintf(output, "%s\n", line.c_str());
+                    }
+                    blunders += gameBlunders;
+                    blunderGames += (gameBlunders > 0) ? 1 : 0;
+                    if (config.recordPath){
+                        record.hasScores = true;
+                        for (size_t i = 0; i < record.moves.size(); i++){
+                            record.moves[i].score = gameAnnotations[i].score;
+                        }
+                        recordWriter.write(record);
+                    }
+                }
+                gameAnnotations.clear();
+                game++;
+            }
+        };
+        writeReadyGames(); // Leading games without moves
+        for (size_t chunk = 0; chunk < schedule.chunkCount; chunk++){
+            {
+                std::unique_lock<std::mutex> lock(schedule.mutex);
+                schedule.writerWait.wait(lock, [&schedule, chunk](){ return 0 != schedule.done[chunk % WINDOW_CHUNKS]; });
+                chunkAnnotations.swap(schedule.slots[chunk % WINDOW_CHUNKS]);
+                schedule.done[chunk % WINDOW_CHUNKS] = 0;
+                schedule.drainedChunks++;
+            }
+            schedule.workerWait.notify_all();
+
+            for (const MoveAnnotation& annotation : chunkAnnotations){
+                gameAnnotations.push_back(annotation);
+                writeReadyGames();
+            }
+        }
+        for (std::thread& worker : workers){
+            worker.join();
+        }
+        recordWriter.close();
+        if (output != stdout){
+            std::fclose(output);
+        }
+        else{
+            std::fflush(output);
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::fprintf(stderr, "games        %zu\n", reader.getGameCount());
+        std::fprintf(stderr, "positions    %llu in %.3f s with %d threads (%.1f positions/sec)\n",
+            static_cast<unsigned long long>(positions), seconds, threads, static_cast<double>(positions) / seconds);
+        std::fprintf(stderr, "blunders     %lld in %lld games\n", blunders, blunderGames);
+        return 0;
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options] RECORDS\n"
+            "  --ai TYPE        AI that analyzes the moves: minimax or random (default minimax)\n"
+            "  --level N        search depth level of the AI (default %d)\n"
+            "  --threads N      worker threads (default: all cores)\n"
+            "  --output FILE    write the annotated games to FILE instead of stdout\n"
+            "  --record FILE    also append the games with the score of every move to a record file\n"
+            "  --blunders-only  only write games with a blunder\n",
+            program, static_cast<int>(GameLevel::MASTER));
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            if (0 == std::strcmp(arg, "--blunders-only")){
+                config.blundersOnly = true;
+                continue;
+            }
+            if (0 != std::strncmp(arg, "--", 2)){
+                if (config.input){
+                    return false;
+                }
+                config.input = arg;
+                continue;
+            }
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--ai")){
+                if (!parseAIType(value, config.type)) return false;
+            }
+            else if (0 == std::strcmp(arg, "--level")){
+                config.level = static_cast<GameLevel>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(arg, "--threads")){
+                config.threads = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--output")){
+                config.output = value;
+            }
+            else if (0 == std::strcmp(arg, "--record")){
+                config.recordPath = value;
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.input && config.threads >= 0 && static_cast<int>(config.level) >= 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the batch annotator.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+    return run(config);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file benchmark.h
+ * @brief Header file for the microbenchmark helpers.
+ *
+ * This file contains a small self-contained timing harness for the benchmark tools: barriers
+ * that keep the compiler from optimizing measured work away, and a runner that calibrates the
+ * iteration count and repeats the measurement to report the spread of the nanoseconds per
+ * operation, and the allocations per operation in builds that track them.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "alloctracker.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Makes the compiler assume a value is used, so the work computing it is kept.
+     */
+    template <typename T>
+    inline void doNotOptimize(const T& value){
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Makes the compiler assume all memory is read and written here.
+     */
+    inline void clobberMemory(){
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * @brief Timing of an operation over repeated runs, in nanoseconds per operation.
+     */
+    struct BenchResult{
+        double minNsec = 0.0;
+        double medianNsec = 0.0;
+        double meanNsec = 0.0;
+        double stddevNsec = 0.0;
+        long long iterations = 0; // Batches per run
+        int reps = 0;
+        double allocsPerOp = -1.0; // Heap allocations per operation, -1 unless the allocation hooks are linked
+    };
+
+    /**
+     * @brief Times a batch of operations.
+     *
+     * The batch count per run is doubled until a run lasts at least minSeconds, which also warms
+     * the caches up, then reps runs are timed. The median is the figure to compare, the minimum
+     * and the standard deviation show how noisy the machine was.
+     *
+     * @param batch Does batchOps operations per call.
+     * @param batchOps Operations per call of batch.
+     * @param reps Timed runs.
+     * @param minSeconds Minimum duration of a run.
+     */
+    template <typename Batch>
+    BenchResult measure(Batch&& batch, int batchOps, int reps, double minSeconds){
+        using Clock = std::chrono::steady_clock;
+        const auto run = [&batch](long long iterations){
+            const auto start = Clock::now();
+            for (long long i = 0; i < iterations; i++){
+                batch();
+                clobberMemory();
+            }
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        };
+
+        BenchResult result;
+        result.iterations = 1;
+        while (run(result.iterations) < minSeconds && result.iterations < (1LL << 40)){
+            result.iterations *= 2;
+        }
+
+        // Counted in an untimed batch, so the timed runs are the same with and without the hooks
+        if (AllocTracker::isHooked()){
+            const AllocCounts before = AllocTracker::threadCounts();
+            batch();
+            result.allocsPerOp = static_cast<double>((AllocTracker::threadCounts() - before).allocations) / batchOps;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<size_t>(reps));
+        for (int rep = 0; rep < reps; rep++){
+            samples.push_back(run(result.iterations) * 1e9 / (static_cast<double>(result.iterations) * batchOps));
+        }
+        std::sort(samples.begin(), samples.end());
+        result.reps = reps;
+        if (samples.empty()){
+            return result;
+        }
+        result.minNsec = samples.front();
+        const size_t middle = samples.size() / 2;
+        result.medianNsec = (samples.size() % 2) ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+        double sum = 0.0;
+        for (double sample : samples){
+            sum += sample;
+        }
+        result.meanNsec = sum / static_cast<double>(samples.size());
+        double squares = 0.0;
+        for (double sample : samples){
+            squares += (sample - result.meanNsec) * (sample - result.meanNsec);
+        }
+        result.stddevNsec = (samples.size() > 1) ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0.0;
+        return result;
+    }
+
+} // namespace tictactoe
+
+#endif // BENCHMARK_H
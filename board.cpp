@@ -11,17 +11,47 @@
  */
 
 #include "board.h"
+#include "metrics.h"
 
 namespace tictactoe{
 
+    namespace {
+        const Metrics::Id BOARD_RESETS = Metrics::getInstance().counter("tictactoe_board_resets_total", "Boards cleared for a new game");
+
+        /**
+         * @brief Mixes a 64 bit value into a well distributed hash (splitmix64 finalizer).
+         */
+        inline uint64_t mix(uint64_t value){
+            value += 0x9E3779B97F4A7C15ULL;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+    }
+
     /**
      * @brief Constructor for the Board class.
      *
      * @param size The size of the board.
      */
-    Board::Board(int size_i) : size(size_i){
+    Board::Board(int size_i) : size(size_i), key(emptyKey(size_i)){
         board.resize(size, std::vector<Symbol>(size, Symbol::None));
+        resetEmptyCells();
+    }
+
+#if TICTACTOE_ALLOC_TRACKING
+    /**
+     * @brief Copy constructor for the Board class, only defined when allocations are tracked.
+     *
+     * @param other The board to copy.
+     */
+    Board::Board(const Board& other) : size(other.size), key(other.key){
+        ALLOC_SCOPE("Board copy");
+        board = other.board;
+        emptyCells = other.emptyCells;
+        emptySlots = other.emptySlots;
     }
+#endif
 
     /**
      * @brief Starts a new game by resetting the board.
@@ -50,6 +80,22 @@ namespace tictactoe{
                 board[row][col] = Symbol::None;
             }
         }
+        key = emptyKey(size);
+        resetEmptyCells();
+        Metrics::getInstance().add(BOARD_RESETS);
+    }
+
+    /**
+     * @brief Lists every cell as empty.
+     */
+    void Board::resetEmptyCells(){
+        const int cells = size * size;
+        emptyCells.resize(cells);
+        emptySlots.resize(cells);
+        for (int cell = 0; cell < cells; cell++){
+            emptyCells[cell] = cell;
+            emptySlots[cell] = cell;
+        }
     }
 
     /**
@@ -59,19 +105,52 @@ namespace tictactoe{
      * @param symbol The symbol to place on the board.
      * @return true if the move was successful, false otherwise.
      */
-    bool Board::makeMove(const QPoint& pos, Symbol symbol){
-        int row = pos.y();
-        int col = pos.x();
+    bool Board::makeMove(const CellPos& pos, Symbol symbol){
+        int row = pos.y;
+        int col = pos.x;
         // Make a move on the board
         if (row < 0 || row >= size || col < 0 || col >= size || board[row][col] != Symbol::None){
-            Logger::getInstance().logError("Failed to make a move", LOG_LOCATION);
+            LOG_ERROR("Failed to make a move");
             return false; // Invalid move
         }
 
         board[row][col] = symbol;
+        key ^= cellKey(row, col, symbol);
+
+        // Remove the cell from the empty list by moving the last entry into its slot
+        const int cell = row * size + col;
+        const int slot = emptySlots[cell];
+        const int last = emptyCells.back();
+        emptyCells[slot] = last;
+        emptySlots[last] = slot;
+        emptyCells.pop_back();
+        emptySlots[cell] = -1;
         return true;  // Move successful
     }
 
+    /**
+     * @brief Takes back a move made on the board.
+     *
+     * @param pos The position of the move to take back.
+     * @return true if a symbol was removed, false if the position was invalid or empty.
+     */
+    bool Board::undoMove(const CellPos& pos){
+        int row = pos.y;
+        int col = pos.x;
+        if (row < 0 || row >= size || col < 0 || col >= size || board[row][col] == Symbol::None){
+            LOG_ERROR("Failed to undo a move");
+            return false; // Nothing to undo
+        }
+
+        key ^= cellKey(row, col, board[row][col]);
+        board[row][col] = Symbol::None;
+
+        const int cell = row * size + col;
+        emptySlots[cell] = static_cast<int>(emptyCells.size());
+        emptyCells.push_back(cell);
+        return true;
+    }
+
     /**
      * @brief Checks if there is a winner on the board.
      *
@@ -134,18 +213,12 @@ namespace tictactoe{
     /**
      * @brief Checks if the board is full.
      *
+     * Answered in constant time from the list of empty cells.
+     *
      * @return true if the board is full, false otherwise.
      */
     bool Board::isBoardFull() const{
-        // Check if the board is full
-        for (int row = 0; row < size; row++){
-            for (int col = 0; col < size; col++){
-                if ( Symbol::None == board[row][col]){
-                    return false;
-                }
-            }
-        }
-        return true;
+        return emptyCells.empty();
     }
 
     /**
@@ -154,13 +227,28 @@ namespace tictactoe{
      * @param pos The position to check.
      * @return true if the position is empty, false otherwise.
      */
-    bool Board::isEmpty(const QPoint& pos) const{
-        int row = pos.y();
-        int col = pos.x();
+    bool Board::isEmpty(const CellPos& pos) const{
+        int row = pos.y;
+        int col = pos.x;
         // Check if the specified position is empty
         return row >= 0 && row < size && col >= 0 && col < size && Symbol::None == board[row][col];
     }
 
+    /**
+     * @brief Gets the symbol on a position of the board.
+     *
+     * @param pos The position to read.
+     * @return The symbol on the position, Symbol::None if it is empty or outside the board.
+     */
+    Symbol Board::getSymbol(const CellPos& pos) const{
+        int row = pos.y;
+        int col = pos.x;
+        if (row < 0 || row >= size || col < 0 || col >= size){
+            return Symbol::None;
+        }
+        return board[row][col];
+    }
+
     /**
      * @brief Gets the opponent symbol.
      *
@@ -181,4 +269,31 @@ namespace tictactoe{
 		}
 	}
 
+    /**
+     * @brief Gets the hash key of an empty board of the given size.
+     *
+     * The size is part of the key so positions of different board sizes never share a key.
+     *
+     * @param size_i The size of the board.
+     * @return The hash key of the empty board.
+     */
+    uint64_t Board::emptyKey(int size_i){
+        return mix(static_cast<uint64_t>(size_i));
+    }
+
+    /**
+     * @brief Gets the hash key contribution of a symbol on a cell.
+     *
+     * The keys are derived on the fly instead of being read from a table, so any board size is supported.
+     *
+     * @param row The row index of the cell.
+     * @param col The column index of the cell.
+     * @param symbol The symbol placed on the cell.
+     * @return The value to xor into the position key.
+     */
+    uint64_t Board::cellKey(int row, int col, Symbol symbol){
+        const uint64_t cell = (static_cast<uint64_t>(row) << 32) | static_cast<uint64_t>(col);
+        return mix((cell << 2) | static_cast<uint64_t>(symbol));
+    }
+
 } // namespace tictactoe
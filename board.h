@@ -14,6 +14,8 @@
 #define BOARD_H
 
 #include <vector>
+#include <cstdint>
+#include "alloctracker.h"
 #include "commondef.h"
 
 namespace tictactoe{
@@ -27,6 +29,16 @@ namespace tictactoe{
          */
         explicit Board(int size_i = DEFAULT_BOARD_SIZE);
 
+#if TICTACTOE_ALLOC_TRACKING
+        /**
+         * @brief Copies a board, attributing its allocations to the "Board copy" scope.
+         */
+        Board(const Board& other);
+        Board(Board&& other) = default;
+        Board& operator=(const Board& other) = default;
+        Board& operator=(Board&& other) = default;
+#endif
+
         /**
          * @brief Starts a new game by resetting the board.
          */
@@ -35,7 +47,12 @@ namespace tictactoe{
         /**
          * @brief Attempts to make a move on the board.
          */
-        bool makeMove(const QPoint& pos, Symbol symbol);
+        bool makeMove(const CellPos& pos, Symbol symbol);
+
+        /**
+         * @brief Takes back a move made on the board.
+         */
+        bool undoMove(const CellPos& pos);
 
         /**
          * @brief Checks if there is a winner on the board.
@@ -55,22 +72,60 @@ namespace tictactoe{
         /**
          * @brief Checks if a position on the board is empty.
          */
-        bool isEmpty(const QPoint& pos) const;
+        bool isEmpty(const CellPos& pos) const;
+
+        /**
+         * @brief Gets the symbol on a position of the board.
+         */
+        Symbol getSymbol(const CellPos& pos) const;
+
+        /**
+         * @brief Gets the number of empty cells.
+         */
+        inline int getEmptyCount() const { return static_cast<int>(emptyCells.size()); }
+
+        /**
+         * @brief Gets an empty cell by its index in [0, getEmptyCount()), the order changes as moves are made.
+         */
+        inline CellPos getEmptyCell(int index) const { return CellPos{ emptyCells[index] % size, emptyCells[index] / size }; }
 
         /**
          * @brief Gets the opponent symbol.
          */
         Symbol getOpponent(Symbol symbol) const;
 
+        /**
+         * @brief Gets the hash key of the current position.
+         */
+        inline uint64_t getKey() const { return key; }
+
+        /**
+         * @brief Gets the hash key of an empty board of the given size.
+         */
+        static uint64_t emptyKey(int size_i);
+
+        /**
+         * @brief Gets the hash key contribution of a symbol on a cell.
+         */
+        static uint64_t cellKey(int row, int col, Symbol symbol);
+
     private:
         /**
          * @brief Checks for a winning sequence on the board.
          */
         bool checkSequence(Symbol symbol, int startRow, int startCol, int dRow, int dCol) const;
 
+        /**
+         * @brief Lists every cell as empty.
+         */
+        void resetEmptyCells();
+
     private:
         int size; // Size of the board
         std::vector<std::vector<Symbol>> board; // 2D vector to represent the board
+        uint64_t key; // Zobrist style hash of the position, updated incrementally
+        std::vector<int> emptyCells; // Row-major indices of the empty cells, in no particular order
+        std::vector<int> emptySlots; // Index of each cell in emptyCells, -1 for occupied cells
     };
 
 } // namespace tictactoe
@@ -0,0 +1,309 @@
+/**
+ * @file board_bench.cpp
+ * @brief Implementation file for the Board microbenchmark.
+ *
+ * This file contains a command line tool that times the Board primitives the searches call
+ * most, on random reachable positions of every board size, and reports nanoseconds per
+ * operation. The results can be written as JSON and compared against an earlier run.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "benchmark.h"
+#include "board.h"
+#include "rng.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Positions each operation cycles through, so one position's branches are not learned.
+     */
+    const int POSITIONS = 64;
+
+    /**
+     * @brief Settings of a benchmark run.
+     */
+    struct Config{
+        int minSize = 2;
+        int maxSize = 16;
+        int reps = 7;
+        double minSeconds = 0.01; // Minimum duration of a timed run
+        uint64_t seed = 1;
+        const char* jsonPath = nullptr;
+        const char* baselinePath = nullptr;
+        double threshold = 10.0; // Slowdown in percent reported as a regression
+    };
+
+    /**
+     * @brief A position together with a legal move and the cell probed by isEmpty.
+     */
+    struct Position{
+        Board board;
+        Symbol mover;
+        CellPos move; // Empty cell, or {-1, -1} on a full board
+        CellPos probe;
+    };
+
+    /**
+     * @brief Timing of one operation on one board size.
+     */
+    struct Entry{
+        std::string op;
+        int size;
+        BenchResult result;
+    };
+
+    /**
+     * @brief Plays random moves from the empty board, stopping at a random ply or a win.
+     */
+    Position randomPosition(int size, Rng& rng){
+        Position position{ Board(size), Symbol::X, CellPos{ -1, -1 }, CellPos{ 0, 0 } };
+        const int cells = size * size;
+        const int plies = static_cast<int>(rng.below(static_cast<uint32_t>(cells + 1)));
+        for (int ply = 0; ply < plies && Symbol::None == position.board.checkForWinner(); ply++){
+            const int index = static_cast<int>(rng.below(static_cast<uint32_t>(position.board.getEmptyCount())));
+            position.board.makeMove(position.board.getEmptyCell(index), position.mover);
+            position.mover = position.board.getOpponent(position.mover);
+        }
+        if (position.board.getEmptyCount() > 0){
+            position.move = position.board.getEmptyCell(static_cast<int>(rng.below(static_cast<uint32_t>(position.board.getEmptyCount()))));
+        }
+        const int probe = static_cast<int>(rng.below(static_cast<uint32_t>(cells)));
+        position.probe = CellPos{ probe % size, probe / size };
+        return position;
+    }
+
+    /**
+     * @brief Times every operation on one board size.
+     */
+    void benchSize(int size, const Config& config, std::vector<Entry>& entries){
+        Rng rng(Rng::derive(config.seed, static_cast<uint64_t>(size)));
+        std::vector<Position> positions;
+        std::vector<Position> playable; // Positions with an empty cell, for makeMove
+        for (int i = 0; i < POSITIONS; i++){
+            positions.push_back(randomPosition(size, rng));
+            if (positions.back().board.getEmptyCount() > 0){
+                playable.push_back(positions.back());
+            }
+        }
+        while (playable.empty()){
+            Position position = randomPosition(size, rng);
+            if (position.board.getEmptyCount() > 0){
+                playable.push_back(std::move(position));
+            }
+        }
+
+        const auto add = [&](const char* op, BenchResult result){
+            entries.push_back(Entry{ op, size, result });
+            std::printf("%-20s %2d  %10.2f ns/op  (min %.2f, mean %.2f, stddev %.2f, %lld batches)", op, size,
+                result.medianNsec, result.minNsec, result.meanNsec, result.stddevNsec, result.iterations);
+            if (result.allocsPerOp >= 0.0){
+                std::printf("  %.2f allocs/op", result.allocsPerOp);
+            }
+            std::printf("\n");
+        };
+        const int playableOps = static_cast<int>(playable.size());
+
+        // A move is taken back right away so every batch sees the same positions
+        add("makeMove+undoMove", measure([&playable]{
+            for (Position& position : playable){
+                doNotOptimize(position.board.makeMove(position.move, position.mover));
+                doNotOptimize(position.board.undoMove(position.move));
+            }
+        }, playableOps, config.reps, config.minSeconds));
+        add("checkForWinner", measure([&positions]{
+            for (const Position& position : positions){
+                doNotOptimize(position.board.checkForWinner());
+            }
+        }, POSITIONS, config.reps, config.minSeconds));
+        add("isBoardFull", measure([&positions]{
+            for (const Position& position : positions){
+                doNotOptimize(position.board.isBoardFull());
+            }
+        }, POSITIONS, config.reps, config.minSeconds));
+        add("isEmpty", measure([&positions]{
+            for (const Position& position : positions){
+                doNotOptimize(position.board.isEmpty(position.probe));
+            }
+        }, POSITIONS, config.reps, config.minSeconds));
+        add("getOpponent", measure([&positions]{
+            for (const Position& position : positions){
+                doNotOptimize(position.board.getOpponent(position.mover));
+            }
+        }, POSITIONS, config.reps, config.minSeconds));
+        add("copy", measure([&positions]{
+            for (const Position& position : positions){
+                Board copy(position.board);
+                doNotOptimize(copy);
+            }
+        }, POSITIONS, config.reps, config.minSeconds));
+    }
+
+    /**
+     * @brief Writes the results as JSON, one result per line.
+     */
+    bool writeJson(const char* path, const Config& config, const std::vector<Entry>& entries){
+        std::ofstream file(path, std::ios::trunc);
+        if (!file){
+            std::fprintf(stderr, "cannot write %s\n", path);
+            return false;
+        }
+        char line[256];
+        std::snprintf(line, sizeof(line), "{\"benchmark\":\"board_bench\",\"reps\":%d,\"seed\":%llu,\"results\":[\n",
+            config.reps, static_cast<unsigned long long>(config.seed));
+        file << line;
+        for (size_t i = 0; i < entries.size(); i++){
+            const BenchResult& result = entries[i].result;
+            std::snprintf(line, sizeof(line),
+                "{\"op\":\"%s\",\"size\":%d,\"median_ns\":%.4f,\"min_ns\":%.4f,\"mean_ns\":%.4f,\"stddev_ns\":%.4f,\"iterations\":%lld,\"allocs_per_op\":%.4f}%s\n",
+                entries[i].op.c_str(), entries[i].size, result.medianNsec, result.minNsec, result.meanNsec, result.stddevNsec,
+                result.iterations, result.allocsPerOp, (i + 1 < entries.size()) ? "," : "");
+            file << line;
+        }
+        file << "]}\n";
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief Reads the medians of a JSON file written by writeJson, keyed by operation and size.
+     */
+    bool readBaseline(const char* path, std::map<std::pair<std::string, int>, double>& medians){
+        std::ifstream file(path);
+        if (!file){
+            std::fprintf(stderr, "cannot read %s\n", path);
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)){
+            char op[64];
+            int size = 0;
+            double median = 0.0;
+            if (3 == std::sscanf(line.c_str(), "{\"op\":\"%63[^\"]\",\"size\":%d,\"median_ns\":%lf", op, &size, &median)){
+                medians[std::make_pair(std::string(op), size)] = median;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Prints the change of every median against the baseline.
+     *
+     * @return The number of operations slower than the threshold.
+     */
+    int compareBaseline(const std::map<std::pair<std::string, int>, double>& medians, const std::vector<Entry>& entries, double threshold){
+        int regressions = 0;
+        std::printf("\nagainst baseline (regression above +%.1f%%)\n", threshold);
+        for (const Entry& entry : entries){
+            const auto found = medians.find(std::make_pair(entry.op, entry.size));
+            if (medians.end() == found || found->second <= 0.0){
+                std::printf("%-20s %2d  not in baseline\n", entry.op.c_str(), entry.size);
+                continue;
+            }
+            const double change = 100.0 * (entry.result.medianNsec - found->second) / found->second;
+            const bool regressed = change > threshold;
+            regressions += regressed ? 1 : 0;
+            std::printf("%-20s %2d  %10.2f -> %.2f ns/op  %+6.1f%%%s\n", entry.op.c_str(), entry.size,
+                found->second, entry.result.medianNsec, change, regressed ? "  REGRESSION" : "");
+        }
+        return regressions;
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --min-size N     smallest board size (default 2)\n"
+            "  --max-size N     largest board size (default 16)\n"
+            "  --reps N         timed runs per operation (default 7)\n"
+            "  --min-time MS    minimum duration of a timed run (default 10)\n"
+            "  --seed N         seed of the positions (default 1)\n"
+            "  --json FILE      write the results as JSON\n"
+            "  --baseline FILE  compare against the JSON of an earlier run, exit 2 on a regression\n"
+            "  --threshold PCT  slowdown of the median counted as a regression (default 10)\n",
+            program);
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--min-size")){
+                config.minSize = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--max-size")){
+                config.maxSize = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--reps")){
+                config.reps = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--min-time")){
+                config.minSeconds = std::atof(value) / 1000.0;
+            }
+            else if (0 == std::strcmp(arg, "--seed")){
+                config.seed = std::strtoull(value, nullptr, 10);
+            }
+            else if (0 == std::strcmp(arg, "--json")){
+                config.jsonPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--baseline")){
+                config.baselinePath = value;
+            }
+            else if (0 == std::strcmp(arg, "--threshold")){
+                config.threshold = std::atof(value);
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.minSize >= 2 && config.maxSize >= config.minSize && config.reps > 0 && config.minSeconds > 0.0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the Board microbenchmark.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application, 2 if the baseline comparison found a regression.
+ */
+int main(int argc, char* argv[])
+{
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::map<std::pair<std::string, int>, double> baseline;
+    if (config.baselinePath && !readBaseline(config.baselinePath, baseline)){
+        return 1;
+    }
+
+    std::vector<Entry> entries;
+    for (int size = config.minSize; size <= config.maxSize; size++){
+        benchSize(size, config, entries);
+    }
+
+    if (config.jsonPath && !writeJson(config.jsonPath, config, entries)){
+        return 1;
+    }
+    if (config.baselinePath && compareBaseline(baseline, entries, config.threshold) > 0){
+        return 2;
+    }
+    return 0;
+}
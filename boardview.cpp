@@ -0,0 +1,283 @@
+/**
+ * @file boardview.cpp
+ * @brief Implementation file for the BoardView class.
+ *
+ * This file contains the implementation of the BoardView class, which paints the game board
+ * and translates mouse clicks into cell coordinates.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <limits>
+#include "boardview.h"
+#include "commondef.h"
+
+namespace {
+    const int NO_HINT = std::numeric_limits<int>::min(); // Marks a cell without analysis score
+}
+
+/**
+ * @brief Constructor for the BoardView class.
+ *
+ * @param parent The parent widget.
+ */
+BoardView::BoardView(QWidget* parent)
+    : QWidget(parent)
+    , size(0)
+    , cellWidth(0)
+    , cellHeight(0)
+    , pressedCell(-1) {
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setBoardSize(tictactoe::DEFAULT_BOARD_SIZE);
+}
+
+/**
+ * @brief Sets the number of rows and columns of the board and clears it.
+ *
+ * @param size_i The new board size.
+ */
+void BoardView::setBoardSize(int size_i) {
+    if (size_i <= 0) {
+        LOG_ERROR("Invalid board size");
+        return;
+    }
+    size = size_i;
+    cells.fill(QString(), size * size);
+    hints.fill(NO_HINT, size * size);
+    pressedCell = -1;
+    updateGeometryCache();
+    update();
+}
+
+/**
+ * @brief Sets the text of a cell and repaints only that cell.
+ *
+ * @param row The row index of the cell.
+ * @param col The column index of the cell.
+ * @param text The text to show in the cell.
+ */
+void BoardView::setCell(int row, int col, const QString& text) {
+    if (row < 0 || row >= size || col < 0 || col >= size) {
+        LOG_ERROR("Invalid cell");
+        return;
+    }
+    QString& cell = cells[row * size + col];
+    if (cell != text) {
+        cell = text;
+        update(cellRect(row, col));
+    }
+}
+
+/**
+ * @brief Clears the text of all cells.
+ */
+void BoardView::clearCells() {
+    cells.fill(QString());
+    update();
+}
+
+/**
+ * @brief Sets the analysis score shown as a heatmap overlay on a cell.
+ *
+ * The overlay is only drawn on empty cells. Only the cell is repainted, and only if the score changed.
+ *
+ * @param row The row index of the cell.
+ * @param col The column index of the cell.
+ * @param score The score of a move on the cell, from DEFAULT_MIN_SCORE to DEFAULT_MAX_SCORE.
+ */
+void BoardView::setCellHint(int row, int col, int score) {
+    if (row < 0 || row >= size || col < 0 || col >= size) {
+        LOG_ERROR("Invalid cell");
+        return;
+    }
+    int& hint = hints[row * size + col];
+    if (hint != score) {
+        hint = score;
+        update(cellRect(row, col));
+    }
+}
+
+/**
+ * @brief Removes the heatmap overlay from all cells.
+ */
+void BoardView::clearHints() {
+    for (int cell = 0; cell < hints.size(); ++cell) {
+        if (hints[cell] != NO_HINT) {
+            hints[cell] = NO_HINT;
+            update(cellRect(cell / size, cell % size));
+        }
+    }
+}
+
+/**
+ * @brief Returns the preferred size of the board.
+ *
+ * @return The layout size used by the game window.
+ */
+QSize BoardView::sizeHint() const {
+    return QSize(tictactoe::LAYOUT_WIDTH, tictactoe::LAYOUT_HEIGHT);
+}
+
+/**
+ * @brief Paints the cells intersecting the exposed region.
+ *
+ * Only the rows and columns covered by the exposed rectangle are visited, so repainting a
+ * single dirty cell costs the same on every board size.
+ *
+ * @param event The paint event.
+ */
+void BoardView::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    const QRect dirty = event->rect();
+    painter.fillRect(dirty, palette().window());
+
+    if (size <= 0 || cellWidth <= 0 || cellHeight <= 0) {
+        return;
+    }
+
+    const int firstCol = qMax(0, dirty.left() / cellWidth);
+    const int lastCol = qMin(size - 1, dirty.right() / cellWidth);
+    const int firstRow = qMax(0, dirty.top() / cellHeight);
+    const int lastRow = qMin(size - 1, dirty.bottom() / cellHeight);
+
+    const QPalette::ColorGroup group = isEnabled() ? QPalette::Active : QPalette::Disabled;
+    const QBrush cellBrush = palette().brush(group, QPalette::Button);
+    const QColor gridColor = palette().color(group, QPalette::Mid);
+    const QColor textColor = palette().color(group, QPalette::ButtonText);
+
+    painter.setFont(symbolFont);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            const QRect rect = cellRect(row, col);
+            painter.fillRect(rect, cellBrush);
+            painter.setPen(gridColor);
+            painter.drawRect(rect.adjusted(0, 0, -1, -1));
+
+            const QString& text = cells[row * size + col];
+            if (!text.isEmpty()) {
+                painter.setPen(textColor);
+                painter.drawText(rect, Qt::AlignCenter, text);
+            }
+            else if (hints[row * size + col] != NO_HINT) {
+                // red for losing moves through yellow to green for winning moves
+                const int hint = qBound(tictactoe::DEFAULT_MIN_SCORE, hints[row * size + col], tictactoe::DEFAULT_MAX_SCORE);
+                const int hue = 120 * (hint - tictactoe::DEFAULT_MIN_SCORE) / (tictactoe::DEFAULT_MAX_SCORE - tictactoe::DEFAULT_MIN_SCORE);
+                painter.fillRect(rect.adjusted(1, 1, -1, -1), QColor::fromHsv(hue, 200, 255, 110));
+                painter.setPen(textColor);
+                painter.setFont(hintFont);
+                painter.drawText(rect.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop, QString::number(hint));
+                painter.setFont(symbolFont);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Records the cell under the mouse when a button is pressed.
+ *
+ * @param event The mouse event.
+ */
+void BoardView::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        pressedCell = cellAt(event->position().toPoint());
+#else
+        pressedCell = cellAt(event->pos());
+#endif
+    }
+    QWidget::mousePressEvent(event);
+}
+
+/**
+ * @brief Emits cellClicked when the button is released over the pressed cell.
+ *
+ * @param event The mouse event.
+ */
+void BoardView::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        const int cell = cellAt(event->position().toPoint());
+#else
+        const int cell = cellAt(event->pos());
+#endif
+        const int pressed = pressedCell;
+        pressedCell = -1;
+        if (cell >= 0 && cell == pressed) {
+            emit cellClicked(cell / size, cell % size);
+        }
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+/**
+ * @brief Recomputes the cell geometry when the widget is resized.
+ *
+ * @param event The resize event.
+ */
+void BoardView::resizeEvent(QResizeEvent* event) {
+    updateGeometryCache();
+    QWidget::resizeEvent(event);
+}
+
+/**
+ * @brief Repaints the board when its enabled state changes.
+ *
+ * @param event The change event.
+ */
+void BoardView::changeEvent(QEvent* event) {
+    if (event->type() == QEvent::EnabledChange) {
+        pressedCell = -1;
+        update();
+    }
+    QWidget::changeEvent(event);
+}
+
+/**
+ * @brief Recomputes the cell size and symbol font from the widget size.
+ */
+void BoardView::updateGeometryCache() {
+    if (size <= 0) {
+        return;
+    }
+    cellWidth = width() / size;
+    cellHeight = height() / size;
+
+    // setting font based on cell size
+    symbolFont = font();
+    symbolFont.setPixelSize(qMax(1, qMin(cellWidth, cellHeight) * 3 / 5));
+    hintFont = font();
+    hintFont.setPixelSize(qMax(1, qMin(cellWidth, cellHeight) / 5));
+}
+
+/**
+ * @brief Gets the rectangle covered by a cell.
+ *
+ * @param row The row index of the cell.
+ * @param col The column index of the cell.
+ * @return The cell rectangle in widget coordinates.
+ */
+QRect BoardView::cellRect(int row, int col) const {
+    return QRect(col * cellWidth, row * cellHeight, cellWidth, cellHeight);
+}
+
+/**
+ * @brief Maps a widget position to a cell index.
+ *
+ * @param pos The position in widget coordinates.
+ * @return The row-major cell index, or -1 if the position is outside the board.
+ */
+int BoardView::cellAt(const QPoint& pos) const {
+    if (cellWidth <= 0 || cellHeight <= 0 || pos.x() < 0 || pos.y() < 0) {
+        return -1;
+    }
+    const int col = pos.x() / cellWidth;
+    const int row = pos.y() / cellHeight;
+    if (row >= size || col >= size) {
+        return -1;
+    }
+    return row * size + col;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file boardview.h
+ * @brief Header file for the BoardView class.
+ *
+ * This file contains the declaration of the BoardView class, a single custom-painted widget
+ * that renders the Tic Tac Toe board and maps mouse clicks to board cells.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef BOARDVIEW_H
+#define BOARDVIEW_H
+
+#include <QWidget>
+#include <QVector>
+#include <QString>
+
+/**
+ * @brief The BoardView class renders the game board with QPainter.
+ *
+ * Cells are addressed arithmetically from the widget geometry, so the cost of a move
+ * is independent of the board size and only the changed cell is repainted.
+ */
+class BoardView : public QWidget{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a BoardView object.
+     */
+    explicit BoardView(QWidget* parent = nullptr);
+
+    /**
+     * @brief Sets the number of rows and columns of the board and clears it.
+     */
+    void setBoardSize(int size_i);
+
+    /**
+     * @brief Gets the number of rows and columns of the board.
+     */
+    inline int getBoardSize() const { return size; }
+
+    /**
+     * @brief Gets the text of a cell, empty if no symbol was placed there.
+     */
+    inline const QString& getCell(int row, int col) const { return cells[row * size + col]; }
+
+    /**
+     * @brief Sets the text of a cell and repaints only that cell.
+     */
+    void setCell(int row, int col, const QString& text);
+
+    /**
+     * @brief Clears the text of all cells.
+     */
+    void clearCells();
+
+    /**
+     * @brief Sets the analysis score shown as a heatmap overlay on a cell.
+     */
+    void setCellHint(int row, int col, int score);
+
+    /**
+     * @brief Removes the heatmap overlay from all cells.
+     */
+    void clearHints();
+
+    /**
+     * @brief Returns the preferred size of the board.
+     */
+    QSize sizeHint() const override;
+
+signals:
+    /**
+     * @brief Emitted when an enabled cell is clicked.
+     */
+    void cellClicked(int row, int col);
+
+protected:
+    /**
+     * @brief Paints the cells intersecting the exposed region.
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+    /**
+     * @brief Records the cell under the mouse when a button is pressed.
+     */
+    void mousePressEvent(QMouseEvent* event) override;
+
+    /**
+     * @brief Emits cellClicked when the button is released over the pressed cell.
+     */
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+    /**
+     * @brief Recomputes the cell geometry when the widget is resized.
+     */
+    void resizeEvent(QResizeEvent* event) override;
+
+    /**
+     * @brief Repaints the board when its enabled state changes.
+     */
+    void changeEvent(QEvent* event) override;
+
+private:
+    /**
+     * @brief Recomputes the cell size and symbol font from the widget size.
+     */
+    void updateGeometryCache();
+
+    /**
+     * @brief Gets the rectangle covered by a cell.
+     */
+    QRect cellRect(int row, int col) const;
+
+    /**
+     * @brief Maps a widget position to a cell index.
+     */
+    int cellAt(const QPoint& pos) const;
+
+private:
+    int size; /**< Number of rows and columns. */
+    QVector<QString> cells; /**< Cell texts in row-major order. */
+    QVector<int> hints; /**< Cell analysis scores in row-major order, NO_HINT if not analysed. */
+    int cellWidth; /**< Width of a cell in pixels. */
+    int cellHeight; /**< Height of a cell in pixels. */
+    int pressedCell; /**< Cell index under the last mouse press, -1 if none. */
+    QFont symbolFont; /**< Font used for the cell symbols. */
+    QFont hintFont; /**< Font used for the analysis scores. */
+};
+
+#endif // BOARDVIEW_H
@@ -0,0 +1,309 @@
+/**
+ * @file client.cpp
+ * @brief Implementation file for the local load client of the game server.
+ *
+ * This file contains a command line client that connects to the game server, keeps a number
+ * of games running at once with random human moves and reports throughput, move latency
+ * percentiles and how often the server pushed back.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "board.h"
+#include "latencyhistogram.h"
+#include "notation.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Settings of the load client.
+     */
+    struct ClientConfig{
+        const char* socketPath = "/tmp/tictactoe.sock";
+        int sessions = 100;
+        long long games = 1000;
+        int size = DEFAULT_BOARD_SIZE;
+        const char* ai = "minimax";
+        int level = 0;
+        unsigned seed = 1;
+    };
+
+    /**
+     * @brief Client side copy of one game.
+     */
+    struct Game{
+        Board board;
+        CellPos last{ 0, 0 }; /**< Last human move, taken back if the server was busy. */
+        Clock::time_point sent;
+    };
+
+    class LoadClient{
+    public:
+        explicit LoadClient(const ClientConfig& config_i) : config(config_i), random(config_i.seed) {}
+
+        bool run(){
+            if (!connectServer()){
+                return false;
+            }
+            const auto start = Clock::now();
+            for (int i = 0; i < config.sessions && opened < config.games; i++){
+                openGame();
+            }
+
+            std::string input;
+            char buffer[16384];
+            while (finished < config.games){
+                pollfd descriptor{ fd, POLLIN, 0 };
+                if (!output.empty()){
+                    descriptor.events |= POLLOUT;
+                }
+                if (poll(&descriptor, 1, retries.empty() ? 1000 : 1) < 0 && EINTR != errno){
+                    return false;
+                }
+                if (descriptor.revents & POLLOUT){
+                    const ssize_t sent = send(fd, output.data(), output.size(), MSG_NOSIGNAL);
+                    if (sent < 0 && EAGAIN != errno){
+                        std::fprintf(stderr, "connection lost\n");
+                        return false;
+                    }
+                    if (sent > 0){
+                        output.erase(0, static_cast<size_t>(sent));
+                    }
+                }
+                if (descriptor.revents & (POLLIN | POLLHUP)){
+                    const ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                    if (received <= 0){
+                        std::fprintf(stderr, "connection closed by server\n");
+                        return false;
+                    }
+                    input.append(buffer, static_cast<size_t>(received));
+                    size_t begin = 0;
+                    size_t end = 0;
+                    while (std::string::npos != (end = input.find('\n', begin))){
+                        handleLine(std::string_view(input).substr(begin, end - begin));
+                        begin = end + 1;
+                    }
+                    input.erase(0, begin);
+                }
+                // Moves refused with busy are sent again once the server had time to drain
+                if (!retries.empty() && Clock::now() - lastRetry > std::chrono::milliseconds(1)){
+                    std::vector<uint32_t> pending;
+                    pending.swap(retries);
+                    for (uint32_t id : pending){
+                        playRandom(id);
+                    }
+                    lastRetry = Clock::now();
+                }
+            }
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            output += "stats\n";
+            while (!output.empty()){
+                const ssize_t sent = send(fd, output.data(), output.size(), MSG_NOSIGNAL);
+                if (sent <= 0){
+                    break;
+                }
+                output.erase(0, static_cast<size_t>(sent));
+            }
+            std::string stats;
+            while (std::string::npos == stats.find("stats ")){
+                const ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received <= 0){
+                    break;
+                }
+                stats.append(buffer, static_cast<size_t>(received));
+            }
+            close(fd);
+
+            std::printf("games        %lld with %d concurrent sessions in %.3f s\n", finished, config.sessions, seconds);
+            std::printf("games/sec    %.1f\n", static_cast<double>(finished) / seconds);
+            std::printf("moves/sec    %.1f\n", static_cast<double>(latency.count()) / seconds);
+            std::printf("busy         %llu\n", static_cast<unsigned long long>(busy));
+            std::printf("move latency p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+                latency.percentile(0.50) / 1000.0, latency.percentile(0.99) / 1000.0,
+                latency.percentile(0.999) / 1000.0, latency.percentile(1.0) / 1000.0);
+            const size_t line = stats.find("stats ");
+            if (std::string::npos != line){
+                std::printf("server       %s", stats.c_str() + line + 6);
+            }
+            return true;
+        }
+
+    private:
+        bool connectServer(){
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, config.socketPath, sizeof(address.sun_path) - 1);
+            fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0){
+                std::fprintf(stderr, "cannot connect to %s: %s\n", config.socketPath, std::strerror(errno));
+                return false;
+            }
+            return true;
+        }
+
+        void openGame(){
+            opened++;
+            output += "new " + std::to_string(config.size) + " x " + config.ai + " " + std::to_string(config.level) + "\n";
+        }
+
+        void playRandom(uint32_t id){
+            Game& game = games[id];
+            std::vector<CellPos> empty;
+            const int size = game.board.getSize();
+            for (int row = 0; row < size; row++){
+                for (int col = 0; col < size; col++){
+                    if (game.board.isEmpty(CellPos{ col, row })){
+                        empty.push_back(CellPos{ col, row });
+                    }
+                }
+            }
+            const CellPos pos = empty[std::uniform_int_distribution<size_t>(0, empty.size() - 1)(random)];
+            game.board.makeMove(pos, Symbol::X);
+            game.last = pos;
+            game.sent = Clock::now();
+            output += "play " + std::to_string(id) + " " + toNotation(pos) + "\n";
+        }
+
+        void handleLine(std::string_view line){
+            const size_t space = line.find(' ');
+            const std::string_view reply = line.substr(0, space);
+            const std::string_view rest = (std::string_view::npos == space) ? std::string_view() : line.substr(space + 1);
+            const uint32_t id = static_cast<uint32_t>(std::strtoul(std::string(rest).c_str(), nullptr, 10));
+
+            if ("session" == reply){
+                games[id].board.startNewGame(config.size);
+                playRandom(id);
+            }
+            else if ("move" == reply){
+                Game& game = games[id];
+                latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - game.sent).count()));
+                CellPos pos{ 0, 0 };
+                if (parseNotation(rest.substr(rest.find(' ') + 1), pos)){
+                    game.board.makeMove(pos, Symbol::O);
+                }
+                if (Symbol::None == game.board.checkForWinner() && !game.board.isBoardFull()){
+                    playRandom(id);
+                }
+            }
+            else if ("over" == reply){
+                finished++;
+                games.erase(id);
+                output += "close " + std::string(rest.substr(0, rest.find(' '))) + "\n";
+                if (opened < config.games){
+                    openGame();
+                }
+            }
+            else if ("busy" == reply){
+                busy++;
+                // The refused move was not played on the server
+                Game& game = games[id];
+                game.board.undoMove(game.last);
+                retries.push_back(id);
+            }
+            else if ("error" == reply){
+                std::fprintf(stderr, "server: %.*s\n", static_cast<int>(line.size()), line.data());
+            }
+        }
+
+    private:
+        ClientConfig config;
+        int fd = -1;
+        std::mt19937 random;
+        std::unordered_map<uint32_t, Game> games;
+        std::vector<uint32_t> retries;
+        Clock::time_point lastRetry;
+        std::string output;
+        long long opened = 0;
+        long long finished = 0;
+        uint64_t busy = 0;
+        LatencyHistogram latency;
+    };
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --socket PATH    Unix socket of the server (default /tmp/tictactoe.sock)\n"
+            "  --sessions N     games kept open at once (default 100)\n"
+            "  --games N        games to play in total (default 1000)\n"
+            "  --size N         board size (default %d)\n"
+            "  --ai TYPE        AI of the server: minimax or random (default minimax)\n"
+            "  --level N        search depth level of the server (default 0)\n"
+            "  --seed N         seed of the random human moves (default 1)\n",
+            program, DEFAULT_BOARD_SIZE);
+    }
+
+    bool parseArguments(int argc, char* argv[], ClientConfig& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--socket")){
+                config.socketPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--sessions")){
+                config.sessions = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--games")){
+                config.games = std::atoll(value);
+            }
+            else if (0 == std::strcmp(arg, "--size")){
+                config.size = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--ai")){
+                config.ai = value;
+            }
+            else if (0 == std::strcmp(arg, "--level")){
+                config.level = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--seed")){
+                config.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.sessions > 0 && config.games > 0 && config.size >= 2 && config.size <= MAX_NOTATION_SIZE;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the load client.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    ClientConfig config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+    LoadClient client(config);
+    return client.run() ? 0 : 1;
+}
@@ -13,9 +13,7 @@
 #ifndef COMMON_H
 #define COMMON_H
 
-#include <QString>
-#include <QPoint>
-#include <QDebug>
+#include <string_view>
 #include "logger.h"
 
 namespace tictactoe {
@@ -27,18 +25,30 @@ namespace tictactoe {
     const int LAYOUT_WIDTH  = 500;
     const int LAYOUT_HEIGHT  = 500;
 
-    const QString CROSS = "X";
-    const QString CIRCLE = "O";
-    const QString NO_VAL = "no val";
-    const QString UNKNOWN = "Unknown";
-    const QString TIE = "Tie Game!";
-    const QString PLAYER_WON = "You Won!";
-    const QString PLAYER_LOST = "You Lost!";
-    const QString CLICK_START = "Click Start";
-    const QString CLICK_CELL = "Click Cell";
-    const QString INVALID_MOVE = "Invalid";
-    const QString PC_CALC = "Thinking !";
-    const QString ICON_PATH = "icon - 2.png";
+    constexpr std::string_view CROSS = "X";
+    constexpr std::string_view CIRCLE = "O";
+    constexpr std::string_view NO_VAL = "no val";
+    constexpr std::string_view UNKNOWN = "Unknown";
+    constexpr std::string_view TIE = "Tie Game!";
+    constexpr std::string_view PLAYER_WON = "You Won!";
+    constexpr std::string_view PLAYER_LOST = "You Lost!";
+    constexpr std::string_view CLICK_START = "Click Start";
+    constexpr std::string_view CLICK_CELL = "Click Cell";
+    constexpr std::string_view INVALID_MOVE = "Invalid";
+    constexpr std::string_view PC_CALC = "Thinking !";
+    constexpr std::string_view ICON_PATH = "icon - 2.png";
+
+    //types
+    /**
+     * @brief A cell coordinate on the board, x is the column and y the row.
+     */
+    struct CellPos{
+        int x;
+        int y;
+    };
+
+    inline constexpr bool operator==(const CellPos& lhs, const CellPos& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; }
+    inline constexpr bool operator!=(const CellPos& lhs, const CellPos& rhs) { return !(lhs == rhs); }
 
     //enums
     enum class Symbol { None, X, O };
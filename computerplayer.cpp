@@ -8,55 +8,91 @@
  * @date 2024-02-16
  */
 
+#include <chrono>
 #include "computerplayer.h"
 #include "aifactory.h"
+#include "metrics.h"
 
 namespace tictactoe{
 
+    namespace {
+        const Metrics::Id PLAYER_MOVE_NSEC = Metrics::getInstance().histogram("tictactoe_computer_player_move_nsec", "Time of ComputerPlayer::makeMove, search and move");
+        const Metrics::Id SEARCH_NODES = Metrics::getInstance().counter("tictactoe_search_nodes_total", "Nodes searched for computer player moves");
+    }
+
     /**
      * @brief Constructor for the ComputerPlayer class.
      *
      * @param symbol The symbol associated with the player.
      * @param ai The AI strategy used by the computer player.
+     * @param boardSize The board size the AI was acquired for.
+     */
+    ComputerPlayer::ComputerPlayer(Symbol symbol, std::unique_ptr<GameAI> ai, int boardSize)
+        : Player(symbol, std::move(ai)), aiBoardSize(boardSize) {}
+
+    /**
+     * @brief Destructor for the ComputerPlayer class.
+     *
+     * Returns the AI to the pool so a later game starts with warm caches.
      */
-    ComputerPlayer::ComputerPlayer(Symbol symbol, std::unique_ptr<GameAI> ai)
-        : Player(symbol, std::move(ai)) {}
+    ComputerPlayer::~ComputerPlayer(){
+        AIFactory::releaseAI(std::move(ai), aiBoardSize);
+    }
 
     /**
      * @brief Makes a move on the board using the computer player's AI.
      *
+     * The statistics of the search are kept for getLastStats.
+     *
      * @param point The position to make the move.
      * @param board The game board.
      * @return true if the move was successful, false otherwise.
      */
-    bool ComputerPlayer::makeMove(const QPoint& point, Board& board){
+    bool ComputerPlayer::makeMove(const CellPos& point, Board& board){
         if (ai){
-            QPoint move = ai->makeMove(board, symbol);
-            curPos = move;
-            return board.makeMove(move, getSymbol());
+            const auto start = std::chrono::steady_clock::now();
+            CellPos move = ai->makeMove(board, symbol);
+            lastStats = ai->getLastStats();
+            const bool played = playMove(move, board);
+            Metrics& metrics = Metrics::getInstance();
+            metrics.add(SEARCH_NODES, lastStats.nodes);
+            metrics.record(PLAYER_MOVE_NSEC,
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            return played;
         }
         // No AI available to make a move, handle error
-        Logger::getInstance().logError("Error: Invalid AI pointer: failed to make a move.", LOG_LOCATION);
+        LOG_ERROR("Error: Invalid AI pointer: failed to make a move.");
         return false;
     }
 
     /**
-     * @brief Changes the AI type of the computer player.
+     * @brief Changes the AI type of the computer player and the board size it plays on.
+     *
+     * The current AI is returned to the pool and a warm one is taken for the new type and size.
+     * The level of the current AI is kept.
      *
      * @param aitype The new AI type.
+     * @param boardSize The board size the AI will play on.
      * @return True if the AI was changed successfully, false otherwise.
      */
-    bool ComputerPlayer::changeAI(AIType aitype){
-        // Delete the existing AI object
-        ai.reset();
+    bool ComputerPlayer::changeAI(AIType aitype, int boardSize){
+        GameLevel level = ai ? ai->getLevel() : GameLevel::EASY;
+
+        // Return the existing AI object to the pool
+        AIFactory::releaseAI(std::move(ai), aiBoardSize);
 
-        // Create a new AI object based on the new AI type
-        ai = AIFactory::createAI(aitype);
+        // Get an AI object based on the new AI type
+        ai = AIFactory::acquireAI(aitype, boardSize);
         if (!ai){
             // Failed to create AI, handle error
-            Logger::getInstance().logError("AI Creation failed", LOG_LOCATION);
+            LOG_ERROR("AI Creation failed");
             return false;
         }
+        aiBoardSize = boardSize;
+        ai->setLevel(level);
+        ai->setPositionDB(positionDB);
+        ai->setEvalWeights(evalWeights);
+        ai->setNeuralEval(neuralEval);
         return true; // AI changed successfully
     }
 
@@ -26,17 +26,25 @@ namespace tictactoe{
         /**
          * @brief Constructor for ComputerPlayer class.
          */
-        ComputerPlayer(Symbol symbol, std::unique_ptr<GameAI> ai);
+        ComputerPlayer(Symbol symbol, std::unique_ptr<GameAI> ai, int boardSize = DEFAULT_BOARD_SIZE);
+
+        /**
+         * @brief Destructor for ComputerPlayer class.
+         */
+        ~ComputerPlayer() override;
 
         /**
          * @brief Makes a move on the board.
          */
-        bool makeMove(const QPoint& point, Board& board) override;
+        bool makeMove(const CellPos& point, Board& board) override;
 
         /**
          * @brief Changes the AI strategy.
          */
-        bool changeAI(AIType aitype) override;
+        bool changeAI(AIType aitype, int boardSize) override;
+
+    private:
+        int aiBoardSize; // Board size the AI was acquired for
     };
 
 } // namespace tictactoe
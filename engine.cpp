@@ -0,0 +1,310 @@
+/**
+ * @file engine.cpp
+ * @brief Implementation file for the line-based engine protocol.
+ *
+ * This file contains a command line engine that reads commands from stdin and writes replies
+ * to stdout, one per line, so harnesses can drive it as a long-lived subprocess. Commands:
+ *
+ *   position <size> [moves <m1> <m2> ...]   set up a position, X moves first
+ *   ai <minimax|random>                     choose the AI of the side to move
+ *   level <n>                               set the search depth level
+ *   go                                      reply "bestmove <m>"
+ *   analyze                                 reply "info move <m> score <s> depth <d>" per move, then "analysis done"
+ *   batch <go|analyze> <count>              the next count lines are positions ("<size> [moves ...]"),
+ *                                           each reply is prefixed with "<index> "
+ *   isready                                 reply "readyok"
+ *   quit                                    exit
+ *
+ * Moves are written as a column letter followed by a 1-based row, e.g. "b2". Invalid commands
+ * are answered with "error <reason>". Started with "--eval FILE", the AI scores positions at
+ * the depth limit with the tuned weights in FILE; with "--net FILE" it scores them and orders
+ * its moves with the neural network in FILE when it was trained for the board size.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "evalweights.h"
+#include "neuraleval.h"
+#include "notation.h"
+#include "tictactoe.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Number of batch replies written between two flushes of stdout.
+     */
+    const int BATCH_FLUSH_INTERVAL = 64;
+
+    bool parseInt(std::string_view text, int& value){
+        if (text.empty() || text.size() > 9){
+            return false;
+        }
+        value = 0;
+        for (char c : text){
+            if (c < '0' || c > '9'){
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    /**
+     * @brief One engine session, a game with the computer as the side to move.
+     */
+    class EngineSession{
+    public:
+        EngineSession(std::shared_ptr<const EvalWeights> evalWeights, std::shared_ptr<const NeuralEval> neuralEval)
+            : aitype(AIType::Minimax), level(GameLevel::EASY) {
+            game.startNewGame(Symbol::O, aitype, DEFAULT_BOARD_SIZE);
+            game.setEvalWeights(std::move(evalWeights));
+            game.setNeuralEval(std::move(neuralEval));
+        }
+
+        /**
+         * @brief Handles one command line.
+         *
+         * @return false once the session should end.
+         */
+        bool handle(std::string_view line){
+            const std::string_view command = nextWord(line);
+            if (command.empty()){
+                return true;
+            }
+            if ("quit" == command){
+                return false;
+            }
+            if ("isready" == command){
+                out << "readyok\n";
+            }
+            else if ("position" == command){
+                std::string error;
+                if (!setPosition(line, error)){
+                    out << "error " << error << '\n';
+                }
+            }
+            else if ("ai" == command){
+                setAI(nextWord(line));
+            }
+            else if ("level" == command){
+                int value = 0;
+                if (parseInt(nextWord(line), value)){
+                    level = static_cast<GameLevel>(value);
+                    game.setGameLevel(level);
+                }
+                else{
+                    out << "error invalid level\n";
+                }
+            }
+            else if ("go" == command){
+                go(std::string_view());
+            }
+            else if ("analyze" == command){
+                analyze(std::string_view());
+            }
+            else if ("batch" == command){
+                batch(line);
+            }
+            else{
+                out << "error unknown command " << command << '\n';
+            }
+            out.flush();
+            return true;
+        }
+
+    private:
+        /**
+         * @brief Sets up the position "<size> [moves ...]" with the computer to move.
+         */
+        bool setPosition(std::string_view spec, std::string& error){
+            int size = 0;
+            if (!parseInt(nextWord(spec), size) || size < 2 || size > MAX_NOTATION_SIZE){
+                error = "invalid board size";
+                return false;
+            }
+            std::vector<CellPos> moves;
+            const std::string_view keyword = nextWord(spec);
+            if (!keyword.empty() && ("moves" != keyword || !parseMoveList(spec, moves))){
+                error = "invalid move list";
+                return false;
+            }
+
+            // Check the moves on a scratch board, so a bad list leaves the current game untouched
+            Board scratch(size);
+            Symbol symbol = Symbol::X;
+            for (const CellPos& pos : moves){
+                if (pos.x >= size || pos.y >= size || !scratch.isEmpty(pos)
+                    || Symbol::None != scratch.checkForWinner()){
+                    error = "illegal move " + toNotation(pos);
+                    return false;
+                }
+                scratch.makeMove(pos, symbol);
+                symbol = scratch.getOpponent(symbol);
+            }
+
+            // The side to move is the computer, the other side replays its moves as the human
+            const Symbol toMove = (0 == moves.size() % 2) ? Symbol::X : Symbol::O;
+            const Symbol human = (Symbol::X == toMove) ? Symbol::O : Symbol::X;
+            game.startNewGame(human, aitype, size);
+            game.setGameLevel(level);
+
+            symbol = Symbol::X;
+            for (const CellPos& pos : moves){
+                const bool played = (human == symbol) ? game.makeMove(pos, Player_Type::HUMAN) : game.applyComputerMove(pos);
+                if (!played){
+                    error = "illegal move " + toNotation(pos);
+                    return false;
+                }
+                symbol = (Symbol::X == symbol) ? Symbol::O : Symbol::X;
+            }
+            return true;
+        }
+
+        void setAI(std::string_view name){
+            if ("minimax" == name){
+                aitype = AIType::Minimax;
+            }
+            else if ("random" == name){
+                aitype = AIType::Random;
+            }
+            else{
+                out << "error unknown ai " << name << '\n';
+                return;
+            }
+            game.setAITypeComputer(aitype);
+            game.setGameLevel(level);
+        }
+
+        bool isGameOver(){
+            return Player_Type::UNKNOWN != game.checkForWinner() || game.isBoardFull();
+        }
+
+        /**
+         * @brief Writes the computer's move without playing it.
+         */
+        void go(std::string_view prefix){
+            if (isGameOver()){
+                out << prefix << "error game over\n";
+                return;
+            }
+            std::unique_ptr<SearchTask> search = game.createComputerSearch();
+            if (!search){
+                out << prefix << "error search failed\n";
+                return;
+            }
+            while (!search->step(1 << 20)){
+            }
+            out << prefix << "bestmove " << toNotation(search->getBestMove()) << '\n';
+        }
+
+        /**
+         * @brief Writes the score of every legal move of the computer.
+         */
+        void analyze(std::string_view prefix){
+            if (isGameOver()){
+                out << prefix << "error game over\n";
+                return;
+            }
+            for (const MoveScore& score : game.analyzeComputerMoves()){
+                out << prefix << "info move " << toNotation(score.move) << " score " << score.score << " depth " << score.depth << '\n';
+            }
+            out << prefix << "analysis done\n";
+        }
+
+        /**
+         * @brief Reads the given number of positions from stdin and streams a reply for each.
+         *
+         * Replies are written in input order as soon as they are ready and flushed in groups,
+         * so a harness can overlap writing the next batch with reading this one.
+         */
+        void batch(std::string_view args){
+            const std::string_view mode = nextWord(args);
+            int count = 0;
+            if (("go" != mode && "analyze" != mode) || !parseInt(nextWord(args), count)){
+                out << "error usage: batch <go|analyze> <count>\n";
+                return;
+            }
+            std::string line;
+            std::string prefix;
+            for (int index = 0; index < count && std::getline(in, line); index++){
+                prefix = std::to_string(index);
+                prefix += ' ';
+                std::string error;
+                if (!setPosition(line, error)){
+                    out << prefix << "error " << error << '\n';
+                }
+                else if ("go" == mode){
+                    go(prefix);
+                }
+                else{
+                    analyze(prefix);
+                }
+                if (0 == (index + 1) % BATCH_FLUSH_INTERVAL){
+                    out.flush();
+                }
+            }
+        }
+
+    private:
+        TicTacToe game; /**< The game holding the position and the computer's AI. */
+        AIType aitype; /**< AI type used for new positions. */
+        GameLevel level; /**< Level used for new positions. */
+        std::istream& in = std::cin;
+        std::ostream& out = std::cout;
+    };
+
+} // namespace
+
+/**
+ * @brief Entry point of the engine.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    std::shared_ptr<EvalWeights> evalWeights;
+    std::shared_ptr<NeuralEval> neuralEval;
+    for (int i = 1; i < argc; i += 2){
+        const std::string_view option(argv[i]);
+        if (i + 1 < argc && "--eval" == option && !evalWeights){
+            evalWeights = std::make_shared<EvalWeights>();
+            if (!evalWeights->load(argv[i + 1])){
+                return 1;
+            }
+        }
+        else if (i + 1 < argc && "--net" == option && !neuralEval){
+            neuralEval = std::make_shared<NeuralEval>();
+            if (!neuralEval->load(argv[i + 1])){
+                return 1;
+            }
+        }
+        else{
+            std::cerr << "Usage: " << argv[0] << " [--eval FILE] [--net FILE]\n";
+            return 1;
+        }
+    }
+
+    EngineSession session(evalWeights, neuralEval);
+    std::string line;
+    while (std::getline(std::cin, line)){
+        if (!session.handle(line)){
+            break;
+        }
+    }
+    std::cout.flush();
+    return 0;
+}
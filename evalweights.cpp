@@ -0,0 +1,201 @@
+/**
+ * @file evalweights.cpp
+ * @brief Implementation file for the EvalWeights class.
+ *
+ * This file contains the feature extraction, scoring and file format of the tuned
+ * heuristic evaluation.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "evalweights.h"
+#include "logger.h"
+
+namespace tictactoe{
+
+    namespace {
+
+        /**
+         * @brief Adds the line through cells (row + i * dRow, col + i * dCol) to the features.
+         */
+        void addLine(const Board& board, Symbol side, int row, int col, int dRow, int dCol, float* features){
+            const int size = board.getSize();
+            int own = 0;
+            int other = 0;
+            for (int i = 0; i < size; i++){
+                const Symbol symbol = board.getSymbol(CellPos{ col + i * dCol, row + i * dRow });
+                if (side == symbol){
+                    own++;
+                }
+                else if (Symbol::None != symbol){
+                    other++;
+                }
+            }
+            // A complete line is a decided game, counted with the longest open lines
+            if (own > 0 && 0 == other){
+                features[std::min(own, size - 1) - 1] += 1.0f;
+            }
+            else if (other > 0 && 0 == own){
+                features[size - 1 + std::min(other, size - 1) - 1] += 1.0f;
+            }
+        }
+
+    } // namespace
+
+    /**
+     * @brief Computes the features of a position from the point of view of a side.
+     *
+     * @param board The position.
+     * @param side The side the features are counted for, normally the side to move.
+     * @param features Receives featureCount(size) values.
+     */
+    void EvalWeights::extractFeatures(const Board& board, Symbol side, float* features){
+        const int size = board.getSize();
+        const int count = featureCount(size);
+        for (int i = 0; i < count; i++){
+            features[i] = 0.0f;
+        }
+        for (int i = 0; i < size; i++){
+            addLine(board, side, i, 0, 0, 1, features); // Row
+            addLine(board, side, 0, i, 1, 0, features); // Column
+        }
+        addLine(board, side, 0, 0, 1, 1, features);
+        addLine(board, side, 0, size - 1, 1, -1, features);
+        features[count - 1] = 1.0f;
+    }
+
+    /**
+     * @brief Reads weights from a file, replacing the weights of the sizes it contains.
+     *
+     * @param path The file path.
+     * @return true on success, false if the file cannot be read or is malformed.
+     */
+    bool EvalWeights::load(const std::string& path){
+        std::ifstream input(path);
+        if (!input){
+            LOG_ERROR("Cannot open weights file " + path);
+            return false;
+        }
+        std::string line;
+        while (std::getline(input, line)){
+            if (line.empty() || '#' == line[0]){
+                continue;
+            }
+            std::istringstream fields(line);
+            std::string tag;
+            int size = 0;
+            int count = 0;
+            std::vector<float> values;
+            fields >> tag >> size >> count;
+            float value = 0.0f;
+            while (fields >> value){
+                values.push_back(value);
+            }
+            if ("size" != tag || count != static_cast<int>(values.size()) || !setWeights(size, values)){
+                LOG_ERROR("Malformed weights file " + path);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes the weights of all sizes to a file.
+     *
+     * @param path The file path, an existing file is replaced.
+     * @return true on success, false if the file cannot be written.
+     */
+    bool EvalWeights::save(const std::string& path) const{
+        std::ofstream output(path);
+        output << "# tictactoe evaluation weights: size <board size> <weight count> <weight> ...\n";
+        output.precision(9);
+        for (size_t size = 0; size < weights.size(); size++){
+            if (weights[size].empty()){
+                continue;
+            }
+            output << "size " << size << " " << weights[size].size();
+            for (float weight : weights[size]){
+                output << " " << weight;
+            }
+            output << "\n";
+        }
+        output.flush();
+        if (!output){
+            LOG_ERROR("Cannot write weights file " + path);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks whether weights are set for a board size.
+     *
+     * @param size The board size.
+     * @return true if the size has weights.
+     */
+    bool EvalWeights::hasWeights(int size) const{
+        return size >= 0 && size < static_cast<int>(weights.size()) && !weights[size].empty();
+    }
+
+    /**
+     * @brief Sets the weights of a board size.
+     *
+     * @param size The board size.
+     * @param weights_i featureCount(size) weights.
+     * @return true on success, false if the number of weights does not match the size.
+     */
+    bool EvalWeights::setWeights(int size, const std::vector<float>& weights_i){
+        if (size < 2 || featureCount(size) != static_cast<int>(weights_i.size())){
+            return false;
+        }
+        if (size >= static_cast<int>(weights.size())){
+            weights.resize(static_cast<size_t>(size) + 1);
+        }
+        weights[size] = weights_i;
+        return true;
+    }
+
+    /**
+     * @brief Scores a position for a side.
+     *
+     * @param board The position, not decided yet.
+     * @param side The side the score is for.
+     * @return The score, 0 if the board size has no weights.
+     */
+    int EvalWeights::evaluate(const Board& board, Symbol side) const{
+        const int size = board.getSize();
+        if (!hasWeights(size)){
+            return 0;
+        }
+        float features[2 * 32 + 1];
+        if (featureCount(size) > static_cast<int>(sizeof(features) / sizeof(features[0]))){
+            return 0;
+        }
+        extractFeatures(board, side, features);
+        const std::vector<float>& sizeWeights = weights[size];
+        float sum = 0.0f;
+        for (size_t i = 0; i < sizeWeights.size(); i++){
+            sum += sizeWeights[i] * features[i];
+        }
+        return toScore(sum);
+    }
+
+    /**
+     * @brief Maps a weighted feature sum to a score.
+     *
+     * The sum is the log odds of a win, so tanh(sum / 2) is the expected result between -1
+     * and 1, which is scaled to the scores strictly between a loss and a win.
+     *
+     * @param sum The weighted feature sum.
+     * @return The score.
+     */
+    int EvalWeights::toScore(float sum){
+        return static_cast<int>(std::lround((DEFAULT_MAX_SCORE - 1) * std::tanh(sum / 2.0f)));
+    }
+
+} // namespace tictactoe
@@ -0,0 +1,85 @@
+/**
+ * @file evalweights.h
+ * @brief Header file for the EvalWeights class.
+ *
+ * This file contains the declaration of the EvalWeights class, the tuned weights of the
+ * heuristic evaluation MinimaxAI applies at the depth limit. The weights are tuned per board
+ * size by the tictactoe_tune tool and stored in a text file with one line per size:
+ *
+ *   size <board size> <weight count> <weight> ...
+ *
+ * Lines starting with '#' are comments.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef EVALWEIGHTS_H
+#define EVALWEIGHTS_H
+
+#include <string>
+#include <vector>
+#include "board.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief The EvalWeights class scores positions the search could not resolve.
+     *
+     * The features of a position count, for each number of symbols k, the lines holding k
+     * symbols of the side to move and none of the opponent, then the same for the opponent,
+     * followed by a constant 1. The weighted sum e estimates the log odds of the side to
+     * move winning, and the score is the expected result scaled into the open interval
+     * between DEFAULT_MIN_SCORE and DEFAULT_MAX_SCORE so a decided game always outscores it.
+     */
+    class EvalWeights{
+    public:
+        /**
+         * @brief Gets the number of features of a board size.
+         */
+        static inline int featureCount(int size) { return 2 * (size - 1) + 1; }
+
+        /**
+         * @brief Computes the features of a position from the point of view of a side.
+         */
+        static void extractFeatures(const Board& board, Symbol side, float* features);
+
+        /**
+         * @brief Reads weights from a file, replacing the weights of the sizes it contains.
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Writes the weights of all sizes to a file.
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Checks whether weights are set for a board size.
+         */
+        bool hasWeights(int size) const;
+
+        /**
+         * @brief Sets the weights of a board size.
+         */
+        bool setWeights(int size, const std::vector<float>& weights_i);
+
+        /**
+         * @brief Scores a position for a side, 0 if the size has no weights.
+         */
+        int evaluate(const Board& board, Symbol side) const;
+
+        /**
+         * @brief Maps a weighted feature sum to a score.
+         */
+        static int toScore(float sum);
+
+    private:
+        std::vector<std::vector<float>> weights; /**< Weights indexed by board size, empty for untuned sizes. */
+    };
+
+} // namespace tictactoe
+
+#endif // EVALWEIGHTS_H
@@ -13,6 +13,31 @@
 
 namespace tictactoe {
 
+	namespace {
+		/**
+		 * @brief Search task running a whole makeMove call in its first step.
+		 */
+		class ImmediateSearch : public SearchTask {
+		public:
+			ImmediateSearch(const GameAI& ai_i, const Board& board_i, Symbol symbol_i)
+				: ai(ai_i), board(board_i), symbol(symbol_i) {}
+
+			bool step(int maxNodes) override {
+				if (!finished && maxNodes > 0) {
+					bestMove = ai.makeMove(board, symbol);
+					nodes++;
+					finished = true;
+				}
+				return finished;
+			}
+
+		private:
+			const GameAI& ai; // The AI making the move
+			Board board; // Copy of the position to search
+			Symbol symbol; // The side to move
+		};
+	}
+
 	/**
 	 * @brief Default constructor for the GameAI class.
 	 *
@@ -20,4 +45,58 @@ namespace tictactoe {
 	 */
 	GameAI::GameAI() : level(GameLevel::EASY) {}
 
+	/**
+	 * @brief Restores the state of a newly created AI, keeping caches that stay valid.
+	 *
+	 * Called when a pooled AI is handed out again. Anything that would make a reused AI play
+	 * differently from a new one must be reset here; cached results that are exact for their
+	 * position may be kept.
+	 */
+	void GameAI::reset() {
+		level = GameLevel::EASY;
+		lastStats = SearchStats();
+	}
+
+	/**
+	 * @brief Scores every legal move on the board.
+	 *
+	 * The default implementation has no notion of move quality and scores every empty cell as a draw.
+	 *
+	 * @param board The current state of the game board.
+	 * @param symbol The symbol (X or O) of the side to move.
+	 * @param progress Optional callback receiving the scores, may stop the analysis by returning false.
+	 * @param stop Optional flag stopping the analysis once set, unused as the scores take no search.
+	 * @return The scores of all legal moves in row-major order.
+	 */
+	std::vector<MoveScore> GameAI::analyze(const Board& board, Symbol symbol, const AnalysisCallback& progress,
+		const std::atomic<bool>* stop) const {
+		(void)symbol;
+		(void)stop;
+		std::vector<MoveScore> scores;
+		for (int row = 0; row < board.getSize(); row++) {
+			for (int col = 0; col < board.getSize(); col++) {
+				if (board.isEmpty(CellPos{ col, row })) {
+					scores.push_back({ CellPos{ col, row }, 0, 0 });
+				}
+			}
+		}
+		if (progress) {
+			progress(scores);
+		}
+		return scores;
+	}
+
+	/**
+	 * @brief Creates a resumable search for the move makeMove would make.
+	 *
+	 * The default implementation can not be split and runs makeMove in a single step.
+	 *
+	 * @param board The current state of the game board, copied into the task.
+	 * @param symbol The symbol (X or O) of the side to move.
+	 * @return The search task.
+	 */
+	std::unique_ptr<SearchTask> GameAI::createSearch(const Board& board, Symbol symbol) const {
+		return std::make_unique<ImmediateSearch>(*this, board, symbol);
+	}
+
 } // namespace tictactoe
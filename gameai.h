@@ -13,10 +13,35 @@
 #ifndef GAMEAI_H
 #define GAMEAI_H
 
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <memory>
 #include "board.h"
 #include "commondef.h"
+#include "searchstats.h"
+#include "searchtask.h"
 
 namespace tictactoe{
+
+    class PositionDB;
+    class EvalWeights;
+    class NeuralEval;
+
+    /**
+     * @brief The score of a single candidate move produced by an analysis.
+     */
+    struct MoveScore{
+        CellPos move; /**< The candidate move. */
+        int score; /**< The score of the move for the side to move. */
+        int depth; /**< The search depth the score was obtained at, -1 if not scored yet. */
+    };
+
+    /**
+     * @brief Receives intermediate analysis results, returns false to stop the analysis.
+     */
+    using AnalysisCallback = std::function<bool(const std::vector<MoveScore>& scores)>;
+
     /**
      * @brief The GameAI class represents the AI logic for making moves in the Tic-Tac-Toe game.
      */
@@ -35,15 +60,72 @@ namespace tictactoe{
         /**
          * @brief Makes a move on the board.
          */
-        virtual QPoint makeMove(const Board& board, Symbol symbol) const = 0;
+        virtual CellPos makeMove(const Board& board, Symbol symbol) const = 0;
+
+        /**
+         * @brief Scores every legal move on the board.
+         */
+        virtual std::vector<MoveScore> analyze(const Board& board, Symbol symbol, const AnalysisCallback& progress = nullptr,
+            const std::atomic<bool>* stop = nullptr) const;
+
+        /**
+         * @brief Creates a resumable search for the move makeMove would make.
+         */
+        virtual std::unique_ptr<SearchTask> createSearch(const Board& board, Symbol symbol) const;
+
+        /**
+         * @brief Gets the type of the game AI.
+         */
+        virtual AIType getType() const = 0;
+
+        /**
+         * @brief Restores the state of a newly created AI, keeping caches that stay valid.
+         */
+        virtual void reset();
+
+        /**
+         * @brief Discards all cached search results.
+         */
+        virtual void clearCaches() {}
+
+        /**
+         * @brief Sets statistics of recorded games the AI may consult, ignored by default.
+         */
+        virtual void setPositionDB(std::shared_ptr<const PositionDB> positionDB_i) { (void)positionDB_i; }
+
+        /**
+         * @brief Sets tuned weights of a heuristic evaluation the AI may use, ignored by default.
+         */
+        virtual void setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights_i) { (void)evalWeights_i; }
+
+        /**
+         * @brief Sets a neural network the AI may score positions and order moves with, ignored by default.
+         */
+        virtual void setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval_i) { (void)neuralEval_i; }
+
+        /**
+         * @brief Restarts the random choices of the AI from a seed, ignored by deterministic AIs.
+         */
+        virtual void setSeed(uint64_t seed) { (void)seed; }
 
         /**
          * @brief Sets the level of the game AI.
          */
         inline void setLevel(GameLevel level_i) { level = level_i;};
 
+        /**
+         * @brief Gets the level of the game AI.
+         */
+        inline GameLevel getLevel() const { return level; }
+
+        /**
+         * @brief Gets the statistics of the last makeMove or analyze call.
+         */
+        inline const SearchStats& getLastStats() const { return lastStats; }
+
     protected:
         GameLevel level; /**< The level of the game AI. */
+        mutable SearchStats lastStats; /**< Filled by each move, AIs that do not search only record the move. */
     };
 
 } // namespace tictactoe
@@ -0,0 +1,755 @@
+/**
+ * @file gamerecord.cpp
+ * @brief Implementation file for the binary game record format.
+ *
+ * This file contains the implementation of the game record codec, writer and reader.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include "gamerecord.h"
+#include "logger.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#include <io.h>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tictactoe{
+
+    namespace {
+
+        const uint8_t MAGIC[4] = { 'T', 'T', 'T', 'R' };
+        const uint8_t INDEX_MAGIC[4] = { 'T', 'T', 'T', 'I' };
+
+        const uint8_t FLAG_TIMES = 1;
+        const uint8_t FLAG_SCORES = 2;
+        const uint8_t FLAG_O_FIRST = 4;
+
+        uint8_t encodeKind(const RecordedPlayer& player){
+            if (Player_Type::COMPUTER != player.type){
+                return 0;
+            }
+            return AIType::Random == player.aitype ? 1 : 2;
+        }
+
+        bool decodeKind(uint8_t kind, uint8_t level, RecordedPlayer& player){
+            if (kind > 2){
+                return false;
+            }
+            player.type = (0 == kind) ? Player_Type::HUMAN : Player_Type::COMPUTER;
+            player.aitype = (1 == kind) ? AIType::Random : AIType::Minimax;
+            player.level = static_cast<GameLevel>(level);
+            return true;
+        }
+
+        inline uint64_t zigzag(int64_t value){
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t value){
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        // 64 bit file positions, record files grow past 2 GB
+        bool seekFile(std::FILE* file, uint64_t offset){
+#if defined(_WIN32)
+            return 0 == _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+            return 0 == fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+        }
+
+        // Also the positioning stdio needs between reading and writing a stream
+        uint64_t seekEnd(std::FILE* file){
+#if defined(_WIN32)
+            _fseeki64(file, 0, SEEK_END);
+            const __int64 size = _ftelli64(file);
+#else
+            fseeko(file, 0, SEEK_END);
+            const off_t size = ftello(file);
+#endif
+            return size > 0 ? static_cast<uint64_t>(size) : 0;
+        }
+
+        bool truncateFile(std::FILE* file, uint64_t size){
+            std::fflush(file);
+#if defined(_WIN32)
+            const bool truncated = 0 == _chsize_s(_fileno(file), static_cast<__int64>(size));
+#else
+            const bool truncated = 0 == ftruncate(fileno(file), static_cast<off_t>(size));
+#endif
+            seekEnd(file);
+            return truncated;
+        }
+
+        bool readAt(std::FILE* file, uint64_t offset, uint8_t* data, size_t length){
+            return seekFile(file, offset) && length == std::fread(data, 1, length, file);
+        }
+
+    } // namespace
+
+    /**
+     * @brief Appends an unsigned LEB128 varint.
+     *
+     * @param buffer The buffer to append to.
+     * @param value The value to encode, 7 bits per byte.
+     */
+    void GameRecordCodec::putVarint(std::vector<uint8_t>& buffer, uint64_t value){
+        while (value >= 0x80){
+            buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    /**
+     * @brief Reads an unsigned LEB128 varint.
+     *
+     * @param data The encoded bytes.
+     * @param length The number of bytes available.
+     * @param pos The read position, advanced past the varint.
+     * @param value Receives the decoded value.
+     * @return true on success, false if the varint is truncated or too long.
+     */
+    bool GameRecordCodec::getVarint(const uint8_t* data, size_t length, size_t& pos, uint64_t& value){
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7){
+            if (pos >= length){
+                return false;
+            }
+            const uint8_t byte = data[pos++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Writes the file header to the buffer.
+     *
+     * @param buffer The buffer to append to.
+     */
+    void GameRecordCodec::encodeFileHeader(std::vector<uint8_t>& buffer){
+        buffer.insert(buffer.end(), MAGIC, MAGIC + 4);
+        buffer.push_back(VERSION);
+        buffer.insert(buffer.end(), 3, 0);
+    }
+
+    /**
+     * @brief Checks the file header.
+     *
+     * @param data The start of the file.
+     * @param length The length of the file.
+     * @return true if the file starts with a header of a supported version.
+     */
+    bool GameRecordCodec::checkFileHeader(const uint8_t* data, size_t length){
+        return length >= FILE_HEADER_SIZE && std::equal(MAGIC, MAGIC + 4, data) && VERSION == data[4];
+    }
+
+    /**
+     * @brief Gets the path of the index of a record file.
+     *
+     * @param path The path of the record file.
+     * @return The path with ".idx" appended.
+     */
+    std::string GameRecordCodec::indexPath(const std::string& path){
+        return path + ".idx";
+    }
+
+    /**
+     * @brief Writes the index header to the buffer.
+     *
+     * @param buffer The buffer to append to.
+     */
+    void GameRecordCodec::encodeIndexHeader(std::vector<uint8_t>& buffer){
+        buffer.insert(buffer.end(), INDEX_MAGIC, INDEX_MAGIC + 4);
+        buffer.push_back(VERSION);
+        buffer.insert(buffer.end(), 3, 0);
+    }
+
+    /**
+     * @brief Checks the index header.
+     *
+     * @param data The start of the index.
+     * @param length The length of the index.
+     * @return true if the index starts with a header of a supported version.
+     */
+    bool GameRecordCodec::checkIndexHeader(const uint8_t* data, size_t length){
+        return length >= INDEX_HEADER_SIZE && std::equal(INDEX_MAGIC, INDEX_MAGIC + 4, data) && VERSION == data[4];
+    }
+
+    /**
+     * @brief Finds the complete games from a position on, appending their offsets.
+     *
+     * Skips from length prefix to length prefix and stops at the first game that does not fit
+     * in the data, which an interrupted writer leaves behind.
+     *
+     * @param data The bytes to scan.
+     * @param length The number of bytes available.
+     * @param pos Position of the first length prefix.
+     * @param base Offset of data in the file, added to the offsets.
+     * @param offsets Receives the file offset of the length prefix of every complete game.
+     * @return The position after the last complete game.
+     */
+    size_t GameRecordCodec::scanGames(const uint8_t* data, size_t length, size_t pos, uint64_t base, std::vector<uint64_t>& offsets){
+        while (pos < length){
+            size_t body = pos;
+            uint64_t bodyLength = 0;
+            if (!getVarint(data, length, body, bodyLength) || bodyLength > length - body){
+                break;
+            }
+            offsets.push_back(base + pos);
+            pos = body + static_cast<size_t>(bodyLength);
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Appends a little-endian u64.
+     *
+     * @param buffer The buffer to append to.
+     * @param value The value to encode.
+     */
+    void GameRecordCodec::putFixed64(std::vector<uint8_t>& buffer, uint64_t value){
+        for (int shift = 0; shift < 64; shift += 8){
+            buffer.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    /**
+     * @brief Reads a little-endian u64.
+     *
+     * @param data The 8 encoded bytes.
+     * @return The decoded value.
+     */
+    uint64_t GameRecordCodec::getFixed64(const uint8_t* data){
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; i--){
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    /**
+     * @brief Appends the encoding of a game, length prefix included, to the buffer.
+     *
+     * @param record The game to encode.
+     * @param buffer The buffer to append to.
+     */
+    void GameRecordCodec::encode(const GameRecord& record, std::vector<uint8_t>& buffer){
+        // The body is encoded after a one byte length placeholder, which is widened if needed
+        const size_t start = buffer.size();
+        buffer.push_back(0);
+
+        uint8_t flags = 0;
+        flags |= record.hasTimes ? FLAG_TIMES : 0;
+        flags |= record.hasScores ? FLAG_SCORES : 0;
+        flags |= (Symbol::O == record.firstMover) ? FLAG_O_FIRST : 0;
+        uint8_t result = 0;
+        if (record.finished){
+            result = (Symbol::X == record.winner) ? 1 : (Symbol::O == record.winner) ? 2 : 3;
+        }
+        buffer.push_back(static_cast<uint8_t>(record.size));
+        buffer.push_back(flags);
+        buffer.push_back(result);
+        for (const RecordedPlayer& player : record.players){
+            buffer.push_back(encodeKind(player));
+            buffer.push_back(static_cast<uint8_t>(player.level));
+        }
+        putVarint(buffer, record.moves.size());
+        for (const RecordedMove& move : record.moves){
+            putVarint(buffer, static_cast<uint64_t>(move.pos.y * record.size + move.pos.x));
+        }
+        if (record.hasTimes){
+            for (const RecordedMove& move : record.moves){
+                putVarint(buffer, move.timeUsec);
+            }
+        }
+        if (record.hasScores){
+            for (const RecordedMove& move : record.moves){
+                putVarint(buffer, zigzag(move.score));
+            }
+        }
+
+        const size_t bodyLength = buffer.size() - start - 1;
+        if (bodyLength < 0x80){
+            buffer[start] = static_cast<uint8_t>(bodyLength);
+            return;
+        }
+        std::vector<uint8_t> prefix;
+        putVarint(prefix, bodyLength);
+        buffer[start] = prefix[0];
+        buffer.insert(buffer.begin() + static_cast<std::ptrdiff_t>(start) + 1, prefix.begin() + 1, prefix.end());
+    }
+
+    /**
+     * @brief Decodes the body of a game, without its length prefix.
+     *
+     * @param data The encoded body.
+     * @param length The length of the body.
+     * @param record Receives the game, its move storage is reused.
+     * @return true on success, false if the body is malformed.
+     */
+    bool GameRecordCodec::decode(const uint8_t* data, size_t length, GameRecord& record){
+        if (length < 7){
+            return false;
+        }
+        record.size = data[0];
+        const uint8_t flags = data[1];
+        const uint8_t result = data[2];
+        if (record.size < 1 || result > 3
+            || !decodeKind(data[3], data[4], record.players[0]) || !decodeKind(data[5], data[6], record.players[1])){
+            return false;
+        }
+        record.hasTimes = 0 != (flags & FLAG_TIMES);
+        record.hasScores = 0 != (flags & FLAG_SCORES);
+        record.firstMover = (flags & FLAG_O_FIRST) ? Symbol::O : Symbol::X;
+        record.finished = 0 != result;
+        record.winner = (1 == result) ? Symbol::X : (2 == result) ? Symbol::O : Symbol::None;
+
+        size_t pos = 7;
+        uint64_t count = 0;
+        const uint64_t cells = static_cast<uint64_t>(record.size) * record.size;
+        if (!getVarint(data, length, pos, count) || count > cells){
+            return false;
+        }
+        record.moves.resize(static_cast<size_t>(count));
+        for (RecordedMove& move : record.moves){
+            uint64_t cell = 0;
+            if (!getVarint(data, length, pos, cell) || cell >= cells){
+                return false;
+            }
+            move.pos = CellPos{ static_cast<int>(cell % record.size), static_cast<int>(cell / record.size) };
+            move.timeUsec = 0;
+            move.score = 0;
+        }
+        if (record.hasTimes){
+            for (RecordedMove& move : record.moves){
+                uint64_t time = 0;
+                if (!getVarint(data, length, pos, time)){
+                    return false;
+                }
+                move.timeUsec = static_cast<uint32_t>(time);
+            }
+        }
+        if (record.hasScores){
+            for (RecordedMove& move : record.moves){
+                uint64_t score = 0;
+                if (!getVarint(data, length, pos, score)){
+                    return false;
+                }
+                move.score = static_cast<int32_t>(unzigzag(score));
+            }
+        }
+        return pos == length;
+    }
+
+    /**
+     * @brief Constructor for the GameRecordWriter class.
+     *
+     * @param bufferSize_i Number of buffered bytes that triggers a write to the file.
+     */
+    GameRecordWriter::GameRecordWriter(size_t bufferSize_i)
+        : file(nullptr), indexFile(nullptr), bufferSize(bufferSize_i), fileLength(0), games(0) {
+        buffer.reserve(bufferSize + 256);
+    }
+
+    /**
+     * @brief Destructor for the GameRecordWriter class.
+     */
+    GameRecordWriter::~GameRecordWriter(){
+        close();
+    }
+
+    /**
+     * @brief Opens a record file for appending, creating it if needed.
+     *
+     * The index is created next to a new file. For an existing file, a game left incomplete
+     * by an interrupted writer is cut off and the index is brought up to date, which only
+     * scans the games after its last entry.
+     *
+     * @param path The file path.
+     * @return true on success, false if the file cannot be opened or is not a record file.
+     */
+    bool GameRecordWriter::open(const std::string& path){
+        close();
+        std::lock_guard<std::mutex> lock(mutex);
+        file = std::fopen(path.c_str(), "a+b");
+        const std::string indexPath = GameRecordCodec::indexPath(path);
+        indexFile = std::fopen(indexPath.c_str(), "r+b");
+        if (!indexFile){
+            indexFile = std::fopen(indexPath.c_str(), "w+b");
+        }
+        if (!file || !indexFile){
+            LOG_ERROR("Cannot open record file " + path);
+            closeLocked();
+            return false;
+        }
+        if (0 == seekEnd(file)){
+            GameRecordCodec::encodeFileHeader(buffer);
+            truncateFile(indexFile, 0);
+            GameRecordCodec::encodeIndexHeader(indexBuffer);
+            fileLength = 0;
+        }
+        else if (!recoverLocked(path)){
+            closeLocked();
+            return false;
+        }
+        games = 0;
+        return true;
+    }
+
+    /**
+     * @brief Cuts an existing file after its last complete game and completes its index.
+     *
+     * @param path The file path, for messages.
+     * @return true on success, false if the file is not a record file or cannot be repaired.
+     */
+    bool GameRecordWriter::recoverLocked(const std::string& path){
+        const uint64_t recordLength = seekEnd(file);
+        uint8_t header[GameRecordCodec::FILE_HEADER_SIZE] = {};
+        const size_t read = readAt(file, 0, header, sizeof(header)) ? sizeof(header) : 0;
+        if (!GameRecordCodec::checkFileHeader(header, read)){
+            LOG_ERROR("Not a game record file " + path);
+            return false;
+        }
+
+        // Entries written for games the file does not hold are dropped; the last kept game is
+        // scanned again below, which checks that it is complete
+        const uint64_t indexLength = seekEnd(indexFile);
+        uint8_t indexHeader[GameRecordCodec::INDEX_HEADER_SIZE] = {};
+        const bool indexed = readAt(indexFile, 0, indexHeader, sizeof(indexHeader))
+            && GameRecordCodec::checkIndexHeader(indexHeader, sizeof(indexHeader));
+        uint64_t entries = indexed ? (indexLength - GameRecordCodec::INDEX_HEADER_SIZE) / GameRecordCodec::INDEX_ENTRY_SIZE : 0;
+        uint64_t resume = GameRecordCodec::FILE_HEADER_SIZE;
+        while (entries > 0){
+            uint8_t entry[GameRecordCodec::INDEX_ENTRY_SIZE];
+            entries--;
+            if (!readAt(indexFile, GameRecordCodec::INDEX_HEADER_SIZE + entries * GameRecordCodec::INDEX_ENTRY_SIZE, entry, sizeof(entry))){
+                continue;
+            }
+            const uint64_t offset = GameRecordCodec::getFixed64(entry);
+            if (offset >= GameRecordCodec::FILE_HEADER_SIZE && offset < recordLength){
+                resume = offset;
+                break;
+            }
+        }
+
+        std::vector<uint8_t> tail(static_cast<size_t>(recordLength - resume));
+        if (!readAt(file, resume, tail.data(), tail.size())){
+            LOG_ERROR("Cannot read record file " + path);
+            return false;
+        }
+        std::vector<uint64_t> offsets;
+        const uint64_t complete = resume + GameRecordCodec::scanGames(tail.data(), tail.size(), 0, resume, offsets);
+        if (complete < recordLength){
+            LOG_INFO("Dropping an incomplete game at the end of " + path);
+            if (!truncateFile(file, complete)){
+                LOG_ERROR("Cannot truncate record file " + path);
+                return false;
+            }
+        }
+
+        if (indexed){
+            truncateFile(indexFile, GameRecordCodec::INDEX_HEADER_SIZE + entries * GameRecordCodec::INDEX_ENTRY_SIZE);
+        }
+        else{
+            truncateFile(indexFile, 0);
+            GameRecordCodec::encodeIndexHeader(indexBuffer);
+        }
+        for (uint64_t offset : offsets){
+            GameRecordCodec::putFixed64(indexBuffer, offset);
+        }
+        fileLength = complete;
+        return flushLocked();
+    }
+
+    /**
+     * @brief Appends a game.
+     *
+     * @param record The game to append.
+     * @return true on success, false if the file is not open or cannot be written.
+     */
+    bool GameRecordWriter::write(const GameRecord& record){
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file){
+            LOG_ERROR("Record file not open");
+            return false;
+        }
+        GameRecordCodec::putFixed64(indexBuffer, fileLength + buffer.size());
+        GameRecordCodec::encode(record, buffer);
+        games++;
+        return buffer.size() < bufferSize || flushLocked();
+    }
+
+    /**
+     * @brief Writes the buffered games to the file.
+     *
+     * @return true on success, false if the file cannot be written.
+     */
+    bool GameRecordWriter::flush(){
+        std::lock_guard<std::mutex> lock(mutex);
+        return flushLocked();
+    }
+
+    bool GameRecordWriter::flushLocked(){
+        if (!file){
+            return false;
+        }
+        // The games go first, so the index never points past the end of the file
+        seekEnd(file);
+        const bool written = buffer.empty() || buffer.size() == std::fwrite(buffer.data(), 1, buffer.size(), file);
+        fileLength += buffer.size();
+        buffer.clear();
+        if (!written || 0 != std::fflush(file)){
+            indexBuffer.clear();
+            LOG_ERROR("Failed to write record file");
+            return false;
+        }
+        bool indexWritten = indexBuffer.empty();
+        if (!indexWritten){
+            seekEnd(indexFile);
+            indexWritten = indexBuffer.size() == std::fwrite(indexBuffer.data(), 1, indexBuffer.size(), indexFile);
+            indexBuffer.clear();
+        }
+        if (!indexWritten || 0 != std::fflush(indexFile)){
+            LOG_ERROR("Failed to write record index");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Flushes and closes the file.
+     */
+    void GameRecordWriter::close(){
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file){
+            flushLocked();
+        }
+        closeLocked();
+    }
+
+    void GameRecordWriter::closeLocked(){
+        if (file){
+            std::fclose(file);
+            file = nullptr;
+        }
+        if (indexFile){
+            std::fclose(indexFile);
+            indexFile = nullptr;
+        }
+        buffer.clear();
+        indexBuffer.clear();
+    }
+
+    /**
+     * @brief Constructor for the GameRecordReader class.
+     */
+    GameRecordReader::GameRecordReader() : data(nullptr), length(0), index(nullptr), indexLength(0), indexCount(0) {}
+
+    /**
+     * @brief Destructor for the GameRecordReader class.
+     */
+    GameRecordReader::~GameRecordReader(){
+        close();
+    }
+
+#if !defined(_WIN32)
+    namespace {
+        /**
+         * @brief Maps a whole file read-only, nullptr with a zero length if it is empty or missing.
+         */
+        const uint8_t* mapFile(const std::string& path, size_t& length, bool& exists){
+            length = 0;
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat info;
+            exists = fd >= 0 && 0 == fstat(fd, &info);
+            if (!exists){
+                if (fd >= 0){
+                    ::close(fd);
+                }
+                return nullptr;
+            }
+            void* mapping = nullptr;
+            if (info.st_size > 0){
+                mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (MAP_FAILED == mapping){
+                    mapping = nullptr;
+                }
+                else{
+                    length = static_cast<size_t>(info.st_size);
+                    madvise(mapping, length, MADV_RANDOM);
+                }
+            }
+            ::close(fd);
+            return static_cast<const uint8_t*>(mapping);
+        }
+    }
+#endif
+
+    /**
+     * @brief Maps a record file and its index.
+     *
+     * @param path The file path.
+     * @return true on success, false if the file cannot be mapped or is not a record file.
+     */
+    bool GameRecordReader::open(const std::string& path){
+        close();
+#if defined(_WIN32)
+        std::ifstream input(path, std::ios::binary);
+        if (!input){
+            LOG_ERROR("Cannot open record file " + path);
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        data = contents.data();
+        length = contents.size();
+#else
+        bool exists = false;
+        data = mapFile(path, length, exists);
+        if (!exists){
+            LOG_ERROR("Cannot open record file " + path);
+            return false;
+        }
+#endif
+        if (!GameRecordCodec::checkFileHeader(data, length)){
+            LOG_ERROR("Not a game record file " + path);
+            close();
+            return false;
+        }
+        mapIndex(GameRecordCodec::indexPath(path));
+
+        // Games written after the last index entry, the whole file if there is no index
+        size_t pos = GameRecordCodec::FILE_HEADER_SIZE;
+        if (indexCount > 0){
+            // The last indexed game is scanned again, which checks that it is complete
+            pos = static_cast<size_t>(offsetOf(indexCount - 1));
+            indexCount--;
+        }
+        GameRecordCodec::scanGames(data, length, pos, 0, tailOffsets);
+        return true;
+    }
+
+    /**
+     * @brief Maps the index of the file, keeping the entries of complete games.
+     *
+     * Entries are dropped from the end while they point past the last game the file holds,
+     * e.g. after the file was cut by hand. A missing or invalid index is ignored.
+     *
+     * @param path The path of the index.
+     */
+    void GameRecordReader::mapIndex(const std::string& path){
+#if defined(_WIN32)
+        std::ifstream input(path, std::ios::binary);
+        if (!input){
+            return;
+        }
+        indexContents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        index = indexContents.data();
+        indexLength = indexContents.size();
+#else
+        bool exists = false;
+        index = mapFile(path, indexLength, exists);
+#endif
+        if (!GameRecordCodec::checkIndexHeader(index, indexLength)){
+            return;
+        }
+        indexCount = (indexLength - GameRecordCodec::INDEX_HEADER_SIZE) / GameRecordCodec::INDEX_ENTRY_SIZE;
+        while (indexCount > 0){
+            size_t pos = static_cast<size_t>(offsetOf(indexCount - 1));
+            uint64_t bodyLength = 0;
+            if (pos >= GameRecordCodec::FILE_HEADER_SIZE && pos < length
+                && GameRecordCodec::getVarint(data, length, pos, bodyLength) && bodyLength <= length - pos){
+                break;
+            }
+            indexCount--;
+        }
+    }
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void GameRecordReader::close(){
+#if defined(_WIN32)
+        contents.clear();
+        indexContents.clear();
+#else
+        if (data){
+            munmap(const_cast<uint8_t*>(data), length);
+        }
+        if (index){
+            munmap(const_cast<uint8_t*>(index), indexLength);
+        }
+#endif
+        data = nullptr;
+        length = 0;
+        index = nullptr;
+        indexLength = 0;
+        indexCount = 0;
+        tailOffsets.clear();
+    }
+
+    /**
+     * @brief Gets the offset of the length prefix of game N.
+     *
+     * @param gameIndex The game number, less than the game count.
+     * @return The offset in the file.
+     */
+    uint64_t GameRecordReader::offsetOf(size_t gameIndex) const{
+        if (gameIndex < indexCount){
+            return GameRecordCodec::getFixed64(index + GameRecordCodec::INDEX_HEADER_SIZE + gameIndex * GameRecordCodec::INDEX_ENTRY_SIZE);
+        }
+        return tailOffsets[gameIndex - indexCount];
+    }
+
+    /**
+     * @brief Decodes game N.
+     *
+     * @param gameIndex The game number, 0 based.
+     * @param record Receives the game, its move storage is reused.
+     * @return true on success, false if the index is out of range, its entry points outside the file or the game is malformed.
+     */
+    bool GameRecordReader::readGame(size_t gameIndex, GameRecord& record) const{
+        if (gameIndex >= getGameCount()){
+            return false;
+        }
+        // A stale or corrupt index entry must not send the decoder past the end of the mapping
+        const uint64_t offset = offsetOf(gameIndex);
+        if (offset >= length){
+            return false;
+        }
+        size_t pos = static_cast<size_t>(offset);
+        uint64_t bodyLength = 0;
+        if (!GameRecordCodec::getVarint(data, length, pos, bodyLength) || bodyLength > length - pos){
+            return false;
+        }
+        return GameRecordCodec::decode(data + pos, static_cast<size_t>(bodyLength), record);
+    }
+
+    /**
+     * @brief Appends the games of the file to the list of chunks.
+     *
+     * @param file The number of this reader in the caller's list of readers.
+     * @param chunks Receives ranges of at most GameChunk::GAMES games covering the file.
+     */
+    void GameRecordReader::appendChunks(size_t file, std::vector<GameChunk>& chunks) const{
+        const size_t count = getGameCount();
+        for (size_t first = 0; first < count; first += GameChunk::GAMES){
+            chunks.push_back({ file, first, std::min(count, first + GameChunk::GAMES) });
+        }
+    }
+
+} // namespace tictactoe
@@ -0,0 +1,292 @@
+/**
+ * @file gamerecord.h
+ * @brief Header file for the binary game record format.
+ *
+ * This file contains the declaration of the GameRecord type and of the classes writing and
+ * reading files of recorded games. A file starts with an 8 byte header ("TTTR", version,
+ * 3 reserved bytes) followed by the games, each prefixed with its length as a varint:
+ *
+ *   u8 size, u8 flags (1 = times, 2 = scores, 4 = O moved first), u8 result (0 unfinished, 1 X, 2 O, 3 draw),
+ *   u8 kind and u8 level of X, then of O (kind 0 human, 1 random AI, 2 minimax AI),
+ *   varint move count, varint cell (row * size + col) per move,
+ *   [varint microseconds per move], [zigzag varint score per move]
+ *
+ * The writer keeps an index next to the file ("<file>.idx"): an 8 byte header ("TTTI",
+ * version, 3 reserved bytes) followed by the offset of every game's length prefix as a
+ * little-endian u64. Readers map the index instead of scanning the file, and only scan the
+ * games written after its last entry.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "commondef.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief One move of a recorded game.
+     */
+    struct RecordedMove{
+        CellPos pos; /**< The cell played. */
+        uint32_t timeUsec; /**< Thinking time in microseconds, 0 if not recorded. */
+        int32_t score; /**< Score of the move for the mover, 0 if not recorded. */
+    };
+
+    /**
+     * @brief One side of a recorded game.
+     */
+    struct RecordedPlayer{
+        Player_Type type = Player_Type::HUMAN; /**< Human or computer. */
+        AIType aitype = AIType::Minimax; /**< AI of a computer player. */
+        GameLevel level = GameLevel::EASY; /**< Level of a computer player. */
+    };
+
+    /**
+     * @brief A recorded game, the moves alternate from the first mover on.
+     */
+    struct GameRecord{
+        int size = DEFAULT_BOARD_SIZE; /**< Board size. */
+        RecordedPlayer players[PLAYER_COUNT]; /**< X first, then O. */
+        Symbol firstMover = Symbol::X; /**< Side of the first move, O in GUI games the human opens as O. */
+        bool finished = false; /**< The game was played to the end. */
+        Symbol winner = Symbol::None; /**< Winner of a finished game, Symbol::None for a draw. */
+        bool hasTimes = false; /**< The moves carry thinking times. */
+        bool hasScores = false; /**< The moves carry scores. */
+        std::vector<RecordedMove> moves; /**< The moves in the order they were played. */
+    };
+
+    /**
+     * @brief Helpers encoding and decoding single game records.
+     */
+    class GameRecordCodec{
+    public:
+        static constexpr uint8_t VERSION = 1;
+        static constexpr size_t FILE_HEADER_SIZE = 8;
+        static constexpr size_t INDEX_HEADER_SIZE = 8;
+        static constexpr size_t INDEX_ENTRY_SIZE = 8;
+
+        /**
+         * @brief Appends the encoding of a game, length prefix included, to the buffer.
+         */
+        static void encode(const GameRecord& record, std::vector<uint8_t>& buffer);
+
+        /**
+         * @brief Decodes the body of a game, without its length prefix.
+         */
+        static bool decode(const uint8_t* data, size_t length, GameRecord& record);
+
+        /**
+         * @brief Writes the file header to the buffer.
+         */
+        static void encodeFileHeader(std::vector<uint8_t>& buffer);
+
+        /**
+         * @brief Checks the file header.
+         */
+        static bool checkFileHeader(const uint8_t* data, size_t length);
+
+        /**
+         * @brief Gets the path of the index of a record file.
+         */
+        static std::string indexPath(const std::string& path);
+
+        /**
+         * @brief Writes the index header to the buffer.
+         */
+        static void encodeIndexHeader(std::vector<uint8_t>& buffer);
+
+        /**
+         * @brief Checks the index header.
+         */
+        static bool checkIndexHeader(const uint8_t* data, size_t length);
+
+        /**
+         * @brief Finds the complete games from a position on, appending their offsets.
+         */
+        static size_t scanGames(const uint8_t* data, size_t length, size_t pos, uint64_t base, std::vector<uint64_t>& offsets);
+
+        /**
+         * @brief Appends a little-endian u64.
+         */
+        static void putFixed64(std::vector<uint8_t>& buffer, uint64_t value);
+
+        /**
+         * @brief Reads a little-endian u64.
+         */
+        static uint64_t getFixed64(const uint8_t* data);
+
+        /**
+         * @brief Appends an unsigned LEB128 varint.
+         */
+        static void putVarint(std::vector<uint8_t>& buffer, uint64_t value);
+
+        /**
+         * @brief Reads an unsigned LEB128 varint, advancing pos.
+         */
+        static bool getVarint(const uint8_t* data, size_t length, size_t& pos, uint64_t& value);
+    };
+
+    /**
+     * @brief The GameRecordWriter class appends games to a record file.
+     *
+     * Games are encoded into a memory buffer that is written out when it fills up, on flush
+     * and on destruction, followed by their index entries. The writer may be shared by several
+     * threads. Opening an existing file drops a game left incomplete by an interrupted writer,
+     * so new games are appended after the last complete one.
+     */
+    class GameRecordWriter{
+    public:
+        static constexpr size_t DEFAULT_BUFFER_SIZE = size_t(1) << 16;
+
+        /**
+         * @brief Constructs a writer, call open before writing.
+         */
+        explicit GameRecordWriter(size_t bufferSize_i = DEFAULT_BUFFER_SIZE);
+
+        /**
+         * @brief Flushes and closes the file.
+         */
+        ~GameRecordWriter();
+
+        GameRecordWriter(const GameRecordWriter&) = delete;
+        GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+        /**
+         * @brief Opens a record file for appending, creating it if needed.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Appends a game.
+         */
+        bool write(const GameRecord& record);
+
+        /**
+         * @brief Writes the buffered games to the file.
+         */
+        bool flush();
+
+        /**
+         * @brief Flushes and closes the file.
+         */
+        void close();
+
+        /**
+         * @brief Gets the number of games written since the file was opened.
+         */
+        inline uint64_t getGameCount() const { return games; }
+
+    private:
+        bool flushLocked();
+
+        bool recoverLocked(const std::string& path);
+
+        void closeLocked();
+
+        std::mutex mutex; /**< Serializes writers sharing the file. */
+        std::FILE* file; /**< The open file, nullptr if closed. */
+        std::FILE* indexFile; /**< The open index, nullptr if closed. */
+        std::vector<uint8_t> buffer; /**< Encoded games not yet written. */
+        std::vector<uint8_t> indexBuffer; /**< Index entries of the buffered games. */
+        size_t bufferSize; /**< Buffer size that triggers a write. */
+        uint64_t fileLength; /**< Bytes written to the file, the offset of the first buffered byte. */
+        uint64_t games; /**< Games written since the file was opened. */
+    };
+
+    /**
+     * @brief A range of games of one of several record files, the unit of work of the tools
+     * that read the files with several threads.
+     */
+    struct GameChunk{
+        static constexpr size_t GAMES = 4096; /**< Games in a chunk, the last chunk of a file may hold fewer. */
+
+        size_t file; /**< Number of the file in the caller's list of readers. */
+        size_t first; /**< First game of the range. */
+        size_t last; /**< One past the last game of the range. */
+    };
+
+    /**
+     * @brief The GameRecordReader class gives random access to the games of a record file.
+     *
+     * The file and its index are mapped into memory; reading game N decodes it straight from
+     * the mapping. Only games written after the last index entry are found by scanning, and a
+     * file without an index is scanned in full. A truncated last game, left by an interrupted
+     * writer, is ignored.
+     */
+    class GameRecordReader{
+    public:
+        /**
+         * @brief Constructs a reader, call open before reading.
+         */
+        GameRecordReader();
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~GameRecordReader();
+
+        GameRecordReader(const GameRecordReader&) = delete;
+        GameRecordReader& operator=(const GameRecordReader&) = delete;
+
+        /**
+         * @brief Maps a record file and its index.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void close();
+
+        /**
+         * @brief Gets the number of complete games in the file.
+         */
+        inline size_t getGameCount() const { return indexCount + tailOffsets.size(); }
+
+        /**
+         * @brief Decodes game N, reusing the storage of the given record.
+         */
+        bool readGame(size_t gameIndex, GameRecord& record) const;
+
+        /**
+         * @brief Appends the games of the file to the list of chunks.
+         */
+        void appendChunks(size_t file, std::vector<GameChunk>& chunks) const;
+
+    private:
+        /**
+         * @brief Maps the index of the file, keeping the entries of complete games.
+         */
+        void mapIndex(const std::string& path);
+
+        /**
+         * @brief Gets the offset of the length prefix of game N.
+         */
+        uint64_t offsetOf(size_t index) const;
+
+        const uint8_t* data; /**< Start of the mapped file. */
+        size_t length; /**< Length of the mapped file. */
+        const uint8_t* index; /**< Start of the mapped index, nullptr if there is none. */
+        size_t indexLength; /**< Length of the mapped index. */
+        size_t indexCount; /**< Games found through the index. */
+        std::vector<uint64_t> tailOffsets; /**< Offsets of the games after the last index entry. */
+#if defined(_WIN32)
+        std::vector<uint8_t> contents; /**< The file, read into memory where mmap is unavailable. */
+        std::vector<uint8_t> indexContents; /**< The index, read into memory where mmap is unavailable. */
+#endif
+    };
+
+} // namespace tictactoe
+
+#endif // GAMERECORD_H
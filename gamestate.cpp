@@ -0,0 +1,159 @@
+/**
+ * @file gamestate.cpp
+ * @brief Implementation file for the GameState class.
+ *
+ * This file contains the implementation of the GameState class.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include "gamestate.h"
+
+namespace tictactoe{
+
+    namespace {
+
+        /**
+         * @brief The bit masks of all rows, columns and both diagonals of one board size.
+         */
+        struct LineMasks{
+            uint64_t lines[2 * GameState::MAX_SIZE + 2] = {};
+            int count = 0;
+        };
+
+        LineMasks buildMasks(int size){
+            LineMasks masks;
+            uint64_t diagonal = 0;
+            uint64_t antiDiagonal = 0;
+            for (int i = 0; i < size; i++){
+                uint64_t row = 0;
+                uint64_t col = 0;
+                for (int j = 0; j < size; j++){
+                    row |= uint64_t(1) << (i * size + j);
+                    col |= uint64_t(1) << (j * size + i);
+                }
+                masks.lines[masks.count++] = row;
+                masks.lines[masks.count++] = col;
+                diagonal |= uint64_t(1) << (i * size + i);
+                antiDiagonal |= uint64_t(1) << (i * size + size - 1 - i);
+            }
+            masks.lines[masks.count++] = diagonal;
+            masks.lines[masks.count++] = antiDiagonal;
+            return masks;
+        }
+
+        /**
+         * @brief Gets the line masks of a board size, built once for all sizes.
+         */
+        const LineMasks& lineMasks(int size){
+            static const struct Table{
+                LineMasks sizes[GameState::MAX_SIZE + 1];
+                Table(){
+                    for (int size = 1; size <= GameState::MAX_SIZE; size++){
+                        sizes[size] = buildMasks(size);
+                    }
+                }
+            } table;
+            return table.sizes[size];
+        }
+
+    } // namespace
+
+    /**
+     * @brief Starts a new game.
+     *
+     * @param size_i The board size, 2 to MAX_SIZE.
+     * @param human_i The symbol played by the human.
+     * @param aitype_i The AI type of the computer.
+     * @param level_i The level of the computer.
+     * @return true if the game was started, false if the size is not supported.
+     */
+    bool GameState::startNewGame(int size_i, Symbol human_i, AIType aitype_i, GameLevel level_i){
+        if (size_i < 2 || size_i > MAX_SIZE){
+            LOG_ERROR("Unsupported board size");
+            return false;
+        }
+        cells[0] = 0;
+        cells[1] = 0;
+        size = static_cast<uint8_t>(size_i);
+        moveCount = 0;
+        human = static_cast<uint8_t>(human_i);
+        aitype = static_cast<uint8_t>(aitype_i);
+        level = static_cast<uint8_t>(std::min(std::max(static_cast<int>(level_i), 0), 255));
+        return true;
+    }
+
+    /**
+     * @brief Places the symbol of the side to move at the given position.
+     *
+     * @param pos The position to place the symbol.
+     * @return true if the move was made, false if the position is off the board or taken.
+     */
+    bool GameState::play(const CellPos& pos){
+        if (!isEmpty(pos)){
+            return false;
+        }
+        cells[moveCount & 1] |= uint64_t(1) << (pos.y * size + pos.x);
+        moveCount++;
+        return true;
+    }
+
+    /**
+     * @brief Checks if the position is on the board and empty.
+     *
+     * @param pos The position to check.
+     * @return true if a symbol can be placed there, false otherwise.
+     */
+    bool GameState::isEmpty(const CellPos& pos) const{
+        if (pos.x < 0 || pos.x >= size || pos.y < 0 || pos.y >= size){
+            return false;
+        }
+        const uint64_t bit = uint64_t(1) << (pos.y * size + pos.x);
+        return 0 == ((cells[0] | cells[1]) & bit);
+    }
+
+    /**
+     * @brief Checks for a full line of one symbol.
+     *
+     * @return The symbol owning a full row, column or diagonal, Symbol::None if there is none.
+     */
+    Symbol GameState::checkForWinner() const{
+        if (0 == size){
+            return Symbol::None;
+        }
+        const LineMasks& masks = lineMasks(size);
+        for (int i = 0; i < masks.count; i++){
+            const uint64_t line = masks.lines[i];
+            if ((cells[0] & line) == line){
+                return Symbol::X;
+            }
+            if ((cells[1] & line) == line){
+                return Symbol::O;
+            }
+        }
+        return Symbol::None;
+    }
+
+    /**
+     * @brief Writes the position to a board, which is resized as needed.
+     *
+     * @param board The board to overwrite.
+     */
+    void GameState::toBoard(Board& board) const{
+        board.startNewGame(size);
+        for (int row = 0; row < size; row++){
+            for (int col = 0; col < size; col++){
+                const uint64_t bit = uint64_t(1) << (row * size + col);
+                if (cells[0] & bit){
+                    board.makeMove(CellPos{ col, row }, Symbol::X);
+                }
+                else if (cells[1] & bit){
+                    board.makeMove(CellPos{ col, row }, Symbol::O);
+                }
+            }
+        }
+    }
+
+} // namespace tictactoe
@@ -0,0 +1,118 @@
+/**
+ * @file gamestate.h
+ * @brief Header file for the GameState class.
+ *
+ * This file contains the declaration of the GameState class, a compact value type holding a
+ * whole game, meant for storing large numbers of idle games in flat arrays.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <cstdint>
+#include <type_traits>
+#include "board.h"
+#include "commondef.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief The GameState class is a trivially copyable snapshot of a game.
+     *
+     * The cells are packed into one bitboard per symbol, bit row * size + col, so boards up to
+     * MAX_SIZE x MAX_SIZE fit. X always moves first, the side to move follows from the move
+     * count. The state holds no AI; moves for the computer are found by an AI shared by many
+     * games, working on a Board built with toBoard.
+     */
+    class GameState{
+    public:
+        /**
+         * @brief Largest board size a state can hold.
+         */
+        static constexpr int MAX_SIZE = 8;
+
+        /**
+         * @brief Starts a new game, returns false if the size is not supported.
+         */
+        bool startNewGame(int size_i, Symbol human_i, AIType aitype_i, GameLevel level_i);
+
+        /**
+         * @brief Places the symbol of the side to move at the given position.
+         */
+        bool play(const CellPos& pos);
+
+        /**
+         * @brief Checks if the position is on the board and empty.
+         */
+        bool isEmpty(const CellPos& pos) const;
+
+        /**
+         * @brief Checks for a full line of one symbol.
+         */
+        Symbol checkForWinner() const;
+
+        /**
+         * @brief Checks if every cell is taken.
+         */
+        inline bool isBoardFull() const { return moveCount == size * size; }
+
+        /**
+         * @brief Writes the position to a board, which is resized as needed.
+         */
+        void toBoard(Board& board) const;
+
+        /**
+         * @brief Gets the board size.
+         */
+        inline int getSize() const { return size; }
+
+        /**
+         * @brief Gets the number of moves played.
+         */
+        inline int getMoveCount() const { return moveCount; }
+
+        /**
+         * @brief Gets the symbol of the side to move.
+         */
+        inline Symbol getSideToMove() const { return (moveCount & 1) ? Symbol::O : Symbol::X; }
+
+        /**
+         * @brief Gets the symbol played by the human.
+         */
+        inline Symbol getHuman() const { return static_cast<Symbol>(human); }
+
+        /**
+         * @brief Gets the symbol played by the computer.
+         */
+        inline Symbol getComputer() const { return Symbol::X == getHuman() ? Symbol::O : Symbol::X; }
+
+        /**
+         * @brief Gets the AI type of the computer.
+         */
+        inline AIType getAIType() const { return static_cast<AIType>(aitype); }
+
+        /**
+         * @brief Gets the level of the computer.
+         */
+        inline GameLevel getLevel() const { return static_cast<GameLevel>(level); }
+
+    private:
+        uint64_t cells[2] = { 0, 0 }; /**< Occupied cells of X and of O. */
+        uint8_t size = 0; /**< Board size, 0 if no game was started. */
+        uint8_t moveCount = 0; /**< Number of moves played. */
+        uint8_t human = 0; /**< Symbol played by the human. */
+        uint8_t aitype = 0; /**< AI type of the computer. */
+        uint8_t level = 0; /**< Level of the computer, capped at 255. */
+    };
+
+    static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be trivially copyable");
+    static_assert(sizeof(GameState) <= 24, "GameState must stay compact");
+
+} // namespace tictactoe
+
+#endif // GAMESTATE_H
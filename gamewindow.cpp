@@ -10,9 +10,14 @@
  */
 
 #include <QButtonGroup>
+#include <QStatusBar>
 #include <QtConcurrent/QtConcurrent>
 #include "gamewindow.h"
 #include "ui_gamewindow.h"
+#include "aifactory.h"
+#include "qtadapter.h"
+#include "searchstepper.h"
+#include "trace.h"
 
 /**
 * @brief Constructor for the GameWindow class.
@@ -24,7 +29,11 @@ GameWindow::GameWindow(QWidget* parent)
     , ui(new Ui::GameWindow)
     , game(new tictactoe::TicTacToe)
     , symbol(tictactoe::Symbol::O)
-    , size(tictactoe::DEFAULT_BOARD_SIZE) {
+    , size(tictactoe::DEFAULT_BOARD_SIZE)
+    , stepper(new SearchStepper(this))
+    , analyst(tictactoe::AIFactory::createAI(tictactoe::AIType::Minimax))
+    , analysisGeneration(0)
+    , analysisStop(false) {
 
     try {
         ui->setupUi(this);
@@ -36,18 +45,22 @@ GameWindow::GameWindow(QWidget* parent)
         // Setup symbol selection radio btns
         setupSymbolSelection();
 
-        // Set up grid layout
-        buttonLayout = ui->gridLayout;
-        createButtons();
+        // Set up board view, clicks are mapped to cells by the view itself
+        connect(ui->boardView, &BoardView::cellClicked, this, &GameWindow::onCellClicked);
+        ui->boardView->setBoardSize(size);
         ui->Grid_size->setValue(size);
 
+        // Cooperative search results
+        connect(stepper, &SearchStepper::finished, this, &GameWindow::onSearchFinished);
+        connect(stepper, &SearchStepper::sliceFinished, this, &GameWindow::onSearchSlice);
+
         // Set board appearance
         toggleBoard(false, true);
-        ui->Result_text->setText(tictactoe::CLICK_START);
+        ui->Result_text->setText(tictactoe::toQString(tictactoe::CLICK_START));
     }
     catch (const std::exception& e) {
         // Log the exception message
-        tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
+        LOG_ERROR(e.what());
     }
 }
 
@@ -55,7 +68,18 @@ GameWindow::GameWindow(QWidget* parent)
  * @brief Destructor for the GameWindow class.
  */
 GameWindow::~GameWindow() {
+	// The analysis posts results to this window, stop it and wait until it returned
+	++analysisGeneration;
+	analysisStop = true;
+	analysisFuture.waitForFinished();
+	// The computer's move uses the game, its queued update is dropped with the window
+	computerFuture.waitForFinished();
+
 	if (ui) {
+		// A game abandoned by closing the window is recorded unless the computer is still moving
+		if (game && ui->boardView->isEnabled()) {
+			recordGame();
+		}
 		delete ui;
 		ui = nullptr;
 	}
@@ -65,77 +89,36 @@ GameWindow::~GameWindow() {
 	}
 
 	// Set other pointers to null after deletion
-	buttonLayout = nullptr;
 	buttonGroup = nullptr;
 }
 
 /**
- * @brief Creates buttons for the game board.
+ * @brief Appends every game played in the window to a game record file.
+ *
+ * Finished games are written when they end, abandoned ones when the next game starts, the
+ * grid size changes or the window closes.
+ *
+ * @param path The record file, created if needed.
+ * @return True if the file is open for recording, false otherwise.
  */
-void GameWindow::createButtons() {
-    try{
-		// Remove all existing buttons
-		QLayoutItem* item = nullptr;
-		while ((item = buttonLayout->takeAt(0)) != nullptr) {
-			if (item->widget()) {
-				delete item->widget();
-			}
-			delete item;
-            item = nullptr;
-		}
-
-		// Get the size of the buttonLayout
-		QSize layoutSize = buttonLayout->geometry().size();
-
-        // Calculate the button width and height based on the layout size
-        int buttonWidth = tictactoe::LAYOUT_WIDTH / size;
-        int buttonHeight = tictactoe::LAYOUT_HEIGHT / size;
-
-		for (int row = 0; row < size; ++row) {
-			for (int col = 0; col < size; ++col) {
-				QPushButton* button = new QPushButton();
-                // setting button name based on pos
-				button->setObjectName(QString("button_%1_%2").arg(row).arg(col));
-				button->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-				button->setFixedSize(buttonWidth, buttonHeight);
-                // all buttons are connected to same slot
-				connect(button, &QPushButton::clicked, this, &GameWindow::onButtonClick);
-				buttonLayout->addWidget(button, row, col);
-
-                // setting font based on button size
-				int fontSize = qMin(buttonWidth, buttonHeight) / size;
-				QFont font = button->font();
-				font.setPointSize(fontSize);
-				button->setFont(font);
-			}
-		}
+bool GameWindow::recordGames(const QString& path)
+{
+    auto writer = std::make_unique<tictactoe::GameRecordWriter>();
+    if (!writer->open(path.toStdString())) {
+        return false;
     }
-    catch (const std::exception& e) {
-		// Log the exception message
-		tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
-	}
+    recorder = std::move(writer);
+    return true;
 }
 
 /**
- * @brief Slot for handling button clicks.
+ * @brief Slot for handling board cell clicks.
+ *
+ * @param row The row index of the clicked cell.
+ * @param col The column index of the clicked cell.
  */
-void GameWindow::onButtonClick() {
-    try{
-		QPushButton* button = qobject_cast<QPushButton*>(sender());
-		if (!button) return;
-
-		QString name = button->objectName();
-
-        // getting the sender buttons row and col values
-		// hard coded based on the name give "button_%1_%2"
-		int row = name.mid(7, 1).toInt();
-		int col = name.mid(9, 1).toInt();
-		updateUI(row, col);
-    }
-	catch (const std::exception& e) {
-		// Log the exception message
-		tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
-	}
+void GameWindow::onCellClicked(int row, int col) {
+    updateUI(row, col);
 }
 
 /**
@@ -145,14 +128,16 @@ void GameWindow::onButtonClick() {
  * @param col The column index of the move.
  */
 void GameWindow::updateUI(int row, int col) {
+    TRACE_SCOPE("GameWindow::updateUI");
     try {
         // Player's Move
-        if (!game->makeMove(QPoint(col, row), tictactoe::Player_Type::HUMAN)) {
+        if (!game->makeMove(tictactoe::CellPos{ col, row }, tictactoe::Player_Type::HUMAN)) {
             // Invalid move, handle error here if needed
-            ui->Result_text->setText(tictactoe::INVALID_MOVE);
+            ui->Result_text->setText(tictactoe::toQString(tictactoe::INVALID_MOVE));
             return;
         }
         updateButton(row, col);
+        stopAnalysis();
 
         // Check for the end of the game
         if (handleGameEnd()) {
@@ -163,36 +148,48 @@ void GameWindow::updateUI(int row, int col) {
         }
 
         // Computer's Move
-        // disabling all buttons until computer finished thinking
+        // disabling the board until computer finished thinking
         enableUI(false);
-        // starting computer movement in another thread
-        QtConcurrent::run([this]() {
-            this->computerMove();
+        traceMoveId++;
+#ifdef TICTACTOE_COOPERATIVE_SEARCH
+        // thinking in short time slices on the GUI thread, onSearchFinished makes the move
+        TRACE_FLOW_START("to UI", traceMoveId);
+        stepper->start(game->createComputerSearch());
+#else
+        // starting computer movement in another thread, the board is updated
+        // back on the GUI thread once the move is made
+        TRACE_FLOW_START("to engine", traceMoveId);
+        TRACE_SCOPE("dispatch");
+        computerFuture = QtConcurrent::run([this]() {
+            tictactoe::Tracer::getInstance().setThreadName("engine worker");
+            {
+                TRACE_SCOPE("computer move");
+                TRACE_FLOW_END("to engine", traceMoveId);
+                game->makeMove(tictactoe::CellPos{ -1, -1 }, tictactoe::Player_Type::COMPUTER);
+                TRACE_FLOW_START("to UI", traceMoveId);
+            }
+            QMetaObject::invokeMethod(this, [this]() { computerMove(game->getComputerStats()); }, Qt::QueuedConnection);
             });
+#endif
     }
 	catch (const std::exception& e) {
 		// Log the exception message
-		tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
+		LOG_ERROR(e.what());
 	}
 }
 
 
-// Update button text after a move
+// Update cell text after a move
 /**
- * @brief Update the text of the button at the specified row and column after a move.
+ * @brief Update the text of the cell at the specified row and column after a move.
  *
- * @param row The row index of the button.
- * @param col The column index of the button.
+ * @param row The row index of the cell.
+ * @param col The column index of the cell.
  */
 void GameWindow::updateButton(int row, int col)
 {
-    // Get the button at the specified position
-    QLayoutItem* item = buttonLayout->itemAtPosition(row, col);
-    QPushButton* button = qobject_cast<QPushButton*>(item->widget());
-    if (button) {
-        // Set the text of the button to the current player's symbol
-        button->setText(game->getCurrentPlayerSymbol());
-    }
+    // Set the text of the cell to the current player's symbol
+    ui->boardView->setCell(row, col, tictactoe::toQString(game->getCurrentPlayerSymbol()));
 }
 
 // Handle end of the game
@@ -207,11 +204,13 @@ bool GameWindow::handleGameEnd()
     if (tictactoe::Player_Type::UNKNOWN != winner) {
         displayWinner(winner);
         toggleBoard(false, false);  // Disable board
+        recordGame();
         return true;
     }
     else if (game->isBoardFull()) {
-        ui->Result_text->setText(tictactoe::TIE);
+        ui->Result_text->setText(tictactoe::toQString(tictactoe::TIE));
         toggleBoard(false, false);
+        recordGame();
         return true;
     }
     else {
@@ -219,16 +218,22 @@ bool GameWindow::handleGameEnd()
     }
 }
 
-// Perform the computer's move
+// Show the computer's move
 /**
- * @brief Perform the computer's move.
+ * @brief Update the board after the computer's move.
+ *
+ * Runs on the GUI thread once the worker thread has made the move. The statistics of the
+ * search replace the thinking message in the status bar.
+ *
+ * @param stats The statistics of the search that found the move.
  */
-void GameWindow::computerMove()
+void GameWindow::computerMove(const tictactoe::SearchStats& stats)
 {
-    // Make the computer's move
-    game->makeMove(QPoint(-1, -1), tictactoe::Player_Type::COMPUTER);
-    // Update the corresponding button
-    updateButton(game->getCurrentPosComputer().y(), game->getCurrentPosComputer().x());
+    TRACE_SCOPE("GameWindow::computerMove");
+    TRACE_FLOW_END("to UI", traceMoveId);
+    statusBar()->showMessage(QString::fromStdString(stats.toString()));
+    // Update the corresponding cell
+    updateButton(game->getCurrentPosComputer().y, game->getCurrentPosComputer().x);
     // Enable the UI
     enableUI(true);
     // Check for the end of the game
@@ -237,7 +242,36 @@ void GameWindow::computerMove()
         ui->Grid_size->setEnabled(true);
         enableSelectSymbol(true);
     }
+    else {
+        startAnalysis();
+    }
+}
+// Make the move found by the cooperative search
+/**
+ * @brief Make the computer's move found by the cooperative search.
+ *
+ * @param move The move found by the search.
+ */
+void GameWindow::onSearchFinished(QPoint move)
+{
+    game->applyComputerMove(tictactoe::toCellPos(move));
+    computerMove(stepper->getLastStats());
+}
+
+// Show the throughput of the cooperative search
+/**
+ * @brief Show the throughput of the last time slice of the cooperative search.
+ *
+ * @param nodes The number of nodes searched in the slice.
+ * @param elapsedNsec The duration of the slice in nanoseconds.
+ */
+void GameWindow::onSearchSlice(quint64 nodes, qint64 elapsedNsec)
+{
+    const qint64 nodesPerSec = elapsedNsec > 0 ? static_cast<qint64>(nodes * 1000000000ULL / elapsedNsec) : 0;
+    statusBar()->showMessage(QString("%1 nodes in %2 us (%3 nodes/s)")
+        .arg(nodes).arg(elapsedNsec / 1000).arg(nodesPerSec));
 }
+
 // Display the winner of the game
 /**
  * @brief Display the winner of the game.
@@ -247,42 +281,31 @@ void GameWindow::computerMove()
 void GameWindow::displayWinner(tictactoe::Player_Type winner)
 {
     if (tictactoe::Player_Type::HUMAN == winner) {
-        ui->Result_text->setText(tictactoe::PLAYER_WON);
+        ui->Result_text->setText(tictactoe::toQString(tictactoe::PLAYER_WON));
     }
     else{
-        ui->Result_text->setText(tictactoe::PLAYER_LOST);
+        ui->Result_text->setText(tictactoe::toQString(tictactoe::PLAYER_LOST));
     }
 }
 
-// Toggle the board's buttons
+// Toggle the board
 /**
- * @brief Toggle the state of the board's buttons.
+ * @brief Toggle the state of the board.
  *
- * @param enable True to enable the buttons, false to disable.
- * @param resetText True to reset the text of the buttons, false otherwise.
+ * @param enable True to enable the board, false to disable.
+ * @param resetText True to reset the text of the cells, false otherwise.
  */
 void GameWindow::toggleBoard(bool enable, bool resetText)
 {
     try {
-        // Iterate over buttons in the layout
-        for (int row = 0; row < size; ++row) {
-            for (int col = 0; col < size; ++col) {
-                QWidget* widget = buttonLayout->itemAtPosition(row, col)->widget();
-                if (widget && widget->isWidgetType()) {
-                    QPushButton* button = qobject_cast<QPushButton*>(widget);
-                    if (button) {
-                        button->setEnabled(enable);
-                        if (resetText) {
-                            button->setText("");
-                        }
-                    }
-                }
-            }
+        ui->boardView->setEnabled(enable);
+        if (resetText) {
+            ui->boardView->clearCells();
         }
     }
 	catch (const std::exception& e) {
 		// Log the exception message
-		tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
+		LOG_ERROR(e.what());
 	}
 }
 
@@ -296,15 +319,18 @@ void GameWindow::Restartgame(QString msg)
 {
     try {
         ui->Result_text->setText(msg);
+        recordGame();
         // always using minimax ai, in future need a ui modification to change AI
         game->startNewGame(symbol, tictactoe::AIType::Minimax, size);
+        gameRecorded = false;
         toggleBoard(true, true);
+        startAnalysis();
         enableSelectSymbol(false);
         ui->Grid_size->setEnabled(false);
     }
 	catch (const std::exception& e) {
 		// Log the exception message
-		tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
+		LOG_ERROR(e.what());
 	}
 }
 
@@ -314,7 +340,7 @@ void GameWindow::Restartgame(QString msg)
  */
 void GameWindow::on_Start_button_clicked()
 {
-    Restartgame(tictactoe::CLICK_CELL);
+    Restartgame(tictactoe::toQString(tictactoe::CLICK_CELL));
 }
 
 // Enable or disable the symbol selection
@@ -356,9 +382,11 @@ void GameWindow::on_radioButton_2_clicked()
 void GameWindow::on_Grid_size_valueChanged(int arg1)
 {
     size = arg1;
-    createButtons();
+    stopAnalysis();
+    recordGame();
+    ui->boardView->setBoardSize(size);
     toggleBoard(false, true);
-    ui->Result_text->setText(tictactoe::CLICK_START);
+    ui->Result_text->setText(tictactoe::toQString(tictactoe::CLICK_START));
 }
 
 // Handle the game level value change event
@@ -373,7 +401,20 @@ void GameWindow::on_Game_level_valueChanged(int arg1)
         game->setGameLevel(static_cast<tictactoe::GameLevel>(arg1));
     }
     else{
-		tictactoe::Logger::getInstance().logError("invalid game ptr", LOG_LOCATION);
+		LOG_ERROR("invalid game ptr");
+	}
+    if (analyst) {
+        // The analyst is read by the analysis thread, so stop it before changing the level
+        const bool humanToMove = ui->boardView->isEnabled();
+        stopAnalysis();
+        analysisFuture.waitForFinished();
+        analyst->setLevel(static_cast<tictactoe::GameLevel>(arg1));
+        if (humanToMove) {
+            startAnalysis();
+        }
+    }
+    else{
+		LOG_ERROR("invalid analyst ptr");
 	}
 }
 
@@ -390,10 +431,10 @@ void GameWindow::enableUI(bool enable)
     ui->Start_button->setEnabled(enable);
     ui->Result_text->setEnabled(enable);
     if (!enable){
-        ui->Result_text->setText(tictactoe::PC_CALC);
+        ui->Result_text->setText(tictactoe::toQString(tictactoe::PC_CALC));
     }
     else{
-        ui->Result_text->setText(tictactoe::CLICK_CELL);
+        ui->Result_text->setText(tictactoe::toQString(tictactoe::CLICK_CELL));
     }
 }
 
@@ -416,7 +457,90 @@ void GameWindow::setupSymbolSelection()
     }
     catch (const std::exception& e) {
         // Log the exception message
-        tictactoe::Logger::getInstance().logError(e.what(), LOG_LOCATION);
+        LOG_ERROR(e.what());
+    }
+}
+
+// Record the current game
+/**
+ * @brief Write the current game to the record file, once per game.
+ *
+ * Games without a move are not recorded.
+ */
+void GameWindow::recordGame()
+{
+    if (recorder && !gameRecorded && !game->getMoveHistory().empty()) {
+        recorder->write(game->getRecord());
+        recorder->flush();
+    }
+    gameRecorded = true;
+}
+
+// Start the background analysis
+/**
+ * @brief Start scoring every move of the human player in the background.
+ *
+ * The analysis works on a copy of the board and streams its scores back to the GUI thread,
+ * where they are shown as a heatmap that is refined as the search deepens.
+ */
+void GameWindow::startAnalysis()
+{
+#ifdef TICTACTOE_COOPERATIVE_SEARCH
+    // no background thread in cooperative builds
+#else
+    if (!analyst) {
+        return;
     }
+    stopAnalysis();
+    // The analyst is reused, so the previous analysis has to return first, which the stop
+    // flag makes it do within a node
+    analysisFuture.waitForFinished();
+    analysisStop = false;
+
+    const int generation = analysisGeneration.load();
+    const tictactoe::Board board = game->getBoard();
+    const tictactoe::Symbol side = symbol;
+    const tictactoe::GameAI* ai = analyst.get();
+    analysisFuture = QtConcurrent::run([this, ai, board, side, generation]() {
+        ai->analyze(board, side, [this, generation](const std::vector<tictactoe::MoveScore>& scores) {
+            if (generation != analysisGeneration.load()) {
+                return false; // Position changed, stop analysing
+            }
+            QMetaObject::invokeMethod(this, [this, generation, scores]() {
+                showAnalysis(generation, scores);
+                }, Qt::QueuedConnection);
+            return true;
+            }, &analysisStop);
+        });
+#endif
+}
+
+// Stop the background analysis
+/**
+ * @brief Stop the background analysis and remove the heatmap from the board.
+ */
+void GameWindow::stopAnalysis()
+{
+    ++analysisGeneration;
+    analysisStop = true;
+    ui->boardView->clearHints();
 }
 
+// Show the analysis results
+/**
+ * @brief Show intermediate analysis results as a heatmap on the board.
+ *
+ * @param generation The analysis the results belong to, stale results are dropped.
+ * @param scores The scores of the human player's moves.
+ */
+void GameWindow::showAnalysis(int generation, const std::vector<tictactoe::MoveScore>& scores)
+{
+    if (generation != analysisGeneration.load()) {
+        return;
+    }
+    for (const tictactoe::MoveScore& moveScore : scores) {
+        if (moveScore.depth >= 0) {
+            ui->boardView->setCellHint(moveScore.move.y, moveScore.move.x, moveScore.score);
+        }
+    }
+}
@@ -15,12 +15,18 @@
 #define GAMEWINDOW_H
 
 #include <QMainWindow>
-#include <QPushButton>
-#include <QGridLayout>
+#include <QFuture>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include "tictactoe.h"
+#include "gameai.h"
+
+class SearchStepper;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class GameWindow; }
+class QButtonGroup;
 QT_END_NAMESPACE
 
 /**
@@ -40,11 +46,16 @@ public:
      */
     ~GameWindow();
 
+    /**
+     * @brief Appends every game played in the window to a game record file.
+     */
+    bool recordGames(const QString& path);
+
 private slots:
     /**
-     * @brief Slot function called when a game button is clicked.
+     * @brief Slot function called when a board cell is clicked.
      */
-    void onButtonClick();
+    void onCellClicked(int row, int col);
 
     /**
      * @brief Slot function called when the start button is clicked.
@@ -71,19 +82,24 @@ private slots:
      */
     void on_Game_level_valueChanged(int arg1);
 
-private:
     /**
-     * @brief Creates the buttons for the game board.
+     * @brief Slot function called when the cooperative search found the computer's move.
      */
-    void createButtons();
+    void onSearchFinished(QPoint move);
 
+    /**
+     * @brief Slot function called after every time slice of the cooperative search.
+     */
+    void onSearchSlice(quint64 nodes, qint64 elapsedNsec);
+
+private:
     /**
      * @brief Updates the user interface after a move is made.
      */
     void updateUI(int row, int col);
 
     /**
-     * @brief Toggles the enable/disable state of the game board buttons.
+     * @brief Toggles the enable/disable state of the game board.
      */
     void toggleBoard(bool enable, bool resetText);
 
@@ -93,9 +109,9 @@ private:
     void displayWinner(tictactoe::Player_Type winner);
 
     /**
-     * @brief Initiates the computer's move.
+     * @brief Updates the board after the computer's move.
      */
-    void computerMove();
+    void computerMove(const tictactoe::SearchStats& stats);
 
     /**
      * @brief Handles the end of the game.
@@ -103,7 +119,7 @@ private:
     bool handleGameEnd();
 
     /**
-     * @brief Updates the text of a button after a move.
+     * @brief Updates the text of a board cell after a move.
      */
     void updateButton(int row, int col);
 
@@ -127,13 +143,41 @@ private:
      */
     void setupSymbolSelection();
 
+    /**
+     * @brief Writes the current game to the record file once.
+     */
+    void recordGame();
+
+    /**
+     * @brief Starts analysing the human player's moves in the background.
+     */
+    void startAnalysis();
+
+    /**
+     * @brief Stops the background analysis and removes its overlay.
+     */
+    void stopAnalysis();
+
+    /**
+     * @brief Shows intermediate analysis results as a heatmap on the board.
+     */
+    void showAnalysis(int generation, const std::vector<tictactoe::MoveScore>& scores);
+
 private:
 	Ui::GameWindow* ui; /**< The user interface object. */
 	tictactoe::TicTacToe* game; /**< The Tic Tac Toe game object. */
 	tictactoe::Symbol symbol; /**< The symbol selected by the player. */
-	QGridLayout* buttonLayout; /**< The layout for the game buttons. */
 	QButtonGroup* buttonGroup; /**< The button group for radio buttons. */
 	int size; /**< The size of the game board. */
+	SearchStepper* stepper; /**< Runs the computer's search on the event loop in cooperative builds. */
+	std::unique_ptr<tictactoe::GameAI> analyst; /**< The AI scoring the human player's moves. */
+	QFuture<void> computerFuture; /**< The running computer move of threaded builds. */
+	QFuture<void> analysisFuture; /**< The running background analysis. */
+	std::atomic<int> analysisGeneration; /**< Incremented to drop the results of the running analysis. */
+	std::atomic<bool> analysisStop; /**< Set to stop the running analysis within a node. */
+	std::unique_ptr<tictactoe::GameRecordWriter> recorder; /**< Record file of the games played, null if not recording. */
+	bool gameRecorded = true; /**< The current game was written to the record file or has not started. */
+	uint64_t traceMoveId = 0; /**< Id of the trace arrows of the current computer move, read by the worker while the board is disabled. */
 };
 
 #endif // GAMEWINDOW_H
@@ -0,0 +1,360 @@
+/**
+ * @file gui_bench.cpp
+ * @brief Implementation file for the offscreen GUI latency benchmark.
+ *
+ * This file contains a tool that drives the game window without a display, under
+ * QT_QPA_PLATFORM=offscreen, by sending mouse clicks to the board through full games on every
+ * grid size. It reports as percentiles the time from a click to the repaint showing it, the
+ * time to the repaint of the computer's reply, the time to rebuild and to enable the board,
+ * and how late the event loop runs while the computer thinks.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <QApplication>
+#include <QMouseEvent>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "boardview.h"
+#include "gamewindow.h"
+#include "latencyhistogram.h"
+#include "rng.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Interval of the timer that measures how late the event loop runs.
+     */
+    const int PROBE_INTERVAL_MSEC = 1;
+
+    /**
+     * @brief Longest wait for the window to react before the run is aborted.
+     */
+    const std::chrono::seconds WAIT_TIMEOUT(60);
+
+    /**
+     * @brief Settings of a benchmark run.
+     */
+    struct Config{
+        int minSize = 2;
+        int maxSize = 19;
+        int games = 3; // Games per grid size
+        int level = 0;
+        uint64_t seed = 1;
+    };
+
+    /**
+     * @brief Latencies collected on one grid size.
+     */
+    struct SizeResult{
+        int size = 0;
+        LatencyHistogram clickToRepaint; // Click until the board shows the player's symbol
+        LatencyHistogram clickToReply; // Click until the board shows the computer's reply
+        LatencyHistogram resize; // Grid size change until the rebuilt board is painted
+        LatencyHistogram toggle; // Enabling or disabling the board until it is painted
+        LatencyHistogram stall; // Lateness of the event loop while the computer thinks
+        LatencyHistogram handler; // Duration of the event handlers while the computer thinks
+    };
+
+    /**
+     * @brief Gets the time since the first call in nanoseconds.
+     */
+    uint64_t nowNsec(){
+        static const auto epoch = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    /**
+     * @brief The BenchApplication class times the events it delivers.
+     *
+     * Every event passes through notify, so the time spent in it is the time the event loop
+     * could not react. The board's paint events tell when a change reached the screen.
+     */
+    class BenchApplication : public QApplication{
+    public:
+        BenchApplication(int& argc, char** argv) : QApplication(argc, argv) {}
+
+        /**
+         * @brief Delivers an event, timing it when it is not nested in another one.
+         */
+        bool notify(QObject* receiver, QEvent* event) override{
+            const bool outermost = 0 == depth;
+            const uint64_t start = outermost ? nowNsec() : 0;
+            depth++;
+            const bool result = QApplication::notify(receiver, event);
+            depth--;
+            if (board && receiver == board && QEvent::Paint == event->type()){
+                lastPaintNsec = nowNsec();
+            }
+            if (board && receiver == board && QEvent::EnabledChange == event->type()){
+                lastEnableNsec = nowNsec();
+            }
+            if (outermost && handlers){
+                handlers->record(nowNsec() - start);
+            }
+            return result;
+        }
+
+        BoardView* board = nullptr; // The board whose events are watched
+        uint64_t lastPaintNsec = 0; // End of the board's last paint
+        uint64_t lastEnableNsec = 0; // Last enabling or disabling of the board
+        LatencyHistogram* handlers = nullptr; // Receives the handler durations while set
+
+    private:
+        int depth = 0; // Nesting of notify calls
+    };
+
+    /**
+     * @brief Runs the event loop until a condition holds.
+     *
+     * @return false if the window did not get there in time.
+     */
+    bool waitFor(const std::function<bool()>& condition){
+        const auto deadline = std::chrono::steady_clock::now() + WAIT_TIMEOUT;
+        while (!condition()){
+            if (std::chrono::steady_clock::now() > deadline){
+                std::fprintf(stderr, "timed out waiting for the game window\n");
+                return false;
+            }
+            // The probe timer fires every millisecond, so the wait never blocks for long
+            QCoreApplication::processEvents(QEventLoop::AllEvents | QEventLoop::WaitForMoreEvents);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Presses and releases the left mouse button over a cell of the board.
+     */
+    void clickCell(BoardView* board, int row, int col){
+        const int size = board->getBoardSize();
+        const QPointF pos((col + 0.5) * (board->width() / size), (row + 0.5) * (board->height() / size));
+        const QPointF global = board->mapToGlobal(pos.toPoint());
+        QMouseEvent press(QEvent::MouseButtonPress, pos, global, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+        QApplication::sendEvent(board, &press);
+        QMouseEvent release(QEvent::MouseButtonRelease, pos, global, Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+        QApplication::sendEvent(board, &release);
+    }
+
+    /**
+     * @brief Plays the games of one grid size, clicking random empty cells.
+     *
+     * @return false if the window stopped reacting.
+     */
+    bool benchSize(BenchApplication& app, GameWindow& window, const Config& config, Rng& rng, SizeResult& result){
+        BoardView* board = window.findChild<BoardView*>("boardView");
+        QSpinBox* gridSize = window.findChild<QSpinBox*>("Grid_size");
+        QPushButton* start = window.findChild<QPushButton*>("Start_button");
+        const auto paintedSince = [&app](uint64_t nsec){ return [&app, nsec]{ return app.lastPaintNsec > nsec; }; };
+
+        uint64_t begin = nowNsec();
+        if (gridSize->value() != result.size){
+            gridSize->setValue(result.size);
+            if (!waitFor(paintedSince(begin))){
+                return false;
+            }
+            result.resize.record(nowNsec() - begin);
+        }
+
+        for (int game = 0; game < config.games; game++){
+            // The player always moves first, the game is over once the grid size can be changed again
+            start->click();
+            while (board->isEnabled() && !gridSize->isEnabled()){
+                std::vector<int> empty;
+                for (int cell = 0; cell < result.size * result.size; cell++){
+                    if (board->getCell(cell / result.size, cell % result.size).isEmpty()){
+                        empty.push_back(cell);
+                    }
+                }
+                if (empty.empty()){
+                    break;
+                }
+                const int cell = empty[rng.below(static_cast<uint32_t>(empty.size()))];
+
+                begin = nowNsec();
+                clickCell(board, cell / result.size, cell % result.size);
+                if (!waitFor(paintedSince(begin))){
+                    return false;
+                }
+                result.clickToRepaint.record(nowNsec() - begin);
+                if (gridSize->isEnabled()){
+                    break; // The player's move ended the game
+                }
+
+                // The reply is shown by the first paint after the board was enabled again
+                app.handlers = &result.handler;
+                const bool replied = waitFor([&]{
+                    return (board->isEnabled() || gridSize->isEnabled()) && app.lastPaintNsec > app.lastEnableNsec;
+                });
+                app.handlers = nullptr;
+                if (!replied){
+                    return false;
+                }
+                result.clickToReply.record(nowNsec() - begin);
+            }
+        }
+
+        // What toggleBoard does to the finished board, without the rest of a move
+        for (int toggle = 0; toggle < 2 * config.games; toggle++){
+            begin = nowNsec();
+            board->setEnabled(!board->isEnabled());
+            if (!waitFor(paintedSince(begin))){
+                return false;
+            }
+            result.toggle.record(nowNsec() - begin);
+        }
+        board->setEnabled(false);
+        return true;
+    }
+
+    /**
+     * @brief Prints the percentiles of a latency in microseconds.
+     */
+    void printLatency(const char* name, const LatencyHistogram& histogram){
+        if (0 == histogram.count()){
+            return;
+        }
+        std::printf("  %-18s p50 %9.1f  p90 %9.1f  p99 %9.1f  max %9.1f us  (%llu)\n", name,
+            histogram.percentile(0.50) / 1000.0, histogram.percentile(0.90) / 1000.0,
+            histogram.percentile(0.99) / 1000.0, histogram.percentile(1.0) / 1000.0,
+            static_cast<unsigned long long>(histogram.count()));
+    }
+
+    /**
+     * @brief Prints all latencies of one grid size or of the whole run.
+     */
+    void printResult(const char* title, const SizeResult& result){
+        std::printf("%s\n", title);
+        printLatency("click to repaint", result.clickToRepaint);
+        printLatency("click to reply", result.clickToReply);
+        printLatency("board resize", result.resize);
+        printLatency("board toggle", result.toggle);
+        printLatency("loop lateness", result.stall);
+        printLatency("event handlers", result.handler);
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: QT_QPA_PLATFORM=offscreen %s [options]\n"
+            "  --min-size N    smallest grid size (default 2)\n"
+            "  --max-size N    largest grid size (default 19)\n"
+            "  --games N       games per grid size (default 3)\n"
+            "  --level N       level of the computer (default 0)\n"
+            "  --seed N        seed of the clicked cells (default 1)\n",
+            program);
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--min-size")){
+                config.minSize = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--max-size")){
+                config.maxSize = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--games")){
+                config.games = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--level")){
+                config.level = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--seed")){
+                config.seed = std::strtoull(value, nullptr, 10);
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.minSize >= 2 && config.maxSize >= config.minSize && config.games > 0 && config.level >= 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the GUI latency benchmark.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    // Without a display unless the caller chose a platform
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")){
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    BenchApplication app(argc, argv);
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    GameWindow window;
+    window.show();
+    BoardView* board = window.findChild<BoardView*>("boardView");
+    QSpinBox* gridSize = window.findChild<QSpinBox*>("Grid_size");
+    QSpinBox* level = window.findChild<QSpinBox*>("Game_level");
+    if (!board || !gridSize || !level || !window.findChild<QPushButton*>("Start_button")){
+        std::fprintf(stderr, "the game window lacks the widgets the benchmark drives\n");
+        return 1;
+    }
+    config.maxSize = std::min(config.maxSize, gridSize->maximum());
+    level->setValue(config.level);
+    app.board = board;
+
+    // Fires every millisecond, a late firing while the computer thinks (handlers are timed) is a stall of the loop
+    SizeResult* current = nullptr;
+    uint64_t lastProbe = nowNsec();
+    QTimer probe;
+    probe.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&probe, &QTimer::timeout, [&]{
+        const uint64_t now = nowNsec();
+        if (current && app.handlers){
+            const uint64_t interval = static_cast<uint64_t>(PROBE_INTERVAL_MSEC) * 1000000;
+            current->stall.record(now - lastProbe > interval ? now - lastProbe - interval : 0);
+        }
+        lastProbe = now;
+    });
+    probe.start(PROBE_INTERVAL_MSEC);
+
+    Rng rng(config.seed);
+    SizeResult total;
+    for (int size = config.minSize; size <= config.maxSize; size++){
+        SizeResult result;
+        result.size = size;
+        current = &result;
+        const bool completed = benchSize(app, window, config, rng, result);
+        current = nullptr;
+        if (!completed){
+            return 1;
+        }
+        char title[32];
+        std::snprintf(title, sizeof(title), "grid %dx%d", size, size);
+        printResult(title, result);
+        total.clickToRepaint.merge(result.clickToRepaint);
+        total.clickToReply.merge(result.clickToReply);
+        total.resize.merge(result.resize);
+        total.toggle.merge(result.toggle);
+        total.stall.merge(result.stall);
+        total.handler.merge(result.handler);
+    }
+    printResult("all grid sizes", total);
+    return 0;
+}
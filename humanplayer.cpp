@@ -29,17 +29,8 @@ namespace tictactoe{
      * @param board The game board.
      * @return True if the move was successful, false otherwise.
      */
-    bool HumanPlayer::makeMove(const QPoint& pos, Board& board){
-        // Check if the position is valid
-        if (pos.x() < 0 || pos.x() >= board.getSize() || pos.y() < 0 || pos.y() >= board.getSize()){
-            return false; // Invalid move
-        }
-
-        // Set the current position
-        curPos = pos;
-
-        // Make the move on the board
-        return board.makeMove(pos, symbol);
+    bool HumanPlayer::makeMove(const CellPos& pos, Board& board){
+        return playMove(pos, board);
     }
 
 } // namespace tictactoe
@@ -31,12 +31,12 @@ namespace tictactoe{
         /**
          * @brief Makes a move on the board at the specified position.
          */
-        bool makeMove(const QPoint& pos, Board& board) override;
+        bool makeMove(const CellPos& pos, Board& board) override;
 
         /**
          * @brief Changes the AI type associated with the human player.
          */
-        bool changeAI(AIType aitype) override { return true; }; // Implement in future
+        bool changeAI(AIType aitype, int boardSize) override { return true; }; // Implement in future
     };
 
 } // namespace tictactoe
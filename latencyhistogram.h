@@ -0,0 +1,126 @@
+/**
+ * @file latencyhistogram.h
+ * @brief Header file for the LatencyHistogram class.
+ *
+ * This file contains the declaration of the LatencyHistogram class, a fixed size histogram of
+ * latencies used by the headless tools to report percentiles.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace tictactoe{
+
+    /**
+     * @brief Log-linear latency histogram, 16 sub-buckets per power of two nanoseconds.
+     *
+     * Recording never allocates and the relative error of a percentile is below 1/16.
+     * The histogram is not thread safe, each thread records into its own and they are merged.
+     */
+    class LatencyHistogram{
+    public:
+        static const int SUB_BUCKETS = 16;
+        static const int BUCKETS = 64 * SUB_BUCKETS;
+
+        /**
+         * @brief Records one latency.
+         */
+        void record(uint64_t nsec){
+            counts[index(nsec)]++;
+            total++;
+        }
+
+        /**
+         * @brief Adds the latencies recorded by another histogram.
+         */
+        void merge(const LatencyHistogram& other){
+            for (int i = 0; i < BUCKETS; i++){
+                counts[i] += other.counts[i];
+            }
+            total += other.total;
+        }
+
+        /**
+         * @brief Adds a number of latencies to a bucket, for histograms kept in another form.
+         */
+        void addToBucket(int bucket, uint64_t amount){
+            counts[bucket] += amount;
+            total += amount;
+        }
+
+        /**
+         * @brief Removes all recorded latencies.
+         */
+        void clear(){
+            counts.fill(0);
+            total = 0;
+        }
+
+        /**
+         * @brief Gets the number of recorded latencies.
+         */
+        inline uint64_t count() const { return total; }
+
+        /**
+         * @brief Gets the upper bound of the bucket holding the given quantile.
+         */
+        uint64_t percentile(double quantile) const{
+            if (0 == total){
+                return 0;
+            }
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * static_cast<double>(total) + 0.5));
+            uint64_t seen = 0;
+            for (int i = 0; i < BUCKETS; i++){
+                seen += counts[i];
+                if (seen >= rank){
+                    return upperBound(i);
+                }
+            }
+            return upperBound(BUCKETS - 1);
+        }
+
+        /**
+         * @brief Gets the bucket a latency is counted in.
+         */
+        static int index(uint64_t nsec){
+            if (nsec < SUB_BUCKETS){
+                return static_cast<int>(nsec);
+            }
+            int exponent = 63;
+            while (!(nsec >> exponent)){
+                exponent--;
+            }
+            // exponent >= 4, keep the 4 bits below the leading one
+            const int sub = static_cast<int>((nsec >> (exponent - 4)) & (SUB_BUCKETS - 1));
+            return (exponent - 3) * SUB_BUCKETS + sub;
+        }
+
+        /**
+         * @brief Gets the largest latency counted in a bucket.
+         */
+        static uint64_t upperBound(int bucket){
+            if (bucket < SUB_BUCKETS){
+                return static_cast<uint64_t>(bucket);
+            }
+            const int exponent = bucket / SUB_BUCKETS + 3;
+            const uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+            return ((SUB_BUCKETS + sub + 1) << (exponent - 4)) - 1;
+        }
+
+    private:
+        std::array<uint64_t, BUCKETS> counts{};
+        uint64_t total = 0;
+    };
+
+} // namespace tictactoe
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,203 @@
+/**
+ * @file logger.cpp
+ * @brief Implementation file for the Logger class.
+ *
+ * This file contains the ring of log records and the background thread that writes them.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "logger.h"
+
+namespace tictactoe {
+
+    namespace {
+        static_assert(0 == (Logger::CAPACITY & (Logger::CAPACITY - 1)), "the ring capacity must be a power of two");
+
+        const uint64_t MASK = Logger::CAPACITY - 1;
+    }
+
+    /**
+     * @brief Constructor for the Logger class, starts the writer thread.
+     */
+    Logger::Logger() : records(new Record[CAPACITY]), output(stderr) {
+        for (uint64_t slot = 0; slot < CAPACITY; slot++) {
+            records[slot].sequence.store(slot, std::memory_order_relaxed);
+        }
+        writer = std::thread(&Logger::run, this);
+    }
+
+    /**
+     * @brief Writes the remaining messages and stops the writer thread.
+     */
+    Logger::~Logger() {
+        stopping.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wakeup.notify_one();
+        }
+        if (writer.joinable()) {
+            writer.join();
+        }
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (stderr != output) {
+            std::fclose(output);
+        }
+    }
+
+    /**
+     * @brief Queues a message for the writer thread.
+     *
+     * Claims the next slot with a compare and swap on the head, copies the message and
+     * publishes the slot through its sequence number. Never waits: if the writer is a whole
+     * ring behind, the message is dropped. Takes the wake mutex only when the writer sleeps,
+     * that is for the first message after the ring ran empty.
+     *
+     * @param level The severity of the message.
+     * @param message The message, truncated to MESSAGE_SIZE bytes.
+     * @param location Where the message was logged, file may be nullptr.
+     */
+    void Logger::log(Level level, std::string_view message, SourceLocation location) {
+        uint64_t position = head.load(std::memory_order_relaxed);
+        Record* record = nullptr;
+        while (true) {
+            record = &records[position & MASK];
+            const uint64_t sequence = record->sequence.load(std::memory_order_acquire);
+            const int64_t difference = static_cast<int64_t>(sequence - position);
+            if (0 == difference) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed); // Full
+                return;
+            }
+            else {
+                position = head.load(std::memory_order_relaxed); // Claimed by another thread meanwhile
+            }
+        }
+
+        record->file = location.file;
+        record->line = location.line;
+        record->level = level;
+        record->length = static_cast<uint16_t>(std::min(message.size(), MESSAGE_SIZE));
+        std::memcpy(record->text, message.data(), record->length);
+        record->sequence.store(position + 1, std::memory_order_release);
+
+        // Pairs with the fence in run: either the writer sees the record or this sees it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            sleeping.store(false, std::memory_order_relaxed);
+            wakeup.notify_one();
+        }
+    }
+
+    /**
+     * @brief Writes the messages to a file instead of stderr.
+     *
+     * @param path The file to append to, or an empty string for stderr.
+     * @return true on success, false if the file can not be opened, the output is then unchanged.
+     */
+    bool Logger::setOutputFile(const std::string& path) {
+        std::FILE* file = stderr;
+        if (!path.empty()) {
+            file = std::fopen(path.c_str(), "a");
+            if (!file) {
+                LOG_ERROR("Cannot open log file " + path);
+                return false;
+            }
+        }
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (stderr != output) {
+            std::fclose(output);
+        }
+        output = file;
+        return true;
+    }
+
+    /**
+     * @brief Waits until every message logged before the call is written.
+     *
+     * Only this call waits, for use before exiting or reading the log file.
+     */
+    void Logger::flush() {
+        const uint64_t target = head.load(std::memory_order_acquire);
+        while (tail.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::fflush(output);
+    }
+
+    /**
+     * @brief Body of the writer thread.
+     *
+     * Writes filled records in order, sleeping on the condition variable while the ring is
+     * empty, until the logger is destroyed and every claimed record is written.
+     */
+    void Logger::run() {
+        while (true) {
+            const bool stop = stopping.load(std::memory_order_acquire);
+            const size_t written = drain();
+            if (stop && tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire)) {
+                break;
+            }
+            if (0 == written) {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const uint64_t position = tail.load(std::memory_order_relaxed);
+                if (records[position & MASK].sequence.load(std::memory_order_acquire) != position + 1) {
+                    wakeup.wait(lock, [this] {
+                        return !sleeping.load(std::memory_order_relaxed) || stopping.load(std::memory_order_acquire);
+                    });
+                }
+                sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the messages filled so far, returns how many.
+     *
+     * @return The number of records written.
+     */
+    size_t Logger::drain() {
+        size_t written = 0;
+        std::lock_guard<std::mutex> lock(outputMutex);
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Record& record = records[position & MASK];
+            if (record.sequence.load(std::memory_order_acquire) != position + 1) {
+                break; // Not filled yet
+            }
+            std::fprintf(output, "[%s] ", (Level::Error == record.level) ? "ERROR" : "INFO");
+            if (record.file) {
+                std::fprintf(output, "%s:%d ", record.file, record.line);
+            }
+            std::fwrite(record.text, 1, record.length, output);
+            std::fputc('\n', output);
+            record.sequence.store(position + CAPACITY, std::memory_order_release);
+            position++;
+            tail.store(position, std::memory_order_release);
+            written++;
+        }
+
+        const uint64_t lost = dropped.load(std::memory_order_relaxed);
+        if (lost != reportedDropped) {
+            std::fprintf(output, "[ERROR] %llu log messages dropped\n", static_cast<unsigned long long>(lost - reportedDropped));
+            reportedDropped = lost;
+            written++;
+        }
+        if (written > 0) {
+            std::fflush(output);
+        }
+        return written;
+    }
+
+}
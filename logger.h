@@ -4,6 +4,12 @@
  *
  * This file contains the declaration of the Logger class, which provides logging functionality.
  * The Logger class is a singleton and can be used to log informational and error messages.
+ * Messages are copied into a fixed-size record of a lock-free ring and written to stderr or a
+ * file by a background thread, so logging never blocks the calling thread on I/O. The thread
+ * sleeps on a condition variable while the ring is empty and is woken by the first message.
+ * Log calls go through the LOG_ERROR and LOG_INFO macros, which compile to nothing when
+ * TICTACTOE_LOG_LEVEL is below their level; the message expression is then named in an
+ * unevaluated sizeof so the variables it uses still count as used.
  *
  * @author Binu Melit Devassy
  * @date 2024-02-16
@@ -14,23 +20,64 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
-#include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <fstream>
-#include <sstream>
+#include <string_view>
+#include <thread>
 
+// Highest level compiled in: 0 nothing, 1 errors, 2 errors and informational messages
+#ifndef TICTACTOE_LOG_LEVEL
+#define TICTACTOE_LOG_LEVEL 2
+#endif
 
 namespace tictactoe {
 
+    /**
+     * @brief A place in the source code, built from literals so it costs nothing to pass.
+     */
+    struct SourceLocation {
+        const char* file = nullptr; /**< File name, a string literal or nullptr. */
+        int line = 0; /**< Line number in the file. */
+    };
 
 // Macro to get the file name and line number
-#define LOG_LOCATION ((std::ostringstream() << __FILE__ << ":" << __LINE__).str())
+#define LOG_LOCATION (::tictactoe::SourceLocation{ __FILE__, __LINE__ })
+
+#if TICTACTOE_LOG_LEVEL >= 1
+#define LOG_ERROR(message) ::tictactoe::Logger::getInstance().logError((message), LOG_LOCATION)
+#else
+#define LOG_ERROR(message) ((void)sizeof(message))
+#endif
+
+#if TICTACTOE_LOG_LEVEL >= 2
+#define LOG_INFO(message) ::tictactoe::Logger::getInstance().logInfo((message), LOG_LOCATION)
+#else
+#define LOG_INFO(message) ((void)sizeof(message))
+#endif
 
     /**
      * @brief The Logger class used to log the errors in the Tic Tac Toe game.
+     *
+     * Any number of threads may log at once. Records are claimed in a bounded multi-producer
+     * ring with a sequence number per slot; when the ring is full the message is dropped and
+     * counted instead of waiting, and the writer reports the count.
      */
     class Logger {
     public:
+        /**
+         * @brief Severity of a message.
+         */
+        enum class Level : uint8_t { Error, Info };
+
+        static constexpr size_t CAPACITY = 1024; // Records in the ring, a power of two
+        static constexpr size_t MESSAGE_SIZE = 232; // Longer messages are truncated
+
         /**
          * @brief Get the single instance of the Logger.
          *
@@ -41,35 +88,92 @@ namespace tictactoe {
             return instance;
         }
 
-        //need to include lock.. lllll
         /**
          * @brief Logs an informational message with optional location information.
          *
          * @param message The informational message to log.
          * @param location Optional location information to include in the log message.
          */
-        inline void logInfo(const std::string& message, const std::string& location = "") {
-            std::cout << "[INFO] " << (location.empty() ? "" : location + " ") << message << std::endl;
-        }
+        inline void logInfo(std::string_view message, SourceLocation location = {}) { log(Level::Info, message, location); }
+
         /**
          * @brief Logs an error message with optional location information.
          *
          * @param message The error message to log.
          * @param location Optional location information to include in the log message.
          */
-        inline void logError(const std::string& message, const std::string& location = "") {
-            std::cout << "[ERROR] " << (location.empty() ? "" : location + " ") << message << std::endl;
-        }
+        inline void logError(std::string_view message, SourceLocation location = {}) { log(Level::Error, message, location); }
+
+        /**
+         * @brief Queues a message for the writer thread.
+         */
+        void log(Level level, std::string_view message, SourceLocation location);
+
+        /**
+         * @brief Writes the messages to a file instead of stderr.
+         */
+        bool setOutputFile(const std::string& path);
+
+        /**
+         * @brief Waits until every message logged before the call is written.
+         */
+        void flush();
+
+        /**
+         * @brief Gets the number of messages dropped because the ring was full.
+         */
+        inline uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
 
     private:
+        /**
+         * @brief A slot of the ring.
+         */
+        struct Record {
+            std::atomic<uint64_t> sequence; // Position the slot is ready to be claimed at, that plus one once filled
+            const char* file;
+            int line;
+            Level level;
+            uint16_t length;
+            char text[MESSAGE_SIZE];
+        };
+
         // Private constructor to prevent external instantiation
-        Logger() {}
+        Logger();
+
+        /**
+         * @brief Writes the remaining messages and stops the writer thread.
+         */
+        ~Logger();
 
         // Private copy constructor, assignment operators, move constructor, and move assignment operator to prevent copies and moves
         Logger(const Logger&) = delete;
         Logger& operator=(const Logger&) = delete;
         Logger(Logger&&) = delete;
         Logger& operator=(Logger&&) = delete;
+
+        /**
+         * @brief Body of the writer thread.
+         */
+        void run();
+
+        /**
+         * @brief Writes the messages filled so far, returns how many.
+         */
+        size_t drain();
+
+    private:
+        std::unique_ptr<Record[]> records;
+        alignas(64) std::atomic<uint64_t> head{ 0 }; // Next position to claim, shared by the producers
+        alignas(64) std::atomic<uint64_t> tail{ 0 }; // Next position to write, advanced by the writer only
+        std::atomic<uint64_t> dropped{ 0 };
+        uint64_t reportedDropped = 0; // Drops already reported, writer only
+        std::atomic<bool> stopping{ false };
+        std::atomic<bool> sleeping{ false }; // The writer waits, or is about to wait, on wakeup
+        std::mutex wakeMutex; // Guards the sleep of the writer
+        std::condition_variable wakeup;
+        std::mutex outputMutex; // Guards output between the writer and setOutputFile
+        std::FILE* output;
+        std::thread writer;
     };
 }
 #endif // LOGGER_H
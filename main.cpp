@@ -9,6 +9,8 @@
  */
 
 #include "gamewindow.h"
+#include "logger.h"
+#include "trace.h"
 
 #include <QApplication>
 #include <QLocale>
@@ -36,10 +38,31 @@ int main(int argc, char* argv[])
         }
     }
 
+    // Record a timeline of the session when TICTACTOE_TRACE_FILE names a file
+    const QByteArray traceFile = qgetenv("TICTACTOE_TRACE_FILE");
+    if (!traceFile.isEmpty()) {
+        if (!tictactoe::Tracer::isCompiledIn()) {
+            LOG_ERROR("Trace spans are not compiled in, configure with -DTICTACTOE_TRACE=ON");
+        }
+        tictactoe::Tracer::getInstance().start();
+        tictactoe::Tracer::getInstance().setThreadName("GUI");
+    }
+
     // Create and show the main game window
     GameWindow w;
     w.show();
 
+    // Append the games played to a game record file when TICTACTOE_RECORD_FILE names one
+    const QByteArray recordFile = qgetenv("TICTACTOE_RECORD_FILE");
+    if (!recordFile.isEmpty()) {
+        w.recordGames(QString::fromLocal8Bit(recordFile));
+    }
+
     // Execute the application event loop
-    return a.exec();
+    const int result = a.exec();
+    if (!traceFile.isEmpty()) {
+        tictactoe::Tracer::getInstance().stop();
+        tictactoe::Tracer::getInstance().writeChromeTrace(traceFile.toStdString());
+    }
+    return result;
 }
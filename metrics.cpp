@@ -0,0 +1,386 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation file for the Metrics class.
+ *
+ * This file contains the registration of metrics, the per-thread shards, the snapshot
+ * formats and the periodic dump thread.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include "metrics.h"
+#include "logger.h"
+
+namespace tictactoe{
+
+    namespace {
+        /**
+         * @brief Quantiles written for every histogram.
+         */
+        const double QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+
+        /**
+         * @brief Appends a string to JSON text as a quoted and escaped string.
+         */
+        void appendJsonString(std::string& out, const std::string& text){
+            out += '"';
+            for (char c : text){
+                if ('"' == c || '\\' == c){
+                    out += '\\';
+                }
+                out += (c < ' ') ? ' ' : c;
+            }
+            out += '"';
+        }
+
+        /**
+         * @brief Appends a formatted number to the text.
+         */
+        template <typename... Args>
+        void appendFormat(std::string& out, const char* format, Args... args){
+            char text[128];
+            const int length = std::snprintf(text, sizeof(text), format, args...);
+            out.append(text, static_cast<size_t>(std::clamp(length, 0, static_cast<int>(sizeof(text)) - 1)));
+        }
+    }
+
+    /**
+     * @brief Releases the shard of a thread when the thread exits.
+     */
+    struct Metrics::ShardOwner{
+        Shard* shard = nullptr;
+
+        ~ShardOwner(){
+            if (shard){
+                Metrics::getInstance().detachShard(shard);
+            }
+        }
+    };
+
+    /**
+     * @brief Formats the snapshot as one JSON object.
+     *
+     * @return For example {"counters":{"tictactoe_board_resets_total":12},"gauges":{},
+     *         "histograms":{"tictactoe_human_move_nsec":{"count":3,"sum":1800,"p50":511,...,"max":767}}}.
+     */
+    std::string MetricsSnapshot::toJson() const{
+        std::string out = "{\"counters\":{";
+        for (size_t i = 0; i < counters.size(); i++){
+            out += (0 == i) ? "" : ",";
+            appendJsonString(out, counters[i].name);
+            appendFormat(out, ":%lld", static_cast<long long>(counters[i].value));
+        }
+        out += "},\"gauges\":{";
+        for (size_t i = 0; i < gauges.size(); i++){
+            out += (0 == i) ? "" : ",";
+            appendJsonString(out, gauges[i].name);
+            appendFormat(out, ":%lld", static_cast<long long>(gauges[i].value));
+        }
+        out += "},\"histograms\":{";
+        for (size_t i = 0; i < histograms.size(); i++){
+            const LatencyHistogram& histogram = histograms[i].histogram;
+            out += (0 == i) ? "" : ",";
+            appendJsonString(out, histograms[i].name);
+            appendFormat(out, ":{\"count\":%llu,\"sum\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu}",
+                static_cast<unsigned long long>(histogram.count()), static_cast<unsigned long long>(histograms[i].sum),
+                static_cast<unsigned long long>(histogram.percentile(0.5)), static_cast<unsigned long long>(histogram.percentile(0.9)),
+                static_cast<unsigned long long>(histogram.percentile(0.99)), static_cast<unsigned long long>(histogram.percentile(0.999)),
+                static_cast<unsigned long long>(histogram.percentile(1.0)));
+        }
+        out += "}}\n";
+        return out;
+    }
+
+    /**
+     * @brief Formats the snapshot in the Prometheus text exposition format.
+     *
+     * Histograms are written as summaries with the quantiles 0.5, 0.9, 0.99 and 0.999.
+     *
+     * @return One HELP and TYPE comment and the samples of each metric, one per line.
+     */
+    std::string MetricsSnapshot::toText() const{
+        std::string out;
+        for (const Value& counter : counters){
+            out += "# HELP " + counter.name + " " + counter.help + "\n# TYPE " + counter.name + " counter\n" + counter.name;
+            appendFormat(out, " %lld\n", static_cast<long long>(counter.value));
+        }
+        for (const Value& gauge : gauges){
+            out += "# HELP " + gauge.name + " " + gauge.help + "\n# TYPE " + gauge.name + " gauge\n" + gauge.name;
+            appendFormat(out, " %lld\n", static_cast<long long>(gauge.value));
+        }
+        for (const Histogram& histogram : histograms){
+            out += "# HELP " + histogram.name + " " + histogram.help + "\n# TYPE " + histogram.name + " summary\n";
+            for (double quantile : QUANTILES){
+                out += histogram.name;
+                appendFormat(out, "{quantile=\"%g\"} %llu\n", quantile, static_cast<unsigned long long>(histogram.histogram.percentile(quantile)));
+            }
+            out += histogram.name;
+            appendFormat(out, "_sum %llu\n", static_cast<unsigned long long>(histogram.sum));
+            out += histogram.name;
+            appendFormat(out, "_count %llu\n", static_cast<unsigned long long>(histogram.histogram.count()));
+        }
+        return out;
+    }
+
+    /**
+     * @brief Stops the periodic dump.
+     *
+     * Shards of threads still running are left to them, the process is ending.
+     */
+    Metrics::~Metrics(){
+        stopDump();
+    }
+
+    /**
+     * @brief Registers a counter, or finds the one registered with the same name.
+     *
+     * @param name The metric name, [a-z_] by convention and ending in _total.
+     * @param help One line describing the metric.
+     * @return The id of the counter, INVALID_ID if MAX_COUNTERS are registered.
+     */
+    Metrics::Id Metrics::counter(std::string_view name, std::string_view help){
+        return registerMetric(counterNames, MAX_COUNTERS, name, help);
+    }
+
+    /**
+     * @brief Registers a gauge, or finds the one registered with the same name.
+     *
+     * @param name The metric name.
+     * @param help One line describing the metric.
+     * @return The id of the gauge, INVALID_ID if MAX_GAUGES are registered.
+     */
+    Metrics::Id Metrics::gauge(std::string_view name, std::string_view help){
+        return registerMetric(gaugeNames, MAX_GAUGES, name, help);
+    }
+
+    /**
+     * @brief Registers a latency histogram, or finds the one registered with the same name.
+     *
+     * @param name The metric name, ending in _nsec by convention.
+     * @param help One line describing the metric.
+     * @return The id of the histogram, INVALID_ID if MAX_HISTOGRAMS are registered.
+     */
+    Metrics::Id Metrics::histogram(std::string_view name, std::string_view help){
+        return registerMetric(histogramNames, MAX_HISTOGRAMS, name, help);
+    }
+
+    /**
+     * @brief Registers a metric in a list, or finds the one with the same name.
+     *
+     * @param list The descriptions of the metrics of one kind.
+     * @param capacity The most metrics of the kind.
+     * @param name The metric name.
+     * @param help One line describing the metric.
+     * @return The index of the metric in the list, INVALID_ID if the list is full.
+     */
+    Metrics::Id Metrics::registerMetric(std::vector<Description>& list, int capacity, std::string_view name, std::string_view help){
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < list.size(); i++){
+            if (list[i].name == name){
+                return static_cast<Id>(i);
+            }
+        }
+        if (static_cast<int>(list.size()) >= capacity){
+            LOG_ERROR("Too many metrics, not registered: " + std::string(name));
+            return INVALID_ID;
+        }
+        list.push_back(Description{ std::string(name), std::string(help) });
+        return static_cast<Id>(list.size() - 1);
+    }
+
+    /**
+     * @brief Creates the shard of the calling thread.
+     *
+     * @return The new shard, released when the thread exits.
+     */
+    Metrics::Shard& Metrics::attachShard(){
+        thread_local ShardOwner owner;
+        Shard* shard = new Shard();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shards.push_back(shard);
+        }
+        owner.shard = shard;
+        current = shard;
+        return *shard;
+    }
+
+    /**
+     * @brief Creates the calling thread's counts of a histogram.
+     *
+     * @param id The histogram.
+     * @return The counts, published so a snapshot sees them zeroed.
+     */
+    Metrics::HistogramShard* Metrics::attachHistogram(Id id){
+        HistogramShard* histogram = new HistogramShard();
+        localShard().histograms[id].store(histogram, std::memory_order_release);
+        return histogram;
+    }
+
+    /**
+     * @brief Folds the shard of an exiting thread into the totals and frees it.
+     *
+     * @param shard The shard of the calling thread.
+     */
+    void Metrics::detachShard(Shard* shard){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shards.erase(std::remove(shards.begin(), shards.end(), shard), shards.end());
+            for (int i = 0; i < MAX_COUNTERS; i++){
+                retiredCounters[i] += shard->counters[i].load(std::memory_order_relaxed);
+            }
+            for (int i = 0; i < MAX_HISTOGRAMS; i++){
+                HistogramShard* histogram = shard->histograms[i].load(std::memory_order_relaxed);
+                if (!histogram){
+                    continue;
+                }
+                for (int bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++){
+                    const uint64_t count = histogram->counts[bucket].load(std::memory_order_relaxed);
+                    if (count > 0){
+                        retiredHistograms[i].addToBucket(bucket, count);
+                    }
+                }
+                retiredSums[i] += histogram->sum.load(std::memory_order_relaxed);
+                delete histogram;
+            }
+        }
+        delete shard;
+        current = nullptr;
+    }
+
+    /**
+     * @brief Gets the current values of all metrics.
+     *
+     * Counts recorded while the snapshot is taken may or may not be included.
+     *
+     * @return The values of the registered metrics in registration order.
+     */
+    MetricsSnapshot Metrics::snapshot() const{
+        MetricsSnapshot result;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < counterNames.size(); i++){
+            uint64_t value = retiredCounters[i];
+            for (const Shard* shard : shards){
+                value += shard->counters[i].load(std::memory_order_relaxed);
+            }
+            result.counters.push_back({ counterNames[i].name, counterNames[i].help, static_cast<int64_t>(value) });
+        }
+        for (size_t i = 0; i < gaugeNames.size(); i++){
+            result.gauges.push_back({ gaugeNames[i].name, gaugeNames[i].help, gauges[i].load(std::memory_order_relaxed) });
+        }
+        for (size_t i = 0; i < histogramNames.size(); i++){
+            MetricsSnapshot::Histogram histogram{ histogramNames[i].name, histogramNames[i].help, retiredHistograms[i], retiredSums[i] };
+            for (const Shard* shard : shards){
+                const HistogramShard* counts = shard->histograms[i].load(std::memory_order_acquire);
+                if (!counts){
+                    continue;
+                }
+                for (int bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++){
+                    const uint64_t count = counts->counts[bucket].load(std::memory_order_relaxed);
+                    if (count > 0){
+                        histogram.histogram.addToBucket(bucket, count);
+                    }
+                }
+                histogram.sum += counts->sum.load(std::memory_order_relaxed);
+            }
+            result.histograms.push_back(std::move(histogram));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Writes a snapshot to a file, replacing it atomically.
+     *
+     * The snapshot is written to a temporary file next to it that is then renamed, so a reader
+     * never sees a partly written file.
+     *
+     * @param path The file to write.
+     * @param format The format of the file.
+     * @return true on success, false if the file can not be written.
+     */
+    bool Metrics::writeFile(const std::string& path, Format format) const{
+        const MetricsSnapshot values = snapshot();
+        const std::string text = (Format::Json == format) ? values.toJson() : values.toText();
+        const std::string temporary = path + ".tmp";
+        std::FILE* file = std::fopen(temporary.c_str(), "w");
+        if (!file){
+            LOG_ERROR("Cannot open metrics file " + temporary);
+            return false;
+        }
+        const bool written = (text.size() == std::fwrite(text.data(), 1, text.size(), file));
+        if (0 != std::fclose(file) || !written || 0 != std::rename(temporary.c_str(), path.c_str())){
+            LOG_ERROR("Cannot write metrics file " + path);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gets the format of a dump file from its name, JSON for a .json file and text otherwise.
+     *
+     * @param path The file name.
+     * @return The format to write the file in.
+     */
+    Metrics::Format Metrics::formatOf(const std::string& path){
+        const std::string extension = ".json";
+        const bool json = path.size() >= extension.size() && 0 == path.compare(path.size() - extension.size(), extension.size(), extension);
+        return json ? Format::Json : Format::Text;
+    }
+
+    /**
+     * @brief Starts writing a snapshot to a file at a fixed interval.
+     *
+     * Replaces a dump already running. The file is written once before returning.
+     *
+     * @param path The file to write.
+     * @param format The format of the file.
+     * @param interval Time between two snapshots.
+     * @return true if the dump started, false if the file can not be written.
+     */
+    bool Metrics::startDump(const std::string& path, Format format, std::chrono::milliseconds interval){
+        stopDump();
+        if (!writeFile(path, format)){
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(dumpMutex);
+        dumpStopping = false;
+        dumpThread = std::thread(&Metrics::runDump, this, path, format, interval);
+        return true;
+    }
+
+    /**
+     * @brief Stops the periodic dump after writing a last snapshot.
+     */
+    void Metrics::stopDump(){
+        {
+            std::lock_guard<std::mutex> lock(dumpMutex);
+            dumpStopping = true;
+        }
+        dumpWake.notify_all();
+        if (dumpThread.joinable()){
+            dumpThread.join();
+        }
+    }
+
+    /**
+     * @brief Body of the dump thread.
+     *
+     * @param path The file to write.
+     * @param format The format of the file.
+     * @param interval Time between two snapshots.
+     */
+    void Metrics::runDump(std::string path, Format format, std::chrono::milliseconds interval){
+        std::unique_lock<std::mutex> lock(dumpMutex);
+        bool stopping = false;
+        while (!stopping){
+            stopping = dumpWake.wait_for(lock, interval, [this]() { return dumpStopping; });
+            lock.unlock();
+            writeFile(path, format);
+            lock.lock();
+        }
+    }
+
+} // namespace tictactoe
@@ -0,0 +1,268 @@
+/**
+ * @file metrics.h
+ * @brief Header file for the Metrics class.
+ *
+ * This file contains the declaration of the Metrics class, a process-wide registry of
+ * counters, gauges and latency histograms that the engine updates while it plays, and of
+ * MetricsSnapshot, a consistent copy of their values that can be formatted as JSON or in the
+ * Prometheus text exposition format. The registry can dump a snapshot to a file periodically
+ * so move latency percentiles can be watched without attaching a profiler.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "latencyhistogram.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Values of all metrics at one moment.
+     */
+    struct MetricsSnapshot{
+        /**
+         * @brief The value of a counter or gauge.
+         */
+        struct Value{
+            std::string name;
+            std::string help;
+            int64_t value;
+        };
+
+        /**
+         * @brief The latencies recorded by a histogram.
+         */
+        struct Histogram{
+            std::string name;
+            std::string help;
+            LatencyHistogram histogram;
+            uint64_t sum; /**< Sum of the recorded latencies in nanoseconds. */
+        };
+
+        std::vector<Value> counters;
+        std::vector<Value> gauges;
+        std::vector<Histogram> histograms;
+
+        /**
+         * @brief Formats the snapshot as one JSON object.
+         */
+        std::string toJson() const;
+
+        /**
+         * @brief Formats the snapshot in the Prometheus text exposition format.
+         */
+        std::string toText() const;
+    };
+
+    /**
+     * @brief The Metrics class is the registry of the process's counters, gauges and histograms.
+     *
+     * Metrics are registered once by name and then updated through their id. Counters and
+     * histograms are kept in a shard per thread that only that thread writes, so updating
+     * them is a plain load and store without a lock or a contended cache line; a snapshot adds
+     * the shards up. A thread's shard is folded into the totals when the thread exits. Gauges
+     * hold a single value and are shared by all threads.
+     */
+    class Metrics{
+    public:
+        using Id = int; /**< Index of a registered metric, INVALID_ID if it could not be registered. */
+
+        /**
+         * @brief Output format of a dump.
+         */
+        enum class Format { Json, Text };
+
+        static constexpr Id INVALID_ID = -1;
+        static constexpr int MAX_COUNTERS = 64;
+        static constexpr int MAX_GAUGES = 32;
+        static constexpr int MAX_HISTOGRAMS = 16;
+
+        /**
+         * @brief Get the single instance of the registry.
+         */
+        inline static Metrics& getInstance(){
+            static Metrics instance;
+            return instance;
+        }
+
+        /**
+         * @brief Registers a counter, or finds the one registered with the same name.
+         */
+        Id counter(std::string_view name, std::string_view help);
+
+        /**
+         * @brief Registers a gauge, or finds the one registered with the same name.
+         */
+        Id gauge(std::string_view name, std::string_view help);
+
+        /**
+         * @brief Registers a latency histogram, or finds the one registered with the same name.
+         */
+        Id histogram(std::string_view name, std::string_view help);
+
+        /**
+         * @brief Adds to a counter.
+         */
+        inline void add(Id id, uint64_t amount = 1){
+            if (id < 0){
+                return;
+            }
+            std::atomic<uint64_t>& value = localShard().counters[id];
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Sets a gauge.
+         */
+        inline void set(Id id, int64_t value){
+            if (id >= 0){
+                gauges[id].store(value, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Records a latency in a histogram.
+         */
+        inline void record(Id id, uint64_t nsec){
+            if (id < 0){
+                return;
+            }
+            HistogramShard* histogram = localShard().histograms[id].load(std::memory_order_relaxed);
+            if (!histogram){
+                histogram = attachHistogram(id);
+            }
+            std::atomic<uint64_t>& count = histogram->counts[LatencyHistogram::index(nsec)];
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            histogram->sum.store(histogram->sum.load(std::memory_order_relaxed) + nsec, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the current values of all metrics.
+         */
+        MetricsSnapshot snapshot() const;
+
+        /**
+         * @brief Writes a snapshot to a file, replacing it atomically.
+         */
+        bool writeFile(const std::string& path, Format format) const;
+
+        /**
+         * @brief Starts writing a snapshot to a file at a fixed interval.
+         */
+        bool startDump(const std::string& path, Format format, std::chrono::milliseconds interval);
+
+        /**
+         * @brief Stops the periodic dump after writing a last snapshot.
+         */
+        void stopDump();
+
+        /**
+         * @brief Gets the format of a dump file from its name, JSON for a .json file and text otherwise.
+         */
+        static Format formatOf(const std::string& path);
+
+    private:
+        /**
+         * @brief The counts of one histogram written by one thread.
+         */
+        struct HistogramShard{
+            std::atomic<uint64_t> counts[LatencyHistogram::BUCKETS] = {};
+            std::atomic<uint64_t> sum{ 0 };
+        };
+
+        /**
+         * @brief The counters and histograms written by one thread, on cache lines of its own.
+         */
+        struct alignas(64) Shard{
+            std::atomic<uint64_t> counters[MAX_COUNTERS] = {};
+            std::atomic<HistogramShard*> histograms[MAX_HISTOGRAMS] = {}; // Allocated on first use by the owning thread
+        };
+
+        /**
+         * @brief A registered metric.
+         */
+        struct Description{
+            std::string name;
+            std::string help;
+        };
+
+        // Private constructor to prevent external instantiation
+        Metrics() = default;
+
+        /**
+         * @brief Stops the periodic dump.
+         */
+        ~Metrics();
+
+        Metrics(const Metrics&) = delete;
+        Metrics& operator=(const Metrics&) = delete;
+
+        /**
+         * @brief Gets the shard of the calling thread, creating it on first use.
+         */
+        inline Shard& localShard() { return current ? *current : attachShard(); }
+
+        /**
+         * @brief Creates the shard of the calling thread.
+         */
+        Shard& attachShard();
+
+        /**
+         * @brief Creates the calling thread's counts of a histogram.
+         */
+        HistogramShard* attachHistogram(Id id);
+
+        /**
+         * @brief Folds the shard of an exiting thread into the totals and frees it.
+         */
+        void detachShard(Shard* shard);
+
+        /**
+         * @brief Registers a metric in a list, or finds the one with the same name.
+         */
+        Id registerMetric(std::vector<Description>& list, int capacity, std::string_view name, std::string_view help);
+
+        /**
+         * @brief Body of the dump thread.
+         */
+        void runDump(std::string path, Format format, std::chrono::milliseconds interval);
+
+        struct ShardOwner; // Detaches the shard of a thread when the thread exits
+
+    private:
+        static inline thread_local Shard* current = nullptr; // Shard of the calling thread, null until it records
+
+        mutable std::mutex mutex; // Guards the descriptions, the shard list and the retired totals
+        std::vector<Description> counterNames;
+        std::vector<Description> gaugeNames;
+        std::vector<Description> histogramNames;
+        std::vector<Shard*> shards; // Shards of the running threads
+        uint64_t retiredCounters[MAX_COUNTERS] = {}; // Counts of threads that have exited
+        std::vector<LatencyHistogram> retiredHistograms = std::vector<LatencyHistogram>(MAX_HISTOGRAMS);
+        uint64_t retiredSums[MAX_HISTOGRAMS] = {};
+        std::atomic<int64_t> gauges[MAX_GAUGES] = {};
+
+        std::mutex dumpMutex; // Guards the dump thread and wakes it to stop
+        std::condition_variable dumpWake;
+        bool dumpStopping = false;
+        std::thread dumpThread;
+    };
+
+} // namespace tictactoe
+
+#endif // METRICS_H
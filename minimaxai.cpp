@@ -8,7 +8,13 @@
  * @date 2024-02-16
  */
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include "alloctracker.h"
 #include "minimaxai.h"
+#include "minimaxsearch.h"
+#include "trace.h"
 
 namespace tictactoe{
 
@@ -26,29 +32,281 @@ namespace tictactoe{
      *
      * @param board The current state of the game board.
      * @param symbol The symbol (X or O) representing the player making the move.
-     * @return QPoint The coordinates of the best move to make.
+     * @return CellPos The coordinates of the best move to make.
      */
-    QPoint MinimaxAI::makeMove(const Board& board, Symbol symbol) const{
+    CellPos MinimaxAI::makeMove(const Board& board, Symbol symbol) const{
+        TRACE_SCOPE("MinimaxAI::makeMove");
+        ALLOC_SCOPE("MinimaxAI::makeMove");
         int bestScore = -std::numeric_limits<int>::max();
-        QPoint bestMove;
+        CellPos bestMove{ 0, 0 };
 
-        // Iterate over all empty positions on the board
+        // Search on the scratch board, reusing its storage
+        const auto start = std::chrono::steady_clock::now();
+        beginSearch(board);
+        beginStats(board, static_cast<int>(level));
+
+        // Only a move scoring strictly better than the best so far is taken, so later moves
+        // are searched with the best score as alpha without changing the chosen move
+        for (const CellPos& move : rootMoves(board, symbol)){
+            TRACE_SCOPE_ARG("root move", move.y * board.getSize() + move.x);
+            bool complete = true;
+            int score_calc = scoreMove(scratch, move, symbol, static_cast<int>(level), bestScore, std::numeric_limits<int>::max(), complete);
+            if (score_calc > bestScore){
+                bestScore = score_calc;
+                bestMove = move;
+                pvTable.update(0, move);
+            }
+        }
+
+        lastStats.score = bestScore;
+        endStats(start);
+        return bestMove;
+    }
+
+    /**
+     * @brief Scores every legal move with iterative deepening up to the AI level.
+     *
+     * Each depth rescores all root moves, reporting after every move, so callers get a usable
+     * result early that is refined as the search deepens. The transposition table is shared
+     * between root moves and depths, so a full analysis costs little more than makeMove.
+     * Deepening stops early once every root move is solved exactly. The stop flag is checked
+     * after every node, so another thread can end a long analysis without waiting for the
+     * root move being searched; abandoned nodes are not cached.
+     *
+     * @param board The current state of the game board.
+     * @param symbol The symbol (X or O) of the side to move.
+     * @param progress Optional callback receiving the scores after each root move, may stop the analysis by returning false.
+     * @param stop Optional flag stopping the analysis once set, the move being searched keeps its previous score.
+     * @return The scores of all legal moves in row-major order.
+     */
+    std::vector<MoveScore> MinimaxAI::analyze(const Board& board, Symbol symbol, const AnalysisCallback& progress,
+        const std::atomic<bool>* stop) const{
+        std::vector<MoveScore> scores;
         for (int row = 0; row < board.getSize(); row++){
             for (int col = 0; col < board.getSize(); col++){
-                if (board.isEmpty(QPoint(col, row))){
-                    // Create a copy of the board and make a move on the temporary board
-                    Board tempBoard = board;
-                    tempBoard.makeMove(QPoint(col, row), symbol);
-                    int score_calc = minimax(tempBoard, static_cast<int>(level), false, symbol);
-                    if (score_calc > bestScore){
-                        bestScore = score_calc;
-                        bestMove = { col,row };
-                    }
+                if (board.isEmpty(CellPos{ col, row })){
+                    scores.push_back({ CellPos{ col, row }, 0, -1 });
                 }
             }
         }
 
-        return bestMove;
+        const auto start = std::chrono::steady_clock::now();
+        beginSearch(board);
+        beginStats(board, static_cast<int>(level));
+        stopFlag = stop;
+        for (int depth = 0; depth <= static_cast<int>(level) && !stopped(); depth++){
+            TRACE_SCOPE_ARG("analysis depth", depth);
+            bool solved = true;
+            int bestScore = -std::numeric_limits<int>::max();
+            rootDepth = depth;
+            for (MoveScore& moveScore : scores){
+                bool complete = true;
+                // A full window keeps every root score exact
+                const int score_calc = scoreMove(scratch, moveScore.move, symbol, depth,
+                    -std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), complete);
+                if (stopped()){
+                    break; // The search of this move was abandoned
+                }
+                moveScore.score = score_calc;
+                moveScore.depth = depth;
+                solved = solved && complete;
+                if (moveScore.score > bestScore){
+                    bestScore = moveScore.score;
+                    lastStats.score = bestScore;
+                    pvTable.update(0, moveScore.move);
+                }
+                if (progress && !progress(scores)){
+                    stopFlag = nullptr;
+                    endStats(start);
+                    return scores;
+                }
+            }
+            if (solved){
+                break; // Deeper searches can not change any score
+            }
+        }
+
+        stopFlag = nullptr;
+        endStats(start);
+        return scores;
+    }
+
+    /**
+     * @brief Creates a resumable search that finds the same move as makeMove.
+     *
+     * The search shares this AI's transposition table and must not outlive the AI.
+     *
+     * @param board The current state of the game board, copied into the task.
+     * @param symbol The symbol (X or O) of the side to move.
+     * @return The search task.
+     */
+    std::unique_ptr<SearchTask> MinimaxAI::createSearch(const Board& board, Symbol symbol) const{
+        return std::make_unique<MinimaxSearch>(*this, board, symbol);
+    }
+
+    /**
+     * @brief Discards all cached search results.
+     */
+    void MinimaxAI::clearCaches(){
+        table.clear();
+    }
+
+    /**
+     * @brief Resets the AI and drops its position database, evaluation weights and network.
+     *
+     * The database changes the order of root moves and so which of equally scored moves is
+     * played, and the weights and the network change the scores, a pooled AI must not keep the
+     * ones set by its previous owner.
+     */
+    void MinimaxAI::reset(){
+        GameAI::reset();
+        positionDB.reset();
+        setEvalWeights(nullptr);
+        setNeuralEval(nullptr);
+    }
+
+    /**
+     * @brief Sets the weights of the evaluation of positions at the depth limit.
+     *
+     * Scores of searches cut off by the depth limit depend on the weights, so the table is
+     * cleared when they change.
+     *
+     * @param evalWeights_i The weights, or nullptr to score cut off positions as draws.
+     */
+    void MinimaxAI::setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights_i){
+        if (evalWeights != evalWeights_i){
+            table.clear();
+        }
+        evalWeights = std::move(evalWeights_i);
+    }
+
+    /**
+     * @brief Sets the neural network scoring positions at the depth limit and ordering root moves.
+     *
+     * Like the evaluation weights, the network changes the scores of cut off searches, so the
+     * table is cleared when it changes. A network for another board size is ignored.
+     *
+     * @param neuralEval_i The network, or nullptr to not use one.
+     */
+    void MinimaxAI::setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval_i){
+        if (neuralEval != neuralEval_i){
+            table.clear();
+        }
+        neuralEval = std::move(neuralEval_i);
+    }
+
+    /**
+     * @brief Copies the position to search into the scratch board and sets up the network for it.
+     *
+     * @param board The position to search.
+     */
+    void MinimaxAI::beginSearch(const Board& board) const{
+        scratch = board;
+        network = networkFor(board);
+        if (network){
+            network->refresh(scratch, accumulator);
+        }
+    }
+
+    /**
+     * @brief Clears the statistics and sizes the principal variation for a search of the given depth.
+     *
+     * @param board The position to search.
+     * @param depth The depth the root moves are searched to.
+     */
+    void MinimaxAI::beginStats(const Board& board, int depth) const{
+        lastStats = SearchStats();
+        rootDepth = depth;
+        // A node below the root is at most one ply deeper than the depth and than the empty cells
+        pvTable.reset(std::min(depth, board.getSize() * board.getSize()) + 1);
+    }
+
+    /**
+     * @brief Completes the statistics of a search started at the given time.
+     *
+     * @param start When the search started.
+     */
+    void MinimaxAI::endStats(std::chrono::steady_clock::time_point start) const{
+        lastStats.pv = pvTable.getLine();
+        lastStats.elapsedNsec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    /**
+     * @brief Gets the network to use for a board, null if there is none for its size.
+     *
+     * @param board The board.
+     * @return The network, owned by this AI.
+     */
+    const NeuralEval* MinimaxAI::networkFor(const Board& board) const{
+        return (neuralEval && neuralEval->getSize() == board.getSize()) ? neuralEval.get() : nullptr;
+    }
+
+    /**
+     * @brief Gets the legal moves in the order the root searches them.
+     *
+     * Moves are in row-major order, or by falling prior of the network's policy when there is
+     * one, except that the reply most often played from this position in the position database
+     * comes first. Searching the likely best move first tightens the window of the other moves,
+     * and since makeMove keeps the first of equally scored moves, the database reply and then
+     * the network's choice are preferred among them.
+     *
+     * @param board The current state of the game board.
+     * @param symbol The symbol (X or O) of the side to move.
+     * @return The empty cells of the board.
+     */
+    std::vector<CellPos> MinimaxAI::rootMoves(const Board& board, Symbol symbol) const{
+        std::vector<CellPos> moves;
+        for (int row = 0; row < board.getSize(); row++){
+            for (int col = 0; col < board.getSize(); col++){
+                if (board.isEmpty(CellPos{ col, row })){
+                    moves.push_back(CellPos{ col, row });
+                }
+            }
+        }
+
+        const NeuralEval* net = networkFor(board);
+        if (net && moves.size() > 1){
+            NeuralEval::Accumulator rootAccumulator;
+            net->refresh(board, rootAccumulator);
+            std::vector<float> priors(static_cast<size_t>(board.getSize() * board.getSize()));
+            net->policy(board, rootAccumulator, symbol, priors.data());
+            auto prior = [&](const CellPos& move){ return priors[static_cast<size_t>(move.y * board.getSize() + move.x)]; };
+            std::stable_sort(moves.begin(), moves.end(), [&](const CellPos& a, const CellPos& b){ return prior(a) > prior(b); });
+        }
+
+        PositionStats stats;
+        if (positionDB && positionDB->lookup(board, symbol, stats) && stats.hasReply){
+            auto reply = std::find(moves.begin(), moves.end(), stats.reply);
+            if (moves.end() != reply){
+                std::rotate(moves.begin(), reply, reply + 1);
+            }
+        }
+        return moves;
+    }
+    /**
+     * @brief Scores a single root move searched to the given depth.
+     *
+     * @param board The current state of the game board, restored before returning.
+     * @param move The move to score.
+     * @param symbol The symbol (X or O) of the side making the move.
+     * @param depth The depth to search the resulting position to.
+     * @param alpha Score the searching side is already assured of.
+     * @param beta Score the opponent is already assured of.
+     * @param complete Cleared if the search was cut off by the depth limit.
+     * @return The minimax score of the move, or a bound on it outside the window.
+     */
+    int MinimaxAI::scoreMove(Board& board, const CellPos& move, Symbol symbol, int depth, int alpha, int beta, bool& complete) const{
+        board.makeMove(move, symbol);
+        if (network){
+            network->addMove(accumulator, move, symbol);
+        }
+        int score_calc = minimax(board, depth, false, symbol, alpha, beta, complete);
+        board.undoMove(move);
+        if (network){
+            network->removeMove(accumulator, move, symbol);
+        }
+        return score_calc;
     }
 
 
@@ -56,50 +314,175 @@ namespace tictactoe{
      * @brief Implementation of the Minimax algorithm for finding the optimal move in Tic Tac Toe.
      *
      * This function recursively evaluates all possible moves on the board and selects the best move using the Minimax algorithm.
+     * Moves that can not change the result within the alpha-beta window are skipped; the score is fail-soft, a score
+     * at or below alpha is an upper bound and one at or above beta a lower bound of the true score, and a score
+     * strictly inside the window is exact. Results are cached in the transposition table with their bound.
      * Reference: https://www.geeksforgeeks.org/finding-optimal-move-in-tic-tac-toe-using-minimax-algorithm-in-game-theory/
      *
-     * @param board The current state of the game board.
+     * @param board The current state of the game board, moves are made and taken back on it.
      * @param depth The depth of recursion (current depth of the search tree).
      * @param isMaximizing Indicates whether it's the maximizing player's turn or not.
      * @param symbol The symbol (X or O) for which the move is being evaluated.
+     * @param alpha Score the maximizing side is already assured of.
+     * @param beta Score the minimizing side is already assured of.
+     * @param complete Cleared if the search was cut off by the depth limit.
      * @return The optimal score for the current move.
      */
-	int MinimaxAI::minimax(const Board& board, int depth, bool isMaximizing, Symbol symbol) const
+	int MinimaxAI::minimax(Board& board, int depth, bool isMaximizing, Symbol symbol, int alpha, int beta, bool& complete) const
     {
+        // The root's moves lead to ply 1, searched to rootDepth
+        const int ply = rootDepth - depth + 1;
+        pvTable.clear(ply);
+        lastStats.nodes++;
+        lastStats.maxDepth = std::max(lastStats.maxDepth, ply);
+
+        const uint64_t key = nodeKey(board, isMaximizing, symbol);
+        int cached = 0;
+        TranspositionTable::Bound bound = TranspositionTable::Bound::Exact;
+        bool cachedComplete = true;
+        if (table.probe(key, depth, cached, bound, cachedComplete) && usable(cached, bound, alpha, beta)){
+            lastStats.cacheHits++;
+            complete = complete && cachedComplete;
+            return cached;
+        }
+        lastStats.cacheMisses++;
+
         Symbol winner = board.checkForWinner();
         if (Symbol::None != winner){
-            return score(board, symbol);
+            int result = score(board, symbol);
+            table.store(key, depth, result, TranspositionTable::Bound::Exact, true);
+            return result;
         }
 
         if (board.isBoardFull()){
+            table.store(key, depth, 0, TranspositionTable::Bound::Exact, true);
             return 0; // Tie game
         }
 
         if ( 0 == depth){
-            return 0;
+            lastStats.leafEvals++;
+            complete = false;
+            return leafScore(board, isMaximizing, symbol, network ? &accumulator : nullptr);
         }
 
+        const int alphaOrig = alpha;
+        const int betaOrig = beta;
+        bool subtreeComplete = true;
         int bestScore = isMaximizing ? -std::numeric_limits<int>::max() : std::numeric_limits<int>::max();
-        for (int row = 0; row < board.getSize(); row++) {
-            for (int col = 0; col < board.getSize(); col++){
-                if (board.isEmpty(QPoint(col, row))){
-                    // Create a copy of the board and make a move on the temporary board
-                    Board tempBoard = board;
-                    tempBoard.makeMove(QPoint(col, row), isMaximizing ? symbol : board.getOpponent(symbol));
-                    int score_calc = minimax(tempBoard, depth - 1, !isMaximizing, symbol);
+        for (int row = 0; row < board.getSize() && alpha < beta; row++) {
+            for (int col = 0; col < board.getSize() && alpha < beta; col++){
+                if (board.isEmpty(CellPos{ col, row })){
+                    // Make the move, search it and take it back, keeping the network's first layer in step
+                    const Symbol mover = isMaximizing ? symbol : board.getOpponent(symbol);
+                    board.makeMove(CellPos{ col, row }, mover);
+                    if (network){
+                        network->addMove(accumulator, CellPos{ col, row }, mover);
+                    }
+                    int score_calc = minimax(board, depth - 1, !isMaximizing, symbol, alpha, beta, subtreeComplete);
+                    board.undoMove(CellPos{ col, row });
+                    if (network){
+                        network->removeMove(accumulator, CellPos{ col, row }, mover);
+                    }
+                    if (stopped()){
+                        // The analysis was abandoned, the score is meaningless and must not be cached
+                        complete = false;
+                        return bestScore;
+                    }
+                    if (isMaximizing ? score_calc > bestScore : score_calc < bestScore){
+                        bestScore = score_calc;
+                        pvTable.update(ply, CellPos{ col, row });
+                    }
                     if (isMaximizing){
-                        bestScore = std::max(bestScore, score_calc);
+                        alpha = std::max(alpha, score_calc);
                     }
                     else{
-                        bestScore = std::min(bestScore, score_calc);
+                        beta = std::min(beta, score_calc);
+                    }
+                    if (alpha >= beta){
+                        lastStats.cutoffs++;
                     }
                 }
             }
         }
 
+        table.store(key, depth, bestScore, boundOf(bestScore, alphaOrig, betaOrig), subtreeComplete);
+        complete = complete && subtreeComplete;
         return bestScore;
     }
 
+    /**
+     * @brief Checks whether a cached score decides a node searched with the given window.
+     *
+     * @param cached The cached score.
+     * @param bound How the cached score bounds the true score.
+     * @param alpha Score the maximizing side is already assured of.
+     * @param beta Score the minimizing side is already assured of.
+     * @return true if the cached score can be returned as the result of the node.
+     */
+    bool MinimaxAI::usable(int cached, TranspositionTable::Bound bound, int alpha, int beta){
+        return TranspositionTable::Bound::Exact == bound
+            || (TranspositionTable::Bound::Lower == bound && cached >= beta)
+            || (TranspositionTable::Bound::Upper == bound && cached <= alpha);
+    }
+
+    /**
+     * @brief Gets the bound a fail-soft score searched with the given window places on the true score.
+     *
+     * @param score The score of the node.
+     * @param alpha The alpha the node was searched with.
+     * @param beta The beta the node was searched with.
+     * @return The bound to store the score with.
+     */
+    TranspositionTable::Bound MinimaxAI::boundOf(int score, int alpha, int beta){
+        if (score <= alpha){
+            return TranspositionTable::Bound::Upper;
+        }
+        return score >= beta ? TranspositionTable::Bound::Lower : TranspositionTable::Bound::Exact;
+    }
+
+    /**
+     * @brief Gets the transposition table key of a position from the searching side's perspective.
+     *
+     * Scores are relative to the searching symbol and the side to move, so both are mixed into the key.
+     *
+     * @param board The position.
+     * @param isMaximizing Indicates whether it's the maximizing player's turn or not.
+     * @param symbol The symbol (X or O) for which the position is being evaluated.
+     * @return The key of the node.
+     */
+    uint64_t MinimaxAI::nodeKey(const Board& board, bool isMaximizing, Symbol symbol){
+        static const uint64_t PERSPECTIVE_KEYS[2][3] = {
+            { 0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL },
+            { 0xA54FF53A5F1D36F1ULL, 0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL }
+        };
+        return board.getKey() ^ PERSPECTIVE_KEYS[isMaximizing ? 1 : 0][static_cast<int>(symbol)];
+    }
+
+    /**
+     * @brief Scores a position cut off by the depth limit for the searching side.
+     *
+     * The network scores the position when it is used, otherwise the evaluation weights do.
+     * Without either for the board size the position scores as a draw.
+     *
+     * @param board The position, not decided yet.
+     * @param isMaximizing Indicates whether it's the maximizing player's turn or not.
+     * @param symbol The symbol (X or O) for which the position is being evaluated.
+     * @param accumulator The network's first layer for the position, null if the network is not used.
+     * @return The heuristic score of the position.
+     */
+    int MinimaxAI::leafScore(const Board& board, bool isMaximizing, Symbol symbol, const NeuralEval::Accumulator* accumulator) const{
+        // Both evaluations score the position for the side to move
+        const Symbol side = isMaximizing ? symbol : board.getOpponent(symbol);
+        int result = 0;
+        if (accumulator){
+            result = neuralEval->score(*accumulator, side);
+        }
+        else if (evalWeights){
+            result = evalWeights->evaluate(board, side);
+        }
+        return isMaximizing ? result : -result;
+    }
+
     /**
      * @brief Computes the score for the given board state and player symbol.
      *
@@ -13,7 +13,12 @@
 #ifndef MINIMAXAI_H
 #define MINIMAXAI_H
 
+#include <chrono>
+#include "evalweights.h"
 #include "gameai.h"
+#include "neuraleval.h"
+#include "positiondb.h"
+#include "transpositiontable.h"
 
 namespace tictactoe{
     /**
@@ -29,18 +34,128 @@ namespace tictactoe{
         /**
          * @brief Makes a move using the Minimax algorithm.
          */
-        QPoint makeMove(const Board& board, Symbol symbol) const override;
+        CellPos makeMove(const Board& board, Symbol symbol) const override;
+
+        /**
+         * @brief Scores every legal move with iterative deepening up to the AI level.
+         */
+        std::vector<MoveScore> analyze(const Board& board, Symbol symbol, const AnalysisCallback& progress = nullptr,
+            const std::atomic<bool>* stop = nullptr) const override;
+
+        /**
+         * @brief Creates a resumable search that finds the same move as makeMove.
+         */
+        std::unique_ptr<SearchTask> createSearch(const Board& board, Symbol symbol) const override;
+
+        /**
+         * @brief Gets the type of the AI.
+         */
+        inline AIType getType() const override { return AIType::Minimax; }
+
+        /**
+         * @brief Discards all cached search results.
+         */
+        void clearCaches() override;
+
+        /**
+         * @brief Resets the AI and drops its position database.
+         */
+        void reset() override;
+
+        /**
+         * @brief Sets the position database used to order root moves.
+         */
+        inline void setPositionDB(std::shared_ptr<const PositionDB> positionDB_i) override { positionDB = std::move(positionDB_i); }
+
+        /**
+         * @brief Sets the weights of the evaluation of positions at the depth limit.
+         */
+        void setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights_i) override;
+
+        /**
+         * @brief Sets the neural network scoring positions at the depth limit and ordering root moves.
+         */
+        void setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval_i) override;
 
     private:
+        friend class MinimaxSearch; // Runs the same search with an explicit stack
+
+        /**
+         * @brief Scores a single root move searched to the given depth.
+         */
+        int scoreMove(Board& board, const CellPos& move, Symbol symbol, int depth, int alpha, int beta, bool& complete) const;
+
+        /**
+         * @brief Performs the Minimax algorithm recursively with alpha-beta pruning.
+         */
+        int minimax(Board& board, int depth, bool maximizingPlayer, Symbol symbol, int alpha, int beta, bool& complete) const;
+
+        /**
+         * @brief Gets the legal moves in the order the root searches them.
+         */
+        std::vector<CellPos> rootMoves(const Board& board, Symbol symbol) const;
+
+        /**
+         * @brief Copies the position to search into the scratch board and sets up the network for it.
+         */
+        void beginSearch(const Board& board) const;
+
+        /**
+         * @brief Gets the network to use for a board, null if there is none for its size.
+         */
+        const NeuralEval* networkFor(const Board& board) const;
+
+        /**
+         * @brief Checks whether a cached score decides a node searched with the given window.
+         */
+        static bool usable(int cached, TranspositionTable::Bound bound, int alpha, int beta);
+
+        /**
+         * @brief Gets the bound a fail-soft score searched with the given window places on the true score.
+         */
+        static TranspositionTable::Bound boundOf(int score, int alpha, int beta);
+
+        /**
+         * @brief Gets the transposition table key of a position from the searching side's perspective.
+         */
+        static uint64_t nodeKey(const Board& board, bool maximizingPlayer, Symbol symbol);
+
         /**
-         * @brief Performs the Minimax algorithm recursively.
+         * @brief Clears the statistics and sizes the principal variation for a search of the given depth.
          */
-        int minimax(const Board& board, int depth, bool maximizingPlayer, Symbol symbol) const;
+        void beginStats(const Board& board, int depth) const;
+
+        /**
+         * @brief Completes the statistics of a search started at the given time.
+         */
+        void endStats(std::chrono::steady_clock::time_point start) const;
+
+        /**
+         * @brief Scores a position cut off by the depth limit for the searching side.
+         */
+        int leafScore(const Board& board, bool maximizingPlayer, Symbol symbol, const NeuralEval::Accumulator* accumulator) const;
 
         /**
          * @brief Calculates the score of the board for a given player.
          */
         int score(const Board& board, Symbol symbol) const;
+
+        /**
+         * @brief Checks whether the running analysis was asked to stop.
+         */
+        inline bool stopped() const { return stopFlag && stopFlag->load(std::memory_order_relaxed); }
+
+    private:
+        mutable TranspositionTable table; /**< Results shared between root moves and successive searches. */
+        mutable Board scratch; /**< Working copy of the searched position, reused between searches. */
+        std::shared_ptr<const PositionDB> positionDB; /**< Statistics of recorded games used for move ordering, may be null. */
+        std::shared_ptr<const EvalWeights> evalWeights; /**< Evaluation at the depth limit, null to score cut off positions as draws. */
+        std::shared_ptr<const NeuralEval> neuralEval; /**< Network preferred over the weights when it fits the board size, may be null. */
+        mutable const NeuralEval* network = nullptr; /**< Network of the current search, null if not used. */
+        mutable NeuralEval::Accumulator accumulator; /**< First layer of the network for the scratch board. */
+        mutable int rootDepth = 0; /**< Depth the root moves of the current search are searched to. */
+        mutable PVTable pvTable; /**< Principal variation of the current search. */
+        mutable const std::atomic<bool>* stopFlag = nullptr; /**< Stops the running analysis once set, null outside analyze. */
     };
 
 } // namespace tictactoe
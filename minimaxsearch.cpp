@@ -0,0 +1,194 @@
+/**
+ * @file minimaxsearch.cpp
+ * @brief Implementation file for the MinimaxSearch class.
+ *
+ * This file contains the implementation of the MinimaxSearch class, which performs the
+ * MinimaxAI search iteratively so it can be suspended after any node.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include "minimaxsearch.h"
+#include "minimaxai.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Constructs a search of the given position.
+     *
+     * @param ai_i The AI whose level and transposition table are used, must outlive the search.
+     * @param board_i The position to search, copied into the task.
+     * @param symbol_i The symbol (X or O) of the side to move.
+     */
+    MinimaxSearch::MinimaxSearch(const MinimaxAI& ai_i, const Board& board_i, Symbol symbol_i)
+        : ai(ai_i), board(board_i), symbol(symbol_i), network(ai_i.networkFor(board_i)){
+        const int level = static_cast<int>(ai.level);
+        stack.reserve(static_cast<size_t>(std::min(level, board.getSize() * board.getSize())) + 2);
+        pvTable.reset(std::min(level, board.getSize() * board.getSize()) + 1);
+
+        if (network){
+            network->refresh(board, accumulator);
+        }
+
+        for (const CellPos& move : ai.rootMoves(board, symbol)){
+            rootOrder.push_back(move.y * board.getSize() + move.x);
+        }
+
+        // The root is one level above its children, which are searched to the AI level
+        const int lowest = -std::numeric_limits<int>::max();
+        const int highest = std::numeric_limits<int>::max();
+        stack.push_back({ level + 1, true, true, 0, lowest, lowest, highest, lowest, highest, -1, 0 });
+    }
+
+    /**
+     * @brief Advances the search by at most the given number of nodes.
+     *
+     * @param maxNodes The maximum number of nodes to visit in this step.
+     * @return true once the search has finished, false otherwise.
+     */
+    bool MinimaxSearch::step(int maxNodes){
+        const int size = board.getSize();
+        const int cells = size * size;
+        const auto start = std::chrono::steady_clock::now();
+
+        while (!finished && maxNodes > 0){
+            Frame& frame = stack.back();
+
+            if (stack.size() == 1){
+                // The root visits its moves in the order of makeMove
+                if (frame.nextCell >= static_cast<int>(rootOrder.size())){
+                    finished = true;
+                    stats.pv = pvTable.getLine();
+                    stats.score = frame.bestScore;
+                    break;
+                }
+            }
+            else{
+                // Find the next empty cell of the current node
+                while (frame.nextCell < cells && !board.isEmpty(CellPos{ frame.nextCell % size, frame.nextCell / size })){
+                    frame.nextCell++;
+                }
+
+                if (frame.nextCell >= cells){
+                    // All children searched or the rest pruned
+                    ai.table.store(frame.key, frame.depth, frame.bestScore,
+                        MinimaxAI::boundOf(frame.bestScore, frame.alphaOrig, frame.betaOrig), frame.complete);
+                    leave(frame.bestScore, frame.complete);
+                    continue;
+                }
+            }
+
+            const int cell = (stack.size() == 1) ? rootOrder[frame.nextCell++] : frame.nextCell++;
+            const int depth = frame.depth - 1;
+            const bool isMaximizing = !frame.isMaximizing;
+            const Symbol mover = frame.isMaximizing ? symbol : board.getOpponent(symbol);
+            board.makeMove(CellPos{ cell % size, cell / size }, mover);
+            if (network){
+                network->addMove(accumulator, CellPos{ cell % size, cell / size }, mover);
+            }
+            stack.push_back({ depth, isMaximizing, true, 0, 0, frame.alpha, frame.beta, frame.alpha, frame.beta, cell, 0 });
+            nodes++;
+            maxNodes--;
+            const int ply = static_cast<int>(stack.size()) - 1;
+            pvTable.clear(ply);
+            stats.maxDepth = std::max(stats.maxDepth, ply);
+            enter();
+        }
+
+        stats.nodes = nodes;
+        stats.elapsedNsec += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        return finished;
+    }
+
+    /**
+     * @brief Evaluates the node just pushed, resolving it at once if it is a leaf.
+     *
+     * Mirrors the checks at the start of MinimaxAI::minimax.
+     */
+    void MinimaxSearch::enter(){
+        Frame& frame = stack.back();
+        frame.key = MinimaxAI::nodeKey(board, frame.isMaximizing, symbol);
+
+        int cached = 0;
+        TranspositionTable::Bound bound = TranspositionTable::Bound::Exact;
+        bool cachedComplete = true;
+        if (ai.table.probe(frame.key, frame.depth, cached, bound, cachedComplete) && MinimaxAI::usable(cached, bound, frame.alpha, frame.beta)){
+            stats.cacheHits++;
+            leave(cached, cachedComplete);
+            return;
+        }
+        stats.cacheMisses++;
+
+        Symbol winner = board.checkForWinner();
+        if (Symbol::None != winner){
+            int result = ai.score(board, symbol);
+            ai.table.store(frame.key, frame.depth, result, TranspositionTable::Bound::Exact, true);
+            leave(result, true);
+            return;
+        }
+
+        if (board.isBoardFull()){
+            ai.table.store(frame.key, frame.depth, 0, TranspositionTable::Bound::Exact, true);
+            leave(0, true); // Tie game
+            return;
+        }
+
+        if (0 == frame.depth){
+            stats.leafEvals++;
+            leave(ai.leafScore(board, frame.isMaximizing, symbol, network ? &accumulator : nullptr), false);
+            return;
+        }
+
+        frame.bestScore = frame.isMaximizing ? -std::numeric_limits<int>::max() : std::numeric_limits<int>::max();
+    }
+
+    /**
+     * @brief Pops the top node and passes its result to its parent.
+     *
+     * @param result The score of the node.
+     * @param complete false if the node's subtree was cut off by the depth limit.
+     */
+    void MinimaxSearch::leave(int result, bool complete){
+        const int size = board.getSize();
+        const int cell = stack.back().cell;
+        stack.pop_back();
+        if (network){
+            network->removeMove(accumulator, CellPos{ cell % size, cell / size }, board.getSymbol(CellPos{ cell % size, cell / size }));
+        }
+        board.undoMove(CellPos{ cell % size, cell / size });
+
+        Frame& parent = stack.back();
+        const int parentPly = static_cast<int>(stack.size()) - 1;
+        parent.complete = parent.complete && complete;
+        if (stack.size() == 1){
+            // Root, keep the first move with the best score like makeMove
+            if (result > parent.bestScore){
+                parent.bestScore = result;
+                parent.alpha = result;
+                bestMove = CellPos{ cell % size, cell / size };
+                pvTable.update(parentPly, bestMove);
+            }
+            return;
+        }
+        if (parent.isMaximizing ? result > parent.bestScore : result < parent.bestScore){
+            parent.bestScore = result;
+            pvTable.update(parentPly, CellPos{ cell % size, cell / size });
+        }
+        if (parent.isMaximizing){
+            parent.alpha = std::max(parent.alpha, result);
+        }
+        else{
+            parent.beta = std::min(parent.beta, result);
+        }
+        if (parent.alpha >= parent.beta){
+            stats.cutoffs++;
+            parent.nextCell = size * size; // The remaining moves can not change the result
+        }
+    }
+
+} // namespace tictactoe
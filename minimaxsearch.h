@@ -0,0 +1,85 @@
+/**
+ * @file minimaxsearch.h
+ * @brief Header file for the MinimaxSearch class.
+ *
+ * This file contains the declaration of the MinimaxSearch class, a resumable version of the
+ * MinimaxAI search that keeps its own explicit stack instead of recursing.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef MINIMAXSEARCH_H
+#define MINIMAXSEARCH_H
+
+#include <vector>
+#include "searchtask.h"
+#include "board.h"
+#include "neuraleval.h"
+
+namespace tictactoe{
+
+    class MinimaxAI;
+
+    /**
+     * @brief The MinimaxSearch class runs the MinimaxAI search in bounded steps.
+     *
+     * Moves are visited in the same order, pruned with the same windows and tie-broken the same
+     * way as MinimaxAI::makeMove, so the task finds exactly the same move.
+     */
+    class MinimaxSearch : public SearchTask{
+    public:
+        /**
+         * @brief Constructs a search of the given position.
+         */
+        MinimaxSearch(const MinimaxAI& ai_i, const Board& board_i, Symbol symbol_i);
+
+        /**
+         * @brief Advances the search by at most the given number of nodes.
+         */
+        bool step(int maxNodes) override;
+
+    private:
+        /**
+         * @brief A node of the search on the explicit stack.
+         */
+        struct Frame{
+            int depth; /**< Remaining depth of the node. */
+            bool isMaximizing; /**< Whether the searching side is to move. */
+            bool complete; /**< Cleared if the subtree was cut off by the depth limit. */
+            int nextCell; /**< Row-major index of the next cell to try. */
+            int bestScore; /**< Best score of the children searched so far. */
+            int alpha; /**< Score the maximizing side is assured of, raised by the children. */
+            int beta; /**< Score the minimizing side is assured of, lowered by the children. */
+            int alphaOrig; /**< Alpha the node was entered with. */
+            int betaOrig; /**< Beta the node was entered with. */
+            int cell; /**< Row-major index of the move leading to the node. */
+            uint64_t key; /**< Transposition table key of the node. */
+        };
+
+        /**
+         * @brief Evaluates the node just pushed, resolving it at once if it is a leaf.
+         */
+        void enter();
+
+        /**
+         * @brief Pops the top node and passes its result to its parent.
+         */
+        void leave(int result, bool complete);
+
+    private:
+        const MinimaxAI& ai; // The AI whose settings and table are used
+        Board board; // Working copy of the position, moves are made and taken back
+        Symbol symbol; // The side searching for a move
+        std::vector<Frame> stack; // The path from the root to the current node
+        std::vector<int> rootOrder; // Row-major indices of the root moves in the order makeMove searches them
+        const NeuralEval* network; // The AI's network if it scores this board, null otherwise
+        NeuralEval::Accumulator accumulator; // First layer of the network for the working board
+        PVTable pvTable; // Principal variation, plies are stack indices
+    };
+
+} // namespace tictactoe
+
+#endif // MINIMAXSEARCH_H
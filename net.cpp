@@ -0,0 +1,529 @@
+/**
+ * @file net.cpp
+ * @brief Implementation file for the neural network tool.
+ *
+ * This file contains a command line tool that trains the network of NeuralEval on recorded
+ * games, measures its inference speed and shows its output for a position. Training runs in
+ * floating point with the clipping of the quantized network, so the int8 network computes
+ * nearly the same function; every position before a move of a finished game is a sample, in a
+ * random one of its eight symmetries, with the result for the side to move as the value target
+ * and the move played as the policy target, weighted by how well the mover did.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "gamerecord.h"
+#include "neuraleval.h"
+#include "notation.h"
+#include "positiondb.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    const int H1 = NeuralEval::HIDDEN1;
+    const int H2 = NeuralEval::HIDDEN2;
+
+    /**
+     * @brief Settings of a training run.
+     */
+    struct TrainConfig{
+        const char* output = nullptr;
+        std::vector<std::string> inputs;
+        int size = DEFAULT_BOARD_SIZE;
+        int epochs = 20;
+        double rate = 0.01;
+        unsigned seed = 1;
+    };
+
+    /**
+     * @brief A position of a recorded game seen by the side to move.
+     */
+    struct Sample{
+        std::vector<int8_t> cells; // 1 for the side to move, -1 for the opponent, 0 empty, row-major
+        int move; // Row-major cell played
+        float label; // Result for the side to move, 1 win, 0.5 draw, 0 loss
+    };
+
+    /**
+     * @brief Intermediate values of a forward pass kept for the backward pass.
+     */
+    struct Pass{
+        std::vector<int> inputs; // Active inputs, own plane then opponent plane
+        float z1[H1], a1[H1], z2[H2], a2[H2];
+        float value; // Log odds of the side to move winning
+        std::vector<float> logits; // Policy logits, one per cell
+    };
+
+    inline float clipped(float x){
+        return std::min(std::max(x, 0.0f), 1.0f);
+    }
+
+    inline float slope(float z){
+        return (z > 0.0f && z < 1.0f) ? 1.0f : 0.0f;
+    }
+
+    inline float sigmoid(float x){
+        return 1.0f / (1.0f + std::exp(-x));
+    }
+
+    /**
+     * @brief Reads the positions of the finished games of the board size.
+     */
+    bool loadSamples(const TrainConfig& config, std::vector<Sample>& samples){
+        const int cells = config.size * config.size;
+        GameRecord record;
+        for (const std::string& input : config.inputs){
+            GameRecordReader reader;
+            if (!reader.open(input)){
+                return false;
+            }
+            for (size_t game = 0; game < reader.getGameCount(); game++){
+                if (!reader.readGame(game, record) || !record.finished || record.size != config.size){
+                    continue;
+                }
+                Board board(config.size);
+                Symbol mover = record.firstMover;
+                for (const RecordedMove& move : record.moves){
+                    Sample sample;
+                    sample.cells.resize(static_cast<size_t>(cells));
+                    for (int cell = 0; cell < cells; cell++){
+                        const Symbol symbol = board.getSymbol(CellPos{ cell % config.size, cell / config.size });
+                        sample.cells[static_cast<size_t>(cell)] = static_cast<int8_t>((Symbol::None == symbol) ? 0 : (mover == symbol) ? 1 : -1);
+                    }
+                    sample.move = move.pos.y * config.size + move.pos.x;
+                    sample.label = (Symbol::None == record.winner) ? 0.5f : (mover == record.winner) ? 1.0f : 0.0f;
+                    if (!board.makeMove(move.pos, mover)){
+                        break;
+                    }
+                    samples.push_back(std::move(sample));
+                    mover = board.getOpponent(mover);
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Runs the float network on a sample in the given symmetry.
+     */
+    void forward(const NeuralEval::FloatWeights& w, const Sample& sample, int symmetry, Pass& pass, int& move){
+        const int size = w.size;
+        const int cells = size * size;
+        pass.inputs.clear();
+        for (int cell = 0; cell < cells; cell++){
+            const int8_t occupant = sample.cells[static_cast<size_t>(cell)];
+            if (0 != occupant){
+                const CellPos pos = PositionDB::transformCell(CellPos{ cell % size, cell / size }, size, symmetry);
+                pass.inputs.push_back((occupant > 0 ? 0 : cells) + pos.y * size + pos.x);
+            }
+        }
+        const CellPos played = PositionDB::transformCell(CellPos{ sample.move % size, sample.move / size }, size, symmetry);
+        move = played.y * size + played.x;
+
+        for (int j = 0; j < H1; j++){
+            pass.z1[j] = w.b1[static_cast<size_t>(j)];
+        }
+        for (int input : pass.inputs){
+            const float* row = &w.w1[static_cast<size_t>(input * H1)];
+            for (int j = 0; j < H1; j++){
+                pass.z1[j] += row[j];
+            }
+        }
+        for (int j = 0; j < H1; j++){
+            pass.a1[j] = clipped(pass.z1[j]);
+        }
+        for (int k = 0; k < H2; k++){
+            float sum = w.b2[static_cast<size_t>(k)];
+            for (int j = 0; j < H1; j++){
+                sum += w.w2[static_cast<size_t>(k * H1 + j)] * pass.a1[j];
+            }
+            pass.z2[k] = sum;
+            pass.a2[k] = clipped(sum);
+        }
+        pass.value = w.b3;
+        for (int k = 0; k < H2; k++){
+            pass.value += w.w3[static_cast<size_t>(k)] * pass.a2[k];
+        }
+        pass.logits.resize(static_cast<size_t>(cells));
+        for (int c = 0; c < cells; c++){
+            float sum = w.bp[static_cast<size_t>(c)];
+            for (int k = 0; k < H2; k++){
+                sum += w.wp[static_cast<size_t>(c * H2 + k)] * pass.a2[k];
+            }
+            pass.logits[static_cast<size_t>(c)] = sum;
+        }
+    }
+
+    /**
+     * @brief Takes one gradient step on a sample and returns its value loss.
+     */
+    double trainSample(NeuralEval::FloatWeights& w, const Sample& sample, int symmetry, float rate, Pass& pass){
+        const int cells = w.size * w.size;
+        int move = 0;
+        forward(w, sample, symmetry, pass, move);
+
+        // Value head, binary cross-entropy on the result
+        const float p = sigmoid(pass.value);
+        const float dValue = p - sample.label;
+        const double loss = -(sample.label * std::log(std::max(p, 1e-7f)) + (1.0f - sample.label) * std::log(std::max(1.0f - p, 1e-7f)));
+
+        // Policy head, cross-entropy of the softmax over empty cells on the move played
+        std::vector<bool> empty(static_cast<size_t>(cells), true);
+        for (int input : pass.inputs){
+            empty[static_cast<size_t>(input % cells)] = false;
+        }
+        float highest = -1e30f;
+        for (int c = 0; c < cells; c++){
+            if (empty[static_cast<size_t>(c)]){
+                highest = std::max(highest, pass.logits[static_cast<size_t>(c)]);
+            }
+        }
+        std::vector<float> dLogits(static_cast<size_t>(cells), 0.0f);
+        float total = 0.0f;
+        for (int c = 0; c < cells; c++){
+            if (empty[static_cast<size_t>(c)]){
+                dLogits[static_cast<size_t>(c)] = std::exp(pass.logits[static_cast<size_t>(c)] - highest);
+                total += dLogits[static_cast<size_t>(c)];
+            }
+        }
+        for (int c = 0; c < cells; c++){
+            dLogits[static_cast<size_t>(c)] = sample.label * (dLogits[static_cast<size_t>(c)] / total - ((c == move) ? 1.0f : 0.0f));
+        }
+
+        // Back through the second layer
+        float dA2[H2];
+        for (int k = 0; k < H2; k++){
+            dA2[k] = dValue * w.w3[static_cast<size_t>(k)];
+            for (int c = 0; c < cells; c++){
+                dA2[k] += dLogits[static_cast<size_t>(c)] * w.wp[static_cast<size_t>(c * H2 + k)];
+            }
+        }
+        float dZ2[H2];
+        for (int k = 0; k < H2; k++){
+            dZ2[k] = dA2[k] * slope(pass.z2[k]);
+        }
+        float dZ1[H1];
+        for (int j = 0; j < H1; j++){
+            float sum = 0.0f;
+            for (int k = 0; k < H2; k++){
+                sum += dZ2[k] * w.w2[static_cast<size_t>(k * H1 + j)];
+            }
+            dZ1[j] = sum * slope(pass.z1[j]);
+        }
+
+        // Update, keeping every weight within the range the quantized network can represent
+        const float limit1 = 1.0f;
+        const float limit = 127.0f / NeuralEval::WEIGHT_SCALE;
+        auto step = [rate](float& weight, float gradient, float bound){
+            weight = std::min(std::max(weight - rate * gradient, -bound), bound);
+        };
+        w.b3 -= rate * dValue;
+        for (int k = 0; k < H2; k++){
+            step(w.w3[static_cast<size_t>(k)], dValue * pass.a2[k], limit);
+        }
+        for (int c = 0; c < cells; c++){
+            const float d = dLogits[static_cast<size_t>(c)];
+            if (0.0f == d){
+                continue;
+            }
+            w.bp[static_cast<size_t>(c)] -= rate * d;
+            for (int k = 0; k < H2; k++){
+                step(w.wp[static_cast<size_t>(c * H2 + k)], d * pass.a2[k], limit);
+            }
+        }
+        for (int k = 0; k < H2; k++){
+            w.b2[static_cast<size_t>(k)] -= rate * dZ2[k];
+            for (int j = 0; j < H1; j++){
+                step(w.w2[static_cast<size_t>(k * H1 + j)], dZ2[k] * pass.a1[j], limit);
+            }
+        }
+        for (int j = 0; j < H1; j++){
+            step(w.b1[static_cast<size_t>(j)], dZ1[j], limit1);
+        }
+        for (int input : pass.inputs){
+            float* row = &w.w1[static_cast<size_t>(input * H1)];
+            for (int j = 0; j < H1; j++){
+                step(row[j], dZ1[j], limit1);
+            }
+        }
+        return loss;
+    }
+
+    /**
+     * @brief Gets the accumulator of a sample position for the int8 network.
+     */
+    Symbol samplePosition(const NeuralEval& net, const Sample& sample, NeuralEval::Accumulator& accumulator){
+        const int size = net.getSize();
+        Board board(size);
+        // X always moves first in the network's view, the sample is seen by the side to move
+        for (int cell = 0; cell < size * size; cell++){
+            const int8_t occupant = sample.cells[static_cast<size_t>(cell)];
+            if (0 != occupant){
+                board.makeMove(CellPos{ cell % size, cell / size }, occupant > 0 ? Symbol::X : Symbol::O);
+            }
+        }
+        net.refresh(board, accumulator);
+        return Symbol::X;
+    }
+
+    int train(const TrainConfig& config){
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Sample> samples;
+        if (!loadSamples(config, samples)){
+            return 1;
+        }
+        if (samples.empty()){
+            std::fprintf(stderr, "no finished games of size %d\n", config.size);
+            return 1;
+        }
+        std::printf("samples      %zu positions\n", samples.size());
+
+        const int cells = config.size * config.size;
+        std::mt19937 random(config.seed);
+        auto init = [&random](std::vector<float>& values, size_t count, float spread){
+            std::uniform_real_distribution<float> uniform(-spread, spread);
+            values.resize(count);
+            for (float& value : values){
+                value = uniform(random);
+            }
+        };
+        NeuralEval::FloatWeights w;
+        w.size = config.size;
+        init(w.w1, static_cast<size_t>(2 * cells * H1), 0.25f);
+        w.b1.assign(H1, 0.25f);
+        init(w.w2, H2 * H1, 1.0f / std::sqrt(static_cast<float>(H1)));
+        w.b2.assign(H2, 0.25f);
+        init(w.w3, H2, 1.0f / std::sqrt(static_cast<float>(H2)));
+        init(w.wp, static_cast<size_t>(cells * H2), 1.0f / std::sqrt(static_cast<float>(H2)));
+        w.bp.assign(static_cast<size_t>(cells), 0.0f);
+
+        std::vector<size_t> order(samples.size());
+        for (size_t i = 0; i < order.size(); i++){
+            order[i] = i;
+        }
+        std::uniform_int_distribution<int> symmetries(0, PositionDB::SYMMETRY_COUNT - 1);
+        Pass pass;
+        for (int epoch = 1; epoch <= config.epochs; epoch++){
+            std::shuffle(order.begin(), order.end(), random);
+            // Decay the rate linearly to a tenth over the run
+            const float rate = static_cast<float>(config.rate * (1.0 - 0.9 * (epoch - 1) / std::max(1, config.epochs - 1)));
+            double loss = 0.0;
+            for (size_t index : order){
+                loss += trainSample(w, samples[index], symmetries(random), rate, pass);
+            }
+            std::printf("epoch %-6d value loss %.6f\n", epoch, loss / static_cast<double>(samples.size()));
+        }
+
+        NeuralEval net;
+        if (!net.quantize(w)){
+            return 1;
+        }
+
+        // Quantization error of the value head over the training positions
+        double error = 0.0;
+        const size_t checked = std::min<size_t>(samples.size(), 10000);
+        NeuralEval::Accumulator accumulator;
+        for (size_t i = 0; i < checked; i++){
+            int move = 0;
+            forward(w, samples[i], 0, pass, move);
+            const Symbol side = samplePosition(net, samples[i], accumulator);
+            error += std::fabs(sigmoid(net.evaluate(accumulator, side)) - sigmoid(pass.value));
+        }
+        std::printf("quantization mean win probability error %.5f\n", error / static_cast<double>(checked));
+
+        if (!net.save(config.output)){
+            return 1;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("trained in %.3f s\n", seconds);
+        return 0;
+    }
+
+    /**
+     * @brief Measures evaluations per second of a network on random positions.
+     */
+    int bench(const NeuralEval& net, int batch){
+        const int size = net.getSize();
+        std::mt19937 random(1);
+        std::vector<NeuralEval::Accumulator> accumulators(static_cast<size_t>(batch));
+        std::vector<Symbol> sides(static_cast<size_t>(batch));
+        std::vector<float> values(static_cast<size_t>(batch));
+        std::vector<CellPos> lastMoves(static_cast<size_t>(batch));
+        for (int i = 0; i < batch; i++){
+            Board board(size);
+            Symbol mover = Symbol::X;
+            const int plies = std::uniform_int_distribution<int>(1, size * size - 1)(random);
+            for (int ply = 0; ply < plies; ply++){
+                CellPos pos{ 0, 0 };
+                do{
+                    pos = CellPos{ static_cast<int>(random() % static_cast<unsigned>(size)), static_cast<int>(random() % static_cast<unsigned>(size)) };
+                } while (!board.isEmpty(pos));
+                board.makeMove(pos, mover);
+                lastMoves[static_cast<size_t>(i)] = pos;
+                mover = board.getOpponent(mover);
+            }
+            net.refresh(board, accumulators[static_cast<size_t>(i)]);
+            sides[static_cast<size_t>(i)] = mover;
+        }
+
+        std::printf("kernel       %s\n", NeuralEval::getKernelName());
+        const long long target = 5000000;
+        const int rounds = static_cast<int>(std::max<long long>(1, target / batch));
+        double checksum = 0.0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++){
+            net.evaluateBatch(accumulators.data(), sides.data(), accumulators.size(), values.data());
+            checksum += values[static_cast<size_t>(round % batch)];
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("batched      %.0f evals/s (batch %d)\n", static_cast<double>(rounds) * batch / seconds, batch);
+
+        // One evaluation per take back and replay of the last move, as a search does at its leaves
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++){
+            for (size_t i = 0; i < accumulators.size(); i++){
+                const Symbol mover = (Symbol::X == sides[i]) ? Symbol::O : Symbol::X;
+                net.removeMove(accumulators[i], lastMoves[i], mover);
+                net.addMove(accumulators[i], lastMoves[i], mover);
+                checksum += net.evaluate(accumulators[i], sides[i]);
+            }
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("incremental  %.0f evals/s\n", static_cast<double>(rounds) * batch / seconds);
+        std::printf("checksum     %.3f\n", checksum);
+        return 0;
+    }
+
+    /**
+     * @brief Prints the value and the policy of the network for a position.
+     */
+    int evaluatePosition(const NeuralEval& net, const std::vector<CellPos>& moves){
+        const int size = net.getSize();
+        Board board(size);
+        Symbol mover = Symbol::X;
+        for (const CellPos& move : moves){
+            if (!board.makeMove(move, mover)){
+                std::fprintf(stderr, "illegal move %s\n", toNotation(move).c_str());
+                return 1;
+            }
+            mover = board.getOpponent(mover);
+        }
+        NeuralEval::Accumulator accumulator;
+        net.refresh(board, accumulator);
+        const float value = net.evaluate(accumulator, mover);
+        std::printf("win          %.3f for %c (score %d)\n", sigmoid(value), (Symbol::X == mover) ? 'X' : 'O', net.score(accumulator, mover));
+        std::vector<float> priors(static_cast<size_t>(size * size));
+        net.policy(board, accumulator, mover, priors.data());
+        for (int cell = 0; cell < size * size; cell++){
+            if (board.isEmpty(CellPos{ cell % size, cell / size })){
+                std::printf("%-12s %.3f\n", toNotation(CellPos{ cell % size, cell / size }).c_str(), priors[static_cast<size_t>(cell)]);
+            }
+        }
+        return 0;
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s train OUT RECORDS... [options]\n"
+            "       %s bench NET [--batch N]\n"
+            "       %s eval NET [MOVES...]\n"
+            "  --size N     board size to train (default %d)\n"
+            "  --epochs N   passes over the positions (default 20)\n"
+            "  --rate X     initial learning rate (default 0.01)\n"
+            "  --seed N     seed of the initial weights and sample order (default 1)\n"
+            "  --batch N    positions per batch of the benchmark (default 256)\n",
+            program, program, program, DEFAULT_BOARD_SIZE);
+    }
+
+    bool parseTrain(int argc, char* argv[], TrainConfig& config){
+        config.output = argv[2];
+        for (int i = 3; i < argc; i++){
+            const char* arg = argv[i];
+            if (0 != std::strncmp(arg, "--", 2)){
+                config.inputs.push_back(arg);
+                continue;
+            }
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--size")){
+                config.size = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--epochs")){
+                config.epochs = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--rate")){
+                config.rate = std::atof(value);
+            }
+            else if (0 == std::strcmp(arg, "--seed")){
+                config.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            }
+            else{
+                return false;
+            }
+        }
+        return !config.inputs.empty() && config.size >= 2 && config.size <= NeuralEval::MAX_SIZE && config.epochs > 0 && config.rate > 0.0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the neural network tool.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc >= 4 && 0 == std::strcmp(argv[1], "train")){
+        TrainConfig config;
+        if (!parseTrain(argc, argv, config)){
+            printUsage(argv[0]);
+            return 1;
+        }
+        return train(config);
+    }
+    if (argc >= 3 && (0 == std::strcmp(argv[1], "bench") || 0 == std::strcmp(argv[1], "eval"))){
+        NeuralEval net;
+        if (!net.load(argv[2])){
+            return 1;
+        }
+        if (0 == std::strcmp(argv[1], "bench")){
+            int batch = 256;
+            if (argc >= 5 && 0 == std::strcmp(argv[3], "--batch")){
+                batch = std::atoi(argv[4]);
+            }
+            if (batch <= 0){
+                printUsage(argv[0]);
+                return 1;
+            }
+            return bench(net, batch);
+        }
+        std::string text;
+        for (int i = 3; i < argc; i++){
+            text += std::string(argv[i]) + " ";
+        }
+        std::vector<CellPos> moves;
+        if (!parseMoveList(text, moves)){
+            printUsage(argv[0]);
+            return 1;
+        }
+        return evaluatePosition(net, moves);
+    }
+    printUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,446 @@
+/**
+ * @file neuraleval.cpp
+ * @brief Implementation file for the NeuralEval class.
+ *
+ * This file contains the quantization, file format, accumulator updates and inference of the
+ * neural network evaluator, with its AVX2, SSSE3 and portable dot product kernels.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "neuraleval.h"
+#include "evalweights.h"
+#include "logger.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NEURALEVAL_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace tictactoe{
+
+    namespace {
+
+        const uint8_t MAGIC[4] = { 'T', 'T', 'T', 'N' };
+
+        const int INPUTS = NeuralEval::HIDDEN1; // Inputs of every int8 layer
+        static_assert(NeuralEval::HIDDEN1 == NeuralEval::HIDDEN2, "the int8 kernels take 32 inputs");
+        static_assert(32 == INPUTS, "the int8 kernels take 32 inputs");
+
+        /**
+         * @brief Computes output[r] = bias[r] + sum of input[i] * weights[r * 32 + i] for every row.
+         */
+        using AffineKernel = void (*)(const uint8_t* input, const int8_t* weights, const int32_t* bias, int rows, int32_t* output);
+
+        void affineScalar(const uint8_t* input, const int8_t* weights, const int32_t* bias, int rows, int32_t* output){
+            for (int row = 0; row < rows; row++){
+                int32_t sum = bias[row];
+                const int8_t* rowWeights = weights + row * INPUTS;
+                for (int i = 0; i < INPUTS; i++){
+                    sum += static_cast<int32_t>(input[i]) * rowWeights[i];
+                }
+                output[row] = sum;
+            }
+        }
+
+#if defined(NEURALEVAL_X86_DISPATCH)
+        // Products of activations up to 127 and weights in [-127, 127] summed in pairs fit the
+        // saturating int16 of maddubs, so the kernels give exactly the scalar result.
+
+        __attribute__((target("ssse3")))
+        inline __m128i rowSumsSsse3(__m128i in0, __m128i in1, const int8_t* rowWeights){
+            const __m128i ones = _mm_set1_epi16(1);
+            const __m128i lo = _mm_maddubs_epi16(in0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowWeights)));
+            const __m128i hi = _mm_maddubs_epi16(in1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowWeights + 16)));
+            return _mm_add_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones));
+        }
+
+        __attribute__((target("ssse3")))
+        void affineSsse3(const uint8_t* input, const int8_t* weights, const int32_t* bias, int rows, int32_t* output){
+            const __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+            const __m128i in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16));
+            int row = 0;
+            for (; row + 4 <= rows; row += 4){
+                const __m128i s01 = _mm_hadd_epi32(rowSumsSsse3(in0, in1, weights + row * INPUTS), rowSumsSsse3(in0, in1, weights + (row + 1) * INPUTS));
+                const __m128i s23 = _mm_hadd_epi32(rowSumsSsse3(in0, in1, weights + (row + 2) * INPUTS), rowSumsSsse3(in0, in1, weights + (row + 3) * INPUTS));
+                const __m128i sums = _mm_add_epi32(_mm_hadd_epi32(s01, s23), _mm_loadu_si128(reinterpret_cast<const __m128i*>(bias + row)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + row), sums);
+            }
+            for (; row < rows; row++){
+                __m128i sums = rowSumsSsse3(in0, in1, weights + row * INPUTS);
+                sums = _mm_hadd_epi32(sums, sums);
+                sums = _mm_hadd_epi32(sums, sums);
+                output[row] = bias[row] + _mm_cvtsi128_si32(sums);
+            }
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i rowSumsAvx2(__m256i in, const int8_t* rowWeights){
+            const __m256i products = _mm256_maddubs_epi16(in, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowWeights)));
+            return _mm256_madd_epi16(products, _mm256_set1_epi16(1));
+        }
+
+        __attribute__((target("avx2")))
+        void affineAvx2(const uint8_t* input, const int8_t* weights, const int32_t* bias, int rows, int32_t* output){
+            const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+            int row = 0;
+            for (; row + 4 <= rows; row += 4){
+                // Each 128 bit half ends up with a partial sum of the four rows, added at the end
+                const __m256i s01 = _mm256_hadd_epi32(rowSumsAvx2(in, weights + row * INPUTS), rowSumsAvx2(in, weights + (row + 1) * INPUTS));
+                const __m256i s23 = _mm256_hadd_epi32(rowSumsAvx2(in, weights + (row + 2) * INPUTS), rowSumsAvx2(in, weights + (row + 3) * INPUTS));
+                const __m256i s0123 = _mm256_hadd_epi32(s01, s23);
+                const __m128i sums = _mm_add_epi32(_mm_add_epi32(_mm256_castsi256_si128(s0123), _mm256_extracti128_si256(s0123, 1)),
+                                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(bias + row)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + row), sums);
+            }
+            for (; row < rows; row++){
+                const __m256i sums = rowSumsAvx2(in, weights + row * INPUTS);
+                __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+                half = _mm_hadd_epi32(half, half);
+                half = _mm_hadd_epi32(half, half);
+                output[row] = bias[row] + _mm_cvtsi128_si32(half);
+            }
+        }
+#endif
+
+        struct Kernel{
+            AffineKernel affine;
+            const char* name;
+        };
+
+        Kernel selectKernel(){
+#if defined(NEURALEVAL_X86_DISPATCH)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")){
+                return { affineAvx2, "avx2" };
+            }
+            if (__builtin_cpu_supports("ssse3")){
+                return { affineSsse3, "ssse3" };
+            }
+#endif
+            return { affineScalar, "scalar" };
+        }
+
+        const Kernel& kernel(){
+            static const Kernel selected = selectKernel();
+            return selected;
+        }
+
+        template <typename T>
+        T quantizeValue(float value, float scale, long long limit){
+            const long long rounded = std::llround(static_cast<double>(value) * scale);
+            return static_cast<T>(std::min(std::max(rounded, -limit), limit));
+        }
+
+        inline uint8_t clipActivation(int32_t value){
+            return static_cast<uint8_t>(std::min(std::max(value, 0), NeuralEval::ACTIVATION_SCALE));
+        }
+
+        const float OUTPUT_SCALE = static_cast<float>(NeuralEval::ACTIVATION_SCALE * NeuralEval::WEIGHT_SCALE);
+
+    } // namespace
+
+    /**
+     * @brief Constructor for the NeuralEval class.
+     */
+    NeuralEval::NeuralEval() : size(0), cells(0), b1{}, w2{}, b2{}, w3{}, b3(0) {}
+
+    /**
+     * @brief Reads the weights of a network file.
+     *
+     * @param path The file path.
+     * @return true on success, false if the file cannot be read or is not a network file.
+     */
+    bool NeuralEval::load(const std::string& path){
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file){
+            LOG_ERROR("Cannot open network file " + path);
+            return false;
+        }
+        uint8_t header[8] = {};
+        bool ok = 1 == std::fread(header, sizeof(header), 1, file) && 0 == std::memcmp(header, MAGIC, sizeof(MAGIC))
+            && VERSION == header[4] && header[5] >= 2 && header[5] <= MAX_SIZE && HIDDEN1 == header[6] && HIDDEN2 == header[7];
+        if (ok){
+            size = header[5];
+            cells = size * size;
+            w1.assign(static_cast<size_t>(2 * cells * HIDDEN1), 0);
+            wp.assign(static_cast<size_t>(cells * HIDDEN2), 0);
+            bp.assign(static_cast<size_t>(cells), 0);
+            ok = w1.size() == std::fread(w1.data(), sizeof(int16_t), w1.size(), file)
+                && HIDDEN1 == std::fread(b1, sizeof(int16_t), HIDDEN1, file)
+                && HIDDEN2 * HIDDEN1 == std::fread(w2, sizeof(int8_t), HIDDEN2 * HIDDEN1, file)
+                && HIDDEN2 == std::fread(b2, sizeof(int32_t), HIDDEN2, file)
+                && HIDDEN2 == std::fread(w3, sizeof(int8_t), HIDDEN2, file)
+                && 1 == std::fread(&b3, sizeof(int32_t), 1, file)
+                && wp.size() == std::fread(wp.data(), sizeof(int8_t), wp.size(), file)
+                && bp.size() == std::fread(bp.data(), sizeof(int32_t), bp.size(), file);
+        }
+        std::fclose(file);
+        if (!ok){
+            LOG_ERROR("Not a network file " + path);
+            size = 0;
+            cells = 0;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Writes the weights to a network file.
+     *
+     * @param path The file path, an existing file is replaced.
+     * @return true on success, false if there are no weights or the file cannot be written.
+     */
+    bool NeuralEval::save(const std::string& path) const{
+        if (0 == size){
+            LOG_ERROR("Network has no weights");
+            return false;
+        }
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file){
+            LOG_ERROR("Cannot create network file " + path);
+            return false;
+        }
+        const uint8_t header[8] = { MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3], VERSION,
+                                    static_cast<uint8_t>(size), static_cast<uint8_t>(HIDDEN1), static_cast<uint8_t>(HIDDEN2) };
+        bool ok = 1 == std::fwrite(header, sizeof(header), 1, file)
+            && w1.size() == std::fwrite(w1.data(), sizeof(int16_t), w1.size(), file)
+            && HIDDEN1 == std::fwrite(b1, sizeof(int16_t), HIDDEN1, file)
+            && HIDDEN2 * HIDDEN1 == std::fwrite(w2, sizeof(int8_t), HIDDEN2 * HIDDEN1, file)
+            && HIDDEN2 == std::fwrite(b2, sizeof(int32_t), HIDDEN2, file)
+            && HIDDEN2 == std::fwrite(w3, sizeof(int8_t), HIDDEN2, file)
+            && 1 == std::fwrite(&b3, sizeof(int32_t), 1, file)
+            && wp.size() == std::fwrite(wp.data(), sizeof(int8_t), wp.size(), file)
+            && bp.size() == std::fwrite(bp.data(), sizeof(int32_t), bp.size(), file);
+        ok = (0 == std::fclose(file)) && ok;
+        if (!ok){
+            LOG_ERROR("Cannot write network file " + path);
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Sets the weights from unquantized ones, clipping them to the int ranges.
+     *
+     * First layer weights and biases are clipped to [-1, 1], so a full board of the largest
+     * size still sums within int16, and the weights of the later layers to [-127/64, 127/64].
+     *
+     * @param weights The weights, with the vector sizes given in FloatWeights.
+     * @return true on success, false if the size or a vector length is invalid.
+     */
+    bool NeuralEval::quantize(const FloatWeights& weights){
+        const int newCells = weights.size * weights.size;
+        if (weights.size < 2 || weights.size > MAX_SIZE
+            || weights.w1.size() != static_cast<size_t>(2 * newCells * HIDDEN1) || weights.b1.size() != HIDDEN1
+            || weights.w2.size() != HIDDEN2 * HIDDEN1 || weights.b2.size() != HIDDEN2 || weights.w3.size() != HIDDEN2
+            || weights.wp.size() != static_cast<size_t>(newCells * HIDDEN2) || weights.bp.size() != static_cast<size_t>(newCells)){
+            LOG_ERROR("Invalid network weights");
+            return false;
+        }
+        size = weights.size;
+        cells = newCells;
+        const float activation = static_cast<float>(ACTIVATION_SCALE);
+        const float weight = static_cast<float>(WEIGHT_SCALE);
+        w1.resize(weights.w1.size());
+        for (size_t i = 0; i < w1.size(); i++){
+            w1[i] = quantizeValue<int16_t>(weights.w1[i], activation, ACTIVATION_SCALE);
+        }
+        for (int i = 0; i < HIDDEN1; i++){
+            b1[i] = quantizeValue<int16_t>(weights.b1[i], activation, ACTIVATION_SCALE);
+        }
+        for (int i = 0; i < HIDDEN2 * HIDDEN1; i++){
+            w2[i] = quantizeValue<int8_t>(weights.w2[i], weight, 127);
+        }
+        for (int i = 0; i < HIDDEN2; i++){
+            b2[i] = quantizeValue<int32_t>(weights.b2[i], OUTPUT_SCALE, 1LL << 30);
+            w3[i] = quantizeValue<int8_t>(weights.w3[i], weight, 127);
+        }
+        b3 = quantizeValue<int32_t>(weights.b3, OUTPUT_SCALE, 1LL << 30);
+        wp.resize(weights.wp.size());
+        for (size_t i = 0; i < wp.size(); i++){
+            wp[i] = quantizeValue<int8_t>(weights.wp[i], weight, 127);
+        }
+        bp.resize(weights.bp.size());
+        for (size_t i = 0; i < bp.size(); i++){
+            bp[i] = quantizeValue<int32_t>(weights.bp[i], OUTPUT_SCALE, 1LL << 30);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Computes the accumulator of a position from scratch.
+     *
+     * @param board The position, of the size of the network.
+     * @param accumulator Receives the first layer outputs.
+     */
+    void NeuralEval::refresh(const Board& board, Accumulator& accumulator) const{
+        for (int p = 0; p < PLAYER_COUNT; p++){
+            std::copy(b1, b1 + HIDDEN1, accumulator.values[p]);
+        }
+        for (int row = 0; row < size; row++){
+            for (int col = 0; col < size; col++){
+                const Symbol symbol = board.getSymbol(CellPos{ col, row });
+                if (Symbol::None != symbol){
+                    update(accumulator, CellPos{ col, row }, symbol, 1);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Updates the accumulator for a symbol placed on a cell.
+     *
+     * @param accumulator The accumulator of the position before the move.
+     * @param pos The cell.
+     * @param symbol The symbol placed.
+     */
+    void NeuralEval::addMove(Accumulator& accumulator, const CellPos& pos, Symbol symbol) const{
+        update(accumulator, pos, symbol, 1);
+    }
+
+    /**
+     * @brief Updates the accumulator for a symbol taken off a cell.
+     *
+     * @param accumulator The accumulator of the position before the move is taken back.
+     * @param pos The cell.
+     * @param symbol The symbol taken off.
+     */
+    void NeuralEval::removeMove(Accumulator& accumulator, const CellPos& pos, Symbol symbol) const{
+        update(accumulator, pos, symbol, -1);
+    }
+
+    /**
+     * @brief Adds or subtracts the first layer weights of a symbol on a cell.
+     *
+     * The symbol is in the own plane of its side's accumulator and in the opponent plane of the other.
+     */
+    void NeuralEval::update(Accumulator& accumulator, const CellPos& pos, Symbol symbol, int sign) const{
+        const int cell = pos.y * size + pos.x;
+        for (int p = 0; p < PLAYER_COUNT; p++){
+            const Symbol perspective = (0 == p) ? Symbol::X : Symbol::O;
+            const int16_t* weights = &w1[static_cast<size_t>(((perspective == symbol) ? cell : cells + cell) * HIDDEN1)];
+            int16_t* values = accumulator.values[p];
+            if (sign > 0){
+                for (int i = 0; i < HIDDEN1; i++){
+                    values[i] = static_cast<int16_t>(values[i] + weights[i]);
+                }
+            }
+            else{
+                for (int i = 0; i < HIDDEN1; i++){
+                    values[i] = static_cast<int16_t>(values[i] - weights[i]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Runs the layers shared by both heads.
+     *
+     * @param accumulator The first layer outputs of the position.
+     * @param side The side to move.
+     * @param output Receives the HIDDEN2 activations of the second layer.
+     */
+    void NeuralEval::hidden(const Accumulator& accumulator, Symbol side, uint8_t* output) const{
+        const int16_t* values = accumulator.values[(Symbol::X == side) ? 0 : 1];
+        alignas(32) uint8_t input[HIDDEN1];
+        for (int i = 0; i < HIDDEN1; i++){
+            input[i] = clipActivation(values[i]);
+        }
+        int32_t sums[HIDDEN2];
+        kernel().affine(input, w2, b2, HIDDEN2, sums);
+        for (int i = 0; i < HIDDEN2; i++){
+            output[i] = clipActivation(sums[i] >> WEIGHT_SHIFT);
+        }
+    }
+
+    /**
+     * @brief Gets the estimated log odds of the side to move winning.
+     *
+     * @param accumulator The first layer outputs of the position.
+     * @param side The side to move.
+     * @return The log odds.
+     */
+    float NeuralEval::evaluate(const Accumulator& accumulator, Symbol side) const{
+        float value = 0.0f;
+        evaluateBatch(&accumulator, &side, 1, &value);
+        return value;
+    }
+
+    /**
+     * @brief Evaluates many positions at once.
+     *
+     * The weights stay in the first level cache for the whole batch, so a search that collects
+     * its leaves evaluates them faster than one at a time.
+     *
+     * @param accumulators The first layer outputs of the positions.
+     * @param sides The side to move of every position.
+     * @param count The number of positions.
+     * @param values Receives the log odds of the side to move winning for every position.
+     */
+    void NeuralEval::evaluateBatch(const Accumulator* accumulators, const Symbol* sides, size_t count, float* values) const{
+        const AffineKernel affine = kernel().affine;
+        alignas(32) uint8_t activations[HIDDEN2];
+        for (size_t i = 0; i < count; i++){
+            hidden(accumulators[i], sides[i], activations);
+            int32_t sum = 0;
+            affine(activations, w3, &b3, 1, &sum);
+            values[i] = static_cast<float>(sum) / OUTPUT_SCALE;
+        }
+    }
+
+    /**
+     * @brief Gets the score of a position for the side to move, like EvalWeights::evaluate.
+     *
+     * @param accumulator The first layer outputs of the position.
+     * @param side The side to move.
+     * @return The score, strictly between a loss and a win.
+     */
+    int NeuralEval::score(const Accumulator& accumulator, Symbol side) const{
+        return EvalWeights::toScore(evaluate(accumulator, side));
+    }
+
+    /**
+     * @brief Gets the probability of each cell being the best move.
+     *
+     * @param board The position.
+     * @param accumulator The first layer outputs of the position.
+     * @param side The side to move.
+     * @param priors Receives size * size probabilities in row-major order, 0 for occupied cells.
+     */
+    void NeuralEval::policy(const Board& board, const Accumulator& accumulator, Symbol side, float* priors) const{
+        alignas(32) uint8_t activations[HIDDEN2];
+        hidden(accumulator, side, activations);
+        std::vector<int32_t> logits(static_cast<size_t>(cells));
+        kernel().affine(activations, wp.data(), bp.data(), cells, logits.data());
+
+        float highest = -1e30f;
+        for (int cell = 0; cell < cells; cell++){
+            if (board.isEmpty(CellPos{ cell % size, cell / size })){
+                highest = std::max(highest, static_cast<float>(logits[cell]) / OUTPUT_SCALE);
+            }
+        }
+        float total = 0.0f;
+        for (int cell = 0; cell < cells; cell++){
+            priors[cell] = board.isEmpty(CellPos{ cell % size, cell / size })
+                ? std::exp(static_cast<float>(logits[cell]) / OUTPUT_SCALE - highest) : 0.0f;
+            total += priors[cell];
+        }
+        for (int cell = 0; cell < cells && total > 0.0f; cell++){
+            priors[cell] /= total;
+        }
+    }
+
+    /**
+     * @brief Gets the name of the dot product kernel in use.
+     *
+     * @return "avx2", "ssse3" or "scalar".
+     */
+    const char* NeuralEval::getKernelName(){
+        return kernel().name;
+    }
+
+} // namespace tictactoe
@@ -0,0 +1,164 @@
+/**
+ * @file neuraleval.h
+ * @brief Header file for the NeuralEval class.
+ *
+ * This file contains the declaration of the NeuralEval class, a small quantized neural network
+ * that scores positions and proposes moves. The inputs are two planes of cells, the symbols of
+ * the side to move and those of the opponent. The first layer is kept as an accumulator that
+ * is updated as moves are made and taken back, followed by two int8 layers and a value head
+ * and a policy head with one output per cell. A file holds the weights of one board size:
+ *
+ *   "TTTN", u8 version, u8 size, u8 HIDDEN1, u8 HIDDEN2,
+ *   i16 w1[2 * cells][HIDDEN1], i16 b1[HIDDEN1], i8 w2[HIDDEN2][HIDDEN1], i32 b2[HIDDEN2],
+ *   i8 w3[HIDDEN2], i32 b3, i8 wp[cells][HIDDEN2], i32 bp[cells]
+ *
+ * Integers are stored in the byte order of the host.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef NEURALEVAL_H
+#define NEURALEVAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "board.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief The NeuralEval class runs the int8 network on the CPU.
+     *
+     * Activations are clipped to [0, 1] and stored as multiples of 1/127, weights after the
+     * first layer as multiples of 1/64. The int8 dot products run on AVX2 or SSSE3 when the
+     * processor has them, chosen once at run time, and in portable C++ otherwise.
+     */
+    class NeuralEval{
+    public:
+        static constexpr uint8_t VERSION = 1;
+        static constexpr int HIDDEN1 = 32;
+        static constexpr int HIDDEN2 = 32;
+        static constexpr int MAX_SIZE = 16; // Keeps the first layer sums within int16
+        static constexpr int ACTIVATION_SCALE = 127;
+        static constexpr int WEIGHT_SCALE = 64;
+        static constexpr int WEIGHT_SHIFT = 6;
+
+        /**
+         * @brief First layer outputs of a position from the point of view of either side.
+         */
+        struct Accumulator{
+            alignas(32) int16_t values[PLAYER_COUNT][HIDDEN1]; /**< X to move first, then O to move. */
+        };
+
+        /**
+         * @brief Unquantized weights as produced by training, laid out like the file.
+         */
+        struct FloatWeights{
+            int size = DEFAULT_BOARD_SIZE;
+            std::vector<float> w1; /**< [2 * cells][HIDDEN1] */
+            std::vector<float> b1; /**< [HIDDEN1] */
+            std::vector<float> w2; /**< [HIDDEN2][HIDDEN1] */
+            std::vector<float> b2; /**< [HIDDEN2] */
+            std::vector<float> w3; /**< [HIDDEN2] */
+            float b3 = 0.0f;
+            std::vector<float> wp; /**< [cells][HIDDEN2] */
+            std::vector<float> bp; /**< [cells] */
+        };
+
+        /**
+         * @brief Constructs a network without weights, load or quantize before use.
+         */
+        NeuralEval();
+
+        /**
+         * @brief Reads the weights of a network file.
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Writes the weights to a network file.
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Sets the weights from unquantized ones, clipping them to the int ranges.
+         */
+        bool quantize(const FloatWeights& weights);
+
+        /**
+         * @brief Gets the board size the network was trained for, 0 without weights.
+         */
+        inline int getSize() const { return size; }
+
+        /**
+         * @brief Computes the accumulator of a position from scratch.
+         */
+        void refresh(const Board& board, Accumulator& accumulator) const;
+
+        /**
+         * @brief Updates the accumulator for a symbol placed on a cell.
+         */
+        void addMove(Accumulator& accumulator, const CellPos& pos, Symbol symbol) const;
+
+        /**
+         * @brief Updates the accumulator for a symbol taken off a cell.
+         */
+        void removeMove(Accumulator& accumulator, const CellPos& pos, Symbol symbol) const;
+
+        /**
+         * @brief Gets the estimated log odds of the side to move winning.
+         */
+        float evaluate(const Accumulator& accumulator, Symbol side) const;
+
+        /**
+         * @brief Evaluates many positions at once.
+         */
+        void evaluateBatch(const Accumulator* accumulators, const Symbol* sides, size_t count, float* values) const;
+
+        /**
+         * @brief Gets the score of a position for the side to move, like EvalWeights::evaluate.
+         */
+        int score(const Accumulator& accumulator, Symbol side) const;
+
+        /**
+         * @brief Gets the probability of each cell being the best move.
+         */
+        void policy(const Board& board, const Accumulator& accumulator, Symbol side, float* priors) const;
+
+        /**
+         * @brief Gets the name of the dot product kernel in use.
+         */
+        static const char* getKernelName();
+
+    private:
+        /**
+         * @brief Runs the layers shared by both heads.
+         */
+        void hidden(const Accumulator& accumulator, Symbol side, uint8_t* output) const;
+
+        /**
+         * @brief Adds or subtracts the first layer weights of a symbol on a cell.
+         */
+        void update(Accumulator& accumulator, const CellPos& pos, Symbol symbol, int sign) const;
+
+    private:
+        int size; /**< Board size, 0 without weights. */
+        int cells; /**< size * size. */
+        std::vector<int16_t> w1; /**< [2 * cells][HIDDEN1], own plane then opponent plane. */
+        alignas(32) int16_t b1[HIDDEN1];
+        alignas(32) int8_t w2[HIDDEN2 * HIDDEN1];
+        int32_t b2[HIDDEN2];
+        alignas(32) int8_t w3[HIDDEN2];
+        int32_t b3;
+        std::vector<int8_t> wp; /**< [cells][HIDDEN2] */
+        std::vector<int32_t> bp; /**< [cells] */
+    };
+
+} // namespace tictactoe
+
+#endif // NEURALEVAL_H
@@ -0,0 +1,119 @@
+/**
+ * @file notation.cpp
+ * @brief Implementation file for the move notation helpers.
+ *
+ * This file contains the implementation of the functions converting cell coordinates to and
+ * from their text notation.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include "notation.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Converts a cell coordinate to its notation.
+     *
+     * @param pos The cell, x is the column and y the row.
+     * @return The notation of the cell, e.g. "b2" for column 1, row 1.
+     */
+    std::string toNotation(const CellPos& pos){
+        std::string text(1, static_cast<char>('a' + pos.x));
+        text += std::to_string(pos.y + 1);
+        return text;
+    }
+
+    /**
+     * @brief Parses the notation of a single cell.
+     *
+     * @param text The notation, a column letter followed by a 1-based row number.
+     * @param pos Receives the cell on success.
+     * @return true if the text is a valid notation, false otherwise.
+     */
+    bool parseNotation(std::string_view text, CellPos& pos){
+        if (text.size() < 2 || text[0] < 'a' || text[0] >= 'a' + MAX_NOTATION_SIZE){
+            return false;
+        }
+        int row = 0;
+        for (size_t i = 1; i < text.size(); i++){
+            if (text[i] < '0' || text[i] > '9' || row > MAX_NOTATION_SIZE){
+                return false;
+            }
+            row = row * 10 + (text[i] - '0');
+        }
+        if (row < 1){
+            return false;
+        }
+        pos = CellPos{ text[0] - 'a', row - 1 };
+        return true;
+    }
+
+    /**
+     * @brief Parses a whitespace separated list of cells.
+     *
+     * @param text The list, e.g. "b2 a1 c3".
+     * @param moves Receives the cells, appended in order.
+     * @return true if every entry is a valid notation, false otherwise.
+     */
+    bool parseMoveList(std::string_view text, std::vector<CellPos>& moves){
+        size_t pos = 0;
+        while (pos < text.size()){
+            while (pos < text.size() && (' ' == text[pos] || '\t' == text[pos] || '\r' == text[pos] || '\n' == text[pos])){
+                pos++;
+            }
+            size_t end = pos;
+            while (end < text.size() && ' ' != text[end] && '\t' != text[end] && '\r' != text[end] && '\n' != text[end]){
+                end++;
+            }
+            if (end > pos){
+                CellPos cell{ 0, 0 };
+                if (!parseNotation(text.substr(pos, end - pos), cell)){
+                    return false;
+                }
+                moves.push_back(cell);
+            }
+            pos = end;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Splits off the first whitespace separated word of the text.
+     *
+     * @param text The text, advanced past the word.
+     * @return The word, empty if the text holds only whitespace.
+     */
+    std::string_view nextWord(std::string_view& text){
+        const size_t begin = text.find_first_not_of(" \t\r");
+        if (std::string_view::npos == begin){
+            text = std::string_view();
+            return text;
+        }
+        const size_t end = text.find_first_of(" \t\r", begin);
+        const std::string_view word = text.substr(begin, end - begin);
+        text = (std::string_view::npos == end) ? std::string_view() : text.substr(end);
+        return word;
+    }
+
+    /**
+     * @brief Parses the name of an AI type.
+     *
+     * @param text The name, "minimax" or "random".
+     * @param type Receives the AI type on success.
+     * @return true if the name is known, false otherwise.
+     */
+    bool parseAIType(std::string_view text, AIType& type){
+        if ("minimax" == text){
+            type = AIType::Minimax;
+            return true;
+        }
+        if ("random" == text){
+            type = AIType::Random;
+            return true;
+        }
+        return false;
+    }
+
+} // namespace tictactoe
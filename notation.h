@@ -0,0 +1,57 @@
+/**
+ * @file notation.h
+ * @brief Header file for the move notation helpers.
+ *
+ * This file contains the declaration of the functions converting cell coordinates to and from
+ * their text notation, a column letter followed by a 1-based row number (e.g. "b2"), and of the
+ * small text parsers shared by the command line tools and the line protocols.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "commondef.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Largest board size the notation can express, one letter per column.
+     */
+    constexpr int MAX_NOTATION_SIZE = 26;
+
+    /**
+     * @brief Converts a cell coordinate to its notation.
+     */
+    std::string toNotation(const CellPos& pos);
+
+    /**
+     * @brief Parses the notation of a single cell.
+     */
+    bool parseNotation(std::string_view text, CellPos& pos);
+
+    /**
+     * @brief Parses a whitespace separated list of cells.
+     */
+    bool parseMoveList(std::string_view text, std::vector<CellPos>& moves);
+
+    /**
+     * @brief Splits off the first whitespace separated word of the text.
+     */
+    std::string_view nextWord(std::string_view& text);
+
+    /**
+     * @brief Parses the name of an AI type, "minimax" or "random".
+     */
+    bool parseAIType(std::string_view text, AIType& type);
+
+} // namespace tictactoe
+
+#endif // NOTATION_H
@@ -0,0 +1,152 @@
+/**
+ * @file perfcounters.cpp
+ * @brief Implementation file for the PerfCounters class.
+ *
+ * This file contains the perf_event_open calls on Linux and the formatting of the counts.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "perfcounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tictactoe{
+
+    namespace {
+        const char* const EVENT_NAMES[PerfSample::EVENT_COUNT] = { "cycles", "instructions", "cache misses", "branch misses" };
+
+#ifdef __linux__
+        const uint64_t EVENT_CONFIGS[PerfSample::EVENT_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+
+        /**
+         * @brief Opens a counter of a hardware event for the calling thread on any CPU.
+         *
+         * @return The file descriptor, -1 if the event can not be counted.
+         */
+        int openEvent(uint64_t config){
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        }
+#endif
+    }
+
+    /**
+     * @brief Closes the counters.
+     */
+    PerfCounters::~PerfCounters(){
+#ifdef __linux__
+        for (int fd : fds){
+            if (fd >= 0){
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Starts counting the events of the calling thread.
+     *
+     * Each event is opened on its own, so one the CPU lacks does not take the others down.
+     * Opening fails as a whole when perf events are not permitted, e.g. by
+     * /proc/sys/kernel/perf_event_paranoid above 2 or a container's seccomp filter.
+     *
+     * @return true if at least one event is counted.
+     */
+    bool PerfCounters::open(){
+#ifdef __linux__
+        for (int event = 0; event < PerfSample::EVENT_COUNT; event++){
+            if (fds[event] < 0){
+                fds[event] = openEvent(EVENT_CONFIGS[event]);
+            }
+        }
+#endif
+        return isOpen();
+    }
+
+    /**
+     * @brief Checks if any event is being counted.
+     *
+     * @return true if at least one event is counted.
+     */
+    bool PerfCounters::isOpen() const{
+        for (int fd : fds){
+            if (fd >= 0){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reads the counts since open(), zero for unavailable events.
+     *
+     * @return The counts, scaled up when the kernel shared the counter with other events.
+     */
+    PerfSample PerfCounters::read() const{
+        PerfSample sample;
+#ifdef __linux__
+        for (int event = 0; event < PerfSample::EVENT_COUNT; event++){
+            uint64_t data[3] = {}; // Value, time enabled, time running
+            if (fds[event] < 0 || static_cast<ssize_t>(sizeof(data)) != ::read(fds[event], data, sizeof(data))){
+                continue;
+            }
+            if (data[2] > 0 && data[2] < data[1]){
+                data[0] = static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]));
+            }
+            sample.values[event] = data[0];
+            sample.counted[event] = true;
+        }
+#endif
+        return sample;
+    }
+
+    /**
+     * @brief Formats the counts of some work, also per node.
+     *
+     * @param nodes The nodes searched by the work, 0 to leave out the per node figures.
+     * @return For example "cycles 1.2e+09 (412/node), instructions 2.9e+09 (994/node), IPC 2.41,
+     *         cache misses 3.5e+04 (0.012/node), branch misses 1e+06 (0.35/node)",
+     *         or "perf counters unavailable".
+     */
+    std::string PerfSample::toString(uint64_t nodes) const{
+        std::string result;
+        char text[96];
+        for (int event = 0; event < EVENT_COUNT; event++){
+            if (!counted[event]){
+                continue;
+            }
+            const double value = static_cast<double>(values[event]);
+            if (nodes > 0){
+                std::snprintf(text, sizeof(text), "%s %.3g (%.3g/node)", EVENT_NAMES[event], value, value / static_cast<double>(nodes));
+            }
+            else{
+                std::snprintf(text, sizeof(text), "%s %.3g", EVENT_NAMES[event], value);
+            }
+            result += result.empty() ? "" : ", ";
+            result += text;
+            if (INSTRUCTIONS == event && counted[CYCLES] && values[CYCLES] > 0){
+                std::snprintf(text, sizeof(text), ", IPC %.2f", value / static_cast<double>(values[CYCLES]));
+                result += text;
+            }
+        }
+        return result.empty() ? "perf counters unavailable" : result;
+    }
+
+} // namespace tictactoe
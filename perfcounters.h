@@ -0,0 +1,114 @@
+/**
+ * @file perfcounters.h
+ * @brief Header file for the PerfCounters class.
+ *
+ * This file contains the declaration of the PerfCounters class, which reads the CPU's
+ * hardware performance counters for the calling thread through Linux perf_event_open, so a
+ * search can be reported in cycles, instructions, cache misses and branch misses per node.
+ * Counters the kernel, the CPU or a virtual machine does not provide are left out; on other
+ * systems none is available.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+namespace tictactoe{
+
+    /**
+     * @brief Values of the hardware counters at one moment, or the difference of two.
+     */
+    struct PerfSample{
+        /**
+         * @brief The counted events.
+         */
+        enum Event { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+        uint64_t values[EVENT_COUNT] = {};
+        bool counted[EVENT_COUNT] = {}; // false for events that were not available
+
+        /**
+         * @brief Gets the counts from another sample to this one.
+         */
+        PerfSample operator-(const PerfSample& earlier) const{
+            PerfSample delta;
+            for (int event = 0; event < EVENT_COUNT; event++){
+                delta.values[event] = values[event] - earlier.values[event];
+                delta.counted[event] = counted[event] && earlier.counted[event];
+            }
+            return delta;
+        }
+
+        /**
+         * @brief Adds the counts of another sample, e.g. of another thread.
+         */
+        PerfSample& operator+=(const PerfSample& other){
+            for (int event = 0; event < EVENT_COUNT; event++){
+                values[event] += other.values[event];
+                counted[event] = counted[event] || other.counted[event];
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Formats the counts of some work, also per node.
+         */
+        std::string toString(uint64_t nodes) const;
+    };
+
+    /**
+     * @brief The PerfCounters class counts hardware events of the thread that opened it.
+     *
+     * The counters run from open() until the object is destroyed and only count user space.
+     * Take a sample before and after the measured work and subtract them. When the kernel
+     * multiplexes the counters, the values are scaled up to the whole time they were enabled.
+     */
+    class PerfCounters{
+    public:
+        /**
+         * @brief Constructs closed counters.
+         */
+        PerfCounters() = default;
+
+        /**
+         * @brief Closes the counters.
+         */
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /**
+         * @brief Starts counting the events of the calling thread.
+         */
+        bool open();
+
+        /**
+         * @brief Checks if an event is being counted.
+         */
+        inline bool isAvailable(PerfSample::Event event) const { return fds[event] >= 0; }
+
+        /**
+         * @brief Checks if any event is being counted.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Reads the counts since open(), zero for unavailable events.
+         */
+        PerfSample read() const;
+
+    private:
+        int fds[PerfSample::EVENT_COUNT] = { -1, -1, -1, -1 }; // File descriptor per event, -1 if unavailable
+    };
+
+} // namespace tictactoe
+
+#endif // PERFCOUNTERS_H
@@ -17,11 +17,11 @@ namespace tictactoe{
      *
      * This function converts the Symbol enum value representing the player's symbol (X, O, or None) to a string.
      *
-     * @return QString The string representation of the player's symbol.
+     * @return std::string_view The string representation of the player's symbol.
      */
-    QString Player::getSymbolString() const {
+    std::string_view Player::getSymbolString() const {
         int enumValue = static_cast<int>(symbol);
-        QString symbolStr;
+        std::string_view symbolStr;
         switch (enumValue){
         case 0:
             symbolStr = NO_VAL;
@@ -48,9 +48,106 @@ namespace tictactoe{
             ai->setLevel(level_i);
         }
         else{
-            Logger::getInstance().logError("Invalid ai", LOG_LOCATION);
+            LOG_ERROR("Invalid ai");
         }
 
         }
 
+    /**
+     * @brief Sets the position database the AI player orders its moves with.
+     *
+     * @param positionDB_i The database, shared with other players, or nullptr to stop using one.
+     */
+    void Player::setPositionDB(std::shared_ptr<const PositionDB> positionDB_i){
+        positionDB = std::move(positionDB_i);
+        if (ai){
+            ai->setPositionDB(positionDB);
+        }
+    }
+
+    /**
+     * @brief Sets the evaluation weights the AI player scores cut off positions with.
+     *
+     * @param evalWeights_i The weights, shared with other players, or nullptr to score them as draws.
+     */
+    void Player::setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights_i){
+        evalWeights = std::move(evalWeights_i);
+        if (ai){
+            ai->setEvalWeights(evalWeights);
+        }
+    }
+
+    /**
+     * @brief Sets the neural network the AI player scores positions and orders moves with.
+     *
+     * @param neuralEval_i The network, shared with other players, or nullptr to not use one.
+     */
+    void Player::setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval_i){
+        neuralEval = std::move(neuralEval_i);
+        if (ai){
+            ai->setNeuralEval(neuralEval);
+        }
+    }
+
+    /**
+     * @brief Restarts the random choices of the AI player from a seed.
+     *
+     * Unlike the other settings the seed is not kept, an AI acquired later is seeded by the AI factory.
+     *
+     * @param seed The seed.
+     */
+    void Player::setSeed(uint64_t seed){
+        if (ai){
+            ai->setSeed(seed);
+        }
+    }
+
+    /**
+     * @brief Places the player's symbol at the given position.
+     *
+     * @param pos The position to make the move.
+     * @param board The game board.
+     * @return True if the move was successful, false otherwise.
+     */
+    bool Player::playMove(const CellPos& pos, Board& board){
+        // Check if the position is valid
+        if (pos.x < 0 || pos.x >= board.getSize() || pos.y < 0 || pos.y >= board.getSize()){
+            return false; // Invalid move
+        }
+
+        // Set the current position
+        curPos = pos;
+
+        // Make the move on the board
+        return board.makeMove(pos, symbol);
+    }
+
+    /**
+     * @brief Creates a resumable search for the player's next move.
+     *
+     * @param board The game board, copied into the search.
+     * @return The search task, or nullptr if the player has no AI.
+     */
+    std::unique_ptr<SearchTask> Player::createSearch(const Board& board) const{
+        if (!ai){
+            LOG_ERROR("Invalid ai");
+            return nullptr;
+        }
+        return ai->createSearch(board, symbol);
+    }
+
+    /**
+     * @brief Scores every legal move of the player.
+     *
+     * @param board The game board.
+     * @return The scores of the legal moves, empty if the player has no AI.
+     */
+    std::vector<MoveScore> Player::analyze(const Board& board) const{
+        if (!ai){
+            LOG_ERROR("Invalid ai");
+            return std::vector<MoveScore>();
+        }
+        return ai->analyze(board, symbol);
+    }
+
 } // namespace tictactoe
@@ -13,6 +13,7 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include <memory>
 #include "commondef.h"
 #include "board.h"
 #include "gameai.h"
@@ -32,12 +33,12 @@ namespace tictactoe{
         /**
          * @brief Makes a move on the board.
          */
-        virtual bool makeMove(const QPoint& point, Board& board) = 0;
+        virtual bool makeMove(const CellPos& point, Board& board) = 0;
 
         /**
-         * @brief Changes the AI type of the player.
+         * @brief Changes the AI type of the player and the board size it plays on.
          */
-        virtual bool changeAI(AIType aitype) = 0;
+        virtual bool changeAI(AIType aitype, int boardSize) = 0;
 
         /**
          * @brief Gets the symbol of the player.
@@ -52,28 +53,72 @@ namespace tictactoe{
         /**
          * @brief Gets the symbol string of the player.
          */
-        QString getSymbolString() const;
+        std::string_view getSymbolString() const;
 
         /**
          * @brief Gets the current position of the player.
          */
-        inline QPoint getCurPos() const { return curPos; }
+        inline CellPos getCurPos() const { return curPos; }
+
+        /**
+         * @brief Gets the statistics of the search for the player's last move, empty for a human player.
+         */
+        inline const SearchStats& getLastStats() const { return lastStats; }
 
         /**
          * @brief Sets the level of the AI player.
          */
         void setLevel(GameLevel level_i);
 
+        /**
+         * @brief Sets the position database the AI player orders its moves with.
+         */
+        void setPositionDB(std::shared_ptr<const PositionDB> positionDB_i);
+
+        /**
+         * @brief Sets the evaluation weights the AI player scores cut off positions with.
+         */
+        void setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights_i);
+
+        /**
+         * @brief Sets the neural network the AI player scores positions and orders moves with.
+         */
+        void setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval_i);
+
+        /**
+         * @brief Restarts the random choices of the AI player from a seed.
+         */
+        void setSeed(uint64_t seed);
+
+        /**
+         * @brief Places the player's symbol at the given position.
+         */
+        bool playMove(const CellPos& pos, Board& board);
+
+        /**
+         * @brief Creates a resumable search for the player's next move.
+         */
+        std::unique_ptr<SearchTask> createSearch(const Board& board) const;
+
+        /**
+         * @brief Scores every legal move of the player.
+         */
+        std::vector<MoveScore> analyze(const Board& board) const;
+
     protected:
         /**
          * @brief Constructor for the Player class.
          */
-        Player(Symbol symbol, std::unique_ptr<GameAI> ai_i) : symbol(symbol), ai(std::move(ai_i)), curPos(0, 0) {}
+        Player(Symbol symbol, std::unique_ptr<GameAI> ai_i) : symbol(symbol), ai(std::move(ai_i)), curPos{ 0, 0 } {}
 
     protected:
         std::unique_ptr<GameAI> ai; // Pointer to the AI for the player
         Symbol symbol; // Symbol of the player
-        QPoint curPos; // Current position of the player
+        CellPos curPos; // Current position of the player
+        SearchStats lastStats; // Copy of the AI's statistics, kept when the AI goes back to the pool
+        std::shared_ptr<const PositionDB> positionDB; // Position database kept across AI changes, may be null
+        std::shared_ptr<const EvalWeights> evalWeights; // Evaluation weights kept across AI changes, may be null
+        std::shared_ptr<const NeuralEval> neuralEval; // Neural network kept across AI changes, may be null
     };
 
 } // namespace tictactoe
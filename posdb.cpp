@@ -0,0 +1,362 @@
+/**
+ * @file posdb.cpp
+ * @brief Implementation file for the position database tool.
+ *
+ * This file contains a command line tool that builds a position database from binary game
+ * record files and looks up positions in it. The build is a sharded parallel ingest: worker
+ * threads replay chunks of games into per-thread hash maps split by the top bits of the
+ * canonical key, then each shard is merged and sorted on its own, and as the shards cover
+ * increasing key ranges their concatenation is the sorted table.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "gamerecord.h"
+#include "notation.h"
+#include "positiondb.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Statistics of one position while the database is built.
+     */
+    struct Accumulator{
+        uint32_t visits = 0;
+        uint32_t wins = 0;
+        uint32_t draws = 0;
+        uint32_t losses = 0;
+        std::vector<std::pair<uint16_t, uint32_t>> replies; // Canonical cell and count, few per position
+    };
+
+    using Shard = std::unordered_map<uint64_t, Accumulator>;
+
+    struct BuildConfig{
+        const char* output = nullptr;
+        std::vector<std::string> inputs;
+        int threads = 0;
+        int shardBits = 4;
+    };
+
+    inline size_t shardOf(uint64_t key, int shardBits){
+        return (0 == shardBits) ? 0 : static_cast<size_t>(key >> (64 - shardBits));
+    }
+
+    /**
+     * @brief Replays the finished games of the chunks taken from the shared counter into the shards.
+     */
+    void ingest(const std::vector<std::unique_ptr<GameRecordReader>>& readers, const std::vector<GameChunk>& chunks,
+                std::atomic<size_t>& nextChunk, int shardBits, std::vector<Shard>& shards, uint64_t& positions){
+        GameRecord record;
+        Board board;
+        for (size_t c = nextChunk.fetch_add(1); c < chunks.size(); c = nextChunk.fetch_add(1)){
+            const GameChunk& chunk = chunks[c];
+            for (size_t game = chunk.first; game < chunk.last; game++){
+                if (!readers[chunk.file]->readGame(game, record) || !record.finished
+                    || record.size * record.size >= PositionDB::NO_REPLY){
+                    continue;
+                }
+                board.startNewGame(record.size);
+                Symbol mover = record.firstMover;
+                for (const RecordedMove& move : record.moves){
+                    int symmetry = 0;
+                    int symmetries = 0;
+                    const uint64_t key = PositionDB::canonicalKey(board, mover, symmetry, &symmetries);
+                    Accumulator& stats = shards[shardOf(key, shardBits)][key];
+                    stats.visits++;
+                    if (Symbol::None == record.winner){
+                        stats.draws++;
+                    }
+                    else if (mover == record.winner){
+                        stats.wins++;
+                    }
+                    else{
+                        stats.losses++;
+                    }
+
+                    const uint16_t cell = PositionDB::canonicalCell(move.pos, record.size, symmetries);
+                    auto it = std::find_if(stats.replies.begin(), stats.replies.end(),
+                        [cell](const std::pair<uint16_t, uint32_t>& entry){ return entry.first == cell; });
+                    if (stats.replies.end() == it){
+                        stats.replies.emplace_back(cell, 1);
+                    }
+                    else{
+                        it->second++;
+                    }
+                    positions++;
+
+                    if (!board.makeMove(move.pos, mover)){
+                        break; // Malformed game, the rest of its positions are unreachable
+                    }
+                    mover = board.getOpponent(mover);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Merges shard number s of every worker into sorted entries.
+     */
+    void mergeShard(std::vector<std::vector<Shard>>& workerShards, size_t s, std::vector<PositionDB::Entry>& entries){
+        Shard merged = std::move(workerShards[0][s]);
+        for (size_t w = 1; w < workerShards.size(); w++){
+            for (auto& item : workerShards[w][s]){
+                Accumulator& target = merged[item.first];
+                target.visits += item.second.visits;
+                target.wins += item.second.wins;
+                target.draws += item.second.draws;
+                target.losses += item.second.losses;
+                for (const auto& reply : item.second.replies){
+                    auto it = std::find_if(target.replies.begin(), target.replies.end(),
+                        [&reply](const std::pair<uint16_t, uint32_t>& entry){ return entry.first == reply.first; });
+                    if (target.replies.end() == it){
+                        target.replies.push_back(reply);
+                    }
+                    else{
+                        it->second += reply.second;
+                    }
+                }
+            }
+            Shard().swap(workerShards[w][s]);
+        }
+
+        entries.reserve(merged.size());
+        for (const auto& item : merged){
+            PositionDB::Entry entry{ item.first, item.second.visits, item.second.wins, item.second.draws, item.second.losses,
+                                     PositionDB::NO_REPLY, 0, 0 };
+            for (const auto& reply : item.second.replies){
+                // The lowest cell wins ties so the table does not depend on the thread count
+                if (reply.second > entry.replyCount || (reply.second == entry.replyCount && reply.first < entry.reply)){
+                    entry.reply = reply.first;
+                    entry.replyCount = reply.second;
+                }
+            }
+            entries.push_back(entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](const PositionDB::Entry& lhs, const PositionDB::Entry& rhs){
+            return lhs.key < rhs.key;
+        });
+    }
+
+    int build(const BuildConfig& config){
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::unique_ptr<GameRecordReader>> readers;
+        std::vector<GameChunk> chunks;
+        size_t games = 0;
+        for (const std::string& input : config.inputs){
+            readers.push_back(std::make_unique<GameRecordReader>());
+            if (!readers.back()->open(input)){
+                return 1;
+            }
+            readers.back()->appendChunks(readers.size() - 1, chunks);
+            games += readers.back()->getGameCount();
+        }
+
+        int threads = config.threads;
+        if (0 == threads){
+            threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        threads = std::max(1, std::min(threads, static_cast<int>(chunks.size())));
+        const size_t shardCount = size_t(1) << config.shardBits;
+
+        // Ingest, every worker owns its shards so no map is shared
+        std::vector<std::vector<Shard>> workerShards(static_cast<size_t>(threads), std::vector<Shard>(shardCount));
+        std::vector<uint64_t> positions(static_cast<size_t>(threads), 0);
+        std::atomic<size_t> nextChunk{ 0 };
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++){
+            workers.emplace_back(ingest, std::cref(readers), std::cref(chunks), std::ref(nextChunk), config.shardBits,
+                                 std::ref(workerShards[static_cast<size_t>(t)]), std::ref(positions[static_cast<size_t>(t)]));
+        }
+        for (std::thread& worker : workers){
+            worker.join();
+        }
+        workers.clear();
+
+        // Merge, every worker takes whole shards
+        std::vector<std::vector<PositionDB::Entry>> shardEntries(shardCount);
+        std::atomic<size_t> nextShard{ 0 };
+        for (int t = 0; t < threads; t++){
+            workers.emplace_back([&workerShards, &shardEntries, &nextShard, shardCount](){
+                for (size_t s = nextShard.fetch_add(1); s < shardCount; s = nextShard.fetch_add(1)){
+                    mergeShard(workerShards, s, shardEntries[s]);
+                }
+            });
+        }
+        for (std::thread& worker : workers){
+            worker.join();
+        }
+
+        size_t total = 0;
+        for (const auto& entries : shardEntries){
+            total += entries.size();
+        }
+        std::vector<PositionDB::Entry> table;
+        table.reserve(total);
+        for (auto& entries : shardEntries){
+            table.insert(table.end(), entries.begin(), entries.end());
+            std::vector<PositionDB::Entry>().swap(entries);
+        }
+        if (!PositionDB::write(config.output, table)){
+            return 1;
+        }
+
+        uint64_t ingested = 0;
+        for (uint64_t count : positions){
+            ingested += count;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("games        %zu\n", games);
+        std::printf("positions    %llu ingested, %zu distinct\n", static_cast<unsigned long long>(ingested), table.size());
+        std::printf("time         %.3f s with %d threads and %zu shards\n", seconds, threads, shardCount);
+        return 0;
+    }
+
+    void printStats(const char* label, const PositionStats& stats){
+        std::printf("%-8s visits %u  win %u  draw %u  loss %u", label, stats.visits, stats.wins, stats.draws, stats.losses);
+        if (stats.hasReply){
+            std::printf("  reply %s (%u)", toNotation(stats.reply).c_str(), stats.replyCount);
+        }
+        std::printf("\n");
+    }
+
+    /**
+     * @brief Prints the statistics of a position and of the position after every legal move.
+     */
+    int query(const PositionDB& db, int size, const std::vector<CellPos>& moves){
+        Board board(size);
+        Symbol mover = Symbol::X;
+        for (const CellPos& move : moves){
+            if (!board.makeMove(move, mover)){
+                std::fprintf(stderr, "illegal move %s\n", toNotation(move).c_str());
+                return 1;
+            }
+            mover = board.getOpponent(mover);
+        }
+
+        const int repeats = 10000;
+        PositionStats stats;
+        bool found = false;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; i++){
+            found = db.lookup(board, mover, stats);
+        }
+        const double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeats;
+
+        if (!found){
+            std::printf("position not in database\n");
+        }
+        else{
+            printStats("position", stats);
+            // Child positions are seen by the opponent, their results are turned around
+            for (int row = 0; row < size; row++){
+                for (int col = 0; col < size; col++){
+                    const CellPos move{ col, row };
+                    if (!board.isEmpty(move)){
+                        continue;
+                    }
+                    board.makeMove(move, mover);
+                    PositionStats child;
+                    if (db.lookup(board, board.getOpponent(mover), child)){
+                        std::swap(child.wins, child.losses);
+                        printStats(toNotation(move).c_str(), child);
+                    }
+                    board.undoMove(move);
+                }
+            }
+        }
+        std::printf("lookup   %.3f us\n", micros);
+        return 0;
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s build OUT RECORDS... [--threads N] [--shards N]\n"
+            "       %s info DB\n"
+            "       %s query DB SIZE [MOVES...]\n"
+            "  --threads N   worker threads of the build (default: all cores)\n"
+            "  --shards N    key range shards of the build, a power of two (default 16)\n",
+            program, program, program);
+    }
+
+    bool parseBuild(int argc, char* argv[], BuildConfig& config){
+        config.output = argv[2];
+        for (int i = 3; i < argc; i++){
+            if (0 == std::strcmp(argv[i], "--threads") && i + 1 < argc){
+                config.threads = std::atoi(argv[++i]);
+            }
+            else if (0 == std::strcmp(argv[i], "--shards") && i + 1 < argc){
+                const int shards = std::atoi(argv[++i]);
+                if (shards <= 0 || shards > 4096 || 0 != (shards & (shards - 1))){
+                    return false;
+                }
+                config.shardBits = 0;
+                while ((1 << config.shardBits) < shards){
+                    config.shardBits++;
+                }
+            }
+            else{
+                config.inputs.push_back(argv[i]);
+            }
+        }
+        return !config.inputs.empty() && config.threads >= 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the position database tool.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc >= 4 && 0 == std::strcmp(argv[1], "build")){
+        BuildConfig config;
+        if (!parseBuild(argc, argv, config)){
+            printUsage(argv[0]);
+            return 1;
+        }
+        return build(config);
+    }
+    if (argc >= 3 && (0 == std::strcmp(argv[1], "info") || 0 == std::strcmp(argv[1], "query"))){
+        PositionDB db;
+        if (!db.open(argv[2])){
+            return 1;
+        }
+        if (0 == std::strcmp(argv[1], "info")){
+            std::printf("positions    %zu\n", db.getEntryCount());
+            return 0;
+        }
+        const int size = (argc > 3) ? std::atoi(argv[3]) : DEFAULT_BOARD_SIZE;
+        std::string text;
+        for (int i = 4; i < argc; i++){
+            text += std::string(argv[i]) + " ";
+        }
+        std::vector<CellPos> moves;
+        if (size < 2 || size > MAX_NOTATION_SIZE || !parseMoveList(text, moves)){
+            printUsage(argv[0]);
+            return 1;
+        }
+        return query(db, size, moves);
+    }
+    printUsage(argv[0]);
+    return 1;
+}
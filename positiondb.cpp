@@ -0,0 +1,333 @@
+/**
+ * @file positiondb.cpp
+ * @brief Implementation file for the PositionDB class.
+ *
+ * This file contains the implementation of the position statistics table, its symmetry
+ * helpers and the writer of its file format.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "positiondb.h"
+#include "logger.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tictactoe{
+
+    namespace {
+
+        const uint8_t MAGIC[4] = { 'T', 'T', 'T', 'P' };
+
+        static_assert(sizeof(PositionDB::Entry) == 32, "PositionDB::Entry is part of the file format");
+
+    } // namespace
+
+    /**
+     * @brief Constructor for the PositionDB class.
+     */
+    PositionDB::PositionDB()
+        : data(nullptr), length(0), entries(nullptr), count(0), index(nullptr), indexCount(0), indexStride(DEFAULT_INDEX_STRIDE) {}
+
+    /**
+     * @brief Destructor for the PositionDB class.
+     */
+    PositionDB::~PositionDB(){
+        close();
+    }
+
+    /**
+     * @brief Maps a database file.
+     *
+     * @param path The file path.
+     * @return true on success, false if the file cannot be mapped or is not a database file.
+     */
+    bool PositionDB::open(const std::string& path){
+        close();
+#if defined(_WIN32)
+        std::ifstream input(path, std::ios::binary | std::ios::ate);
+        if (!input){
+            LOG_ERROR("Cannot open position database " + path);
+            return false;
+        }
+        length = static_cast<size_t>(input.tellg());
+        contents.resize((length + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        input.seekg(0);
+        input.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(length));
+        data = reinterpret_cast<const uint8_t*>(contents.data());
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info;
+        if (fd < 0 || 0 != fstat(fd, &info)){
+            LOG_ERROR("Cannot open position database " + path);
+            if (fd >= 0){
+                ::close(fd);
+            }
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0){
+            void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED == mapping){
+                LOG_ERROR("Cannot map position database " + path);
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            madvise(mapping, length, MADV_RANDOM);
+            data = static_cast<const uint8_t*>(mapping);
+        }
+        ::close(fd);
+#endif
+        uint64_t entryCount = 0;
+        uint32_t stride = 0;
+        if (length >= FILE_HEADER_SIZE){
+            std::memcpy(&entryCount, data + 8, sizeof(entryCount));
+            std::memcpy(&stride, data + 16, sizeof(stride));
+        }
+        const uint64_t maxEntries = length / sizeof(Entry);
+        if (length < FILE_HEADER_SIZE || 0 != std::memcmp(data, MAGIC, sizeof(MAGIC)) || VERSION != data[4]
+            || 0 == stride || entryCount > maxEntries
+            || length != FILE_HEADER_SIZE + entryCount * sizeof(Entry) + (entryCount + stride - 1) / stride * sizeof(uint64_t)){
+            LOG_ERROR("Not a position database " + path);
+            close();
+            return false;
+        }
+
+        count = static_cast<size_t>(entryCount);
+        indexStride = stride;
+        indexCount = (count + stride - 1) / stride;
+        entries = reinterpret_cast<const Entry*>(data + FILE_HEADER_SIZE);
+        index = reinterpret_cast<const uint64_t*>(data + FILE_HEADER_SIZE + count * sizeof(Entry));
+        return true;
+    }
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void PositionDB::close(){
+#if defined(_WIN32)
+        contents.clear();
+#else
+        if (data){
+            munmap(const_cast<uint8_t*>(data), length);
+        }
+#endif
+        data = nullptr;
+        length = 0;
+        entries = nullptr;
+        count = 0;
+        index = nullptr;
+        indexCount = 0;
+    }
+
+    /**
+     * @brief Looks up the statistics of a position.
+     *
+     * @param board The position.
+     * @param mover The side to move.
+     * @param stats Receives the statistics, with the reply mapped onto the given board.
+     * @return true if the position is in the database, false otherwise.
+     */
+    bool PositionDB::lookup(const Board& board, Symbol mover, PositionStats& stats) const{
+        int symmetry = 0;
+        const Entry* entry = find(canonicalKey(board, mover, symmetry));
+        if (!entry){
+            return false;
+        }
+        const int size = board.getSize();
+        stats.visits = entry->visits;
+        stats.wins = entry->wins;
+        stats.draws = entry->draws;
+        stats.losses = entry->losses;
+        stats.hasReply = NO_REPLY != entry->reply && entry->reply < size * size;
+        stats.reply = stats.hasReply ? inverseTransformCell(CellPos{ entry->reply % size, entry->reply / size }, size, symmetry) : CellPos{ 0, 0 };
+        stats.replyCount = stats.hasReply ? entry->replyCount : 0;
+        return true;
+    }
+
+    /**
+     * @brief Finds the entry of a canonical key.
+     *
+     * The sparse index narrows the search to one block of indexStride entries, so only the
+     * index and a single block are touched.
+     *
+     * @param key The canonical key of the position.
+     * @return The entry, nullptr if the key is not in the database.
+     */
+    const PositionDB::Entry* PositionDB::find(uint64_t key) const{
+        const uint64_t* block = std::upper_bound(index, index + indexCount, key);
+        if (index == block){
+            return nullptr; // Smaller than every key
+        }
+        const size_t first = static_cast<size_t>(block - index - 1) * indexStride;
+        const size_t last = std::min(count, first + indexStride);
+        const Entry* entry = std::lower_bound(entries + first, entries + last, key, [](const Entry& lhs, uint64_t value){
+            return lhs.key < value;
+        });
+        return (entries + last != entry && entry->key == key) ? entry : nullptr;
+    }
+
+    /**
+     * @brief Gets the canonical key of a position and the symmetry that produces it.
+     *
+     * The canonical key is the smallest Board key of the 8 boards symmetric to the position,
+     * with the colors swapped when O is to move so the side to move always plays X. A position
+     * then shares its entry only with positions where the same side, by its stones, is to move.
+     *
+     * @param board The position.
+     * @param mover The side to move.
+     * @param symmetry Receives the symmetry mapping the board onto its canonical board.
+     * @param symmetries If not nullptr, receives a mask with bit t set for every symmetry t mapping the board onto its canonical board.
+     * @return The canonical key.
+     */
+    uint64_t PositionDB::canonicalKey(const Board& board, Symbol mover, int& symmetry, int* symmetries){
+        const int size = board.getSize();
+        uint64_t keys[SYMMETRY_COUNT];
+        for (uint64_t& key : keys){
+            key = Board::emptyKey(size);
+        }
+        for (int row = 0; row < size; row++){
+            for (int col = 0; col < size; col++){
+                Symbol symbol = board.getSymbol(CellPos{ col, row });
+                if (Symbol::None == symbol){
+                    continue;
+                }
+                if (Symbol::O == mover){
+                    symbol = board.getOpponent(symbol);
+                }
+                for (int t = 0; t < SYMMETRY_COUNT; t++){
+                    const CellPos pos = transformCell(CellPos{ col, row }, size, t);
+                    keys[t] ^= Board::cellKey(pos.y, pos.x, symbol);
+                }
+            }
+        }
+        symmetry = static_cast<int>(std::min_element(keys, keys + SYMMETRY_COUNT) - keys);
+        if (symmetries){
+            *symmetries = 0;
+            for (int t = 0; t < SYMMETRY_COUNT; t++){
+                if (keys[t] == keys[symmetry]){
+                    *symmetries |= 1 << t;
+                }
+            }
+        }
+        return keys[symmetry];
+    }
+
+    /**
+     * @brief Maps a cell onto the canonical board as a row-major cell index.
+     *
+     * A symmetric position reaches its canonical board through several symmetries, which map
+     * equivalent cells to different cells of the canonical board. The smallest of them is used so
+     * that equivalent replies share one cell.
+     *
+     * @param pos The cell.
+     * @param size The size of the board.
+     * @param symmetries The mask of symmetries from canonicalKey.
+     * @return The smallest row-major cell pos maps to.
+     */
+    uint16_t PositionDB::canonicalCell(const CellPos& pos, int size, int symmetries){
+        uint16_t cell = NO_REPLY;
+        for (int t = 0; t < SYMMETRY_COUNT; t++){
+            if (symmetries & (1 << t)){
+                const CellPos mapped = transformCell(pos, size, t);
+                cell = std::min(cell, static_cast<uint16_t>(mapped.y * size + mapped.x));
+            }
+        }
+        return cell;
+    }
+
+    /**
+     * @brief Maps a cell through one of the 8 symmetries of the square.
+     *
+     * Bit 2 of the symmetry transposes the board, then bit 0 mirrors the columns and bit 1 the rows.
+     *
+     * @param pos The cell.
+     * @param size The size of the board.
+     * @param symmetry The symmetry, 0 to 7.
+     * @return The mapped cell.
+     */
+    CellPos PositionDB::transformCell(const CellPos& pos, int size, int symmetry){
+        CellPos result = (symmetry & 4) ? CellPos{ pos.y, pos.x } : pos;
+        if (symmetry & 1){
+            result.x = size - 1 - result.x;
+        }
+        if (symmetry & 2){
+            result.y = size - 1 - result.y;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Maps a cell back through one of the 8 symmetries of the square.
+     *
+     * @param pos The mapped cell.
+     * @param size The size of the board.
+     * @param symmetry The symmetry, 0 to 7.
+     * @return The cell transformCell maps onto pos.
+     */
+    CellPos PositionDB::inverseTransformCell(const CellPos& pos, int size, int symmetry){
+        CellPos result = pos;
+        if (symmetry & 1){
+            result.x = size - 1 - result.x;
+        }
+        if (symmetry & 2){
+            result.y = size - 1 - result.y;
+        }
+        return (symmetry & 4) ? CellPos{ result.y, result.x } : result;
+    }
+
+    /**
+     * @brief Writes a database file from entries sorted by key.
+     *
+     * @param path The file path, an existing file is replaced.
+     * @param entries The entries, sorted by key without duplicates.
+     * @param indexStride Entries per sparse index key.
+     * @return true on success, false if the file cannot be written.
+     */
+    bool PositionDB::write(const std::string& path, const std::vector<Entry>& entries, uint32_t indexStride){
+        if (0 == indexStride){
+            LOG_ERROR("Invalid index stride");
+            return false;
+        }
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file){
+            LOG_ERROR("Cannot create position database " + path);
+            return false;
+        }
+
+        uint8_t header[FILE_HEADER_SIZE] = {};
+        const uint64_t entryCount = entries.size();
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        header[4] = VERSION;
+        std::memcpy(header + 8, &entryCount, sizeof(entryCount));
+        std::memcpy(header + 16, &indexStride, sizeof(indexStride));
+
+        std::vector<uint64_t> keys;
+        keys.reserve((entries.size() + indexStride - 1) / indexStride);
+        for (size_t i = 0; i < entries.size(); i += indexStride){
+            keys.push_back(entries[i].key);
+        }
+
+        bool ok = 1 == std::fwrite(header, sizeof(header), 1, file);
+        ok = ok && entries.size() == std::fwrite(entries.data(), sizeof(Entry), entries.size(), file);
+        ok = ok && keys.size() == std::fwrite(keys.data(), sizeof(uint64_t), keys.size(), file);
+        ok = (0 == std::fclose(file)) && ok;
+        if (!ok){
+            LOG_ERROR("Cannot write position database " + path);
+        }
+        return ok;
+    }
+
+} // namespace tictactoe
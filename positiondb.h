@@ -0,0 +1,148 @@
+/**
+ * @file positiondb.h
+ * @brief Header file for the PositionDB class.
+ *
+ * This file contains the declaration of the PositionDB class, a read-only table of statistics
+ * gathered from recorded games and keyed by the canonical hash of each position. A file starts
+ * with a 24 byte header ("TTTP", version, 3 reserved bytes, u64 entry count, u32 index stride,
+ * u32 reserved), followed by the entries sorted by key and by a sparse index holding the key of
+ * every index stride'th entry. Integers are stored in the byte order of the host.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef POSITIONDB_H
+#define POSITIONDB_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "board.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Statistics of a position, as seen by the side to move.
+     */
+    struct PositionStats{
+        uint32_t visits = 0; /**< Games that reached the position. */
+        uint32_t wins = 0; /**< Games won by the side to move. */
+        uint32_t draws = 0; /**< Games drawn. */
+        uint32_t losses = 0; /**< Games lost by the side to move. */
+        bool hasReply = false; /**< A reply was recorded. */
+        CellPos reply{ 0, 0 }; /**< The reply played most often, on the looked up board. */
+        uint32_t replyCount = 0; /**< Games in which the reply was played. */
+    };
+
+    /**
+     * @brief The PositionDB class looks up statistics of positions in a memory-mapped table.
+     *
+     * Positions equal under one of the 8 symmetries of the square share an entry, and so do
+     * positions equal after swapping the colors and the side to move, so a reply is stored on
+     * the canonical board and mapped back to the board that was looked up. A lookup is a
+     * binary search of the sparse index followed by one of a single block of entries.
+     */
+    class PositionDB{
+    public:
+        static constexpr uint8_t VERSION = 2;
+        static constexpr size_t FILE_HEADER_SIZE = 24;
+        static constexpr uint32_t DEFAULT_INDEX_STRIDE = 64;
+        static constexpr uint16_t NO_REPLY = 0xFFFF;
+        static constexpr int SYMMETRY_COUNT = 8;
+
+        /**
+         * @brief One position of the table, 32 bytes.
+         */
+        struct Entry{
+            uint64_t key; /**< Canonical key of the position. */
+            uint32_t visits; /**< Games that reached the position. */
+            uint32_t wins; /**< Games won by the side to move. */
+            uint32_t draws; /**< Games drawn. */
+            uint32_t losses; /**< Games lost by the side to move. */
+            uint16_t reply; /**< Row-major cell of the most frequent reply on the canonical board, NO_REPLY if none. */
+            uint16_t reserved; /**< Zero. */
+            uint32_t replyCount; /**< Games in which the reply was played. */
+        };
+
+        /**
+         * @brief Constructs an empty database, call open before looking up positions.
+         */
+        PositionDB();
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~PositionDB();
+
+        PositionDB(const PositionDB&) = delete;
+        PositionDB& operator=(const PositionDB&) = delete;
+
+        /**
+         * @brief Maps a database file.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void close();
+
+        /**
+         * @brief Gets the number of positions in the database.
+         */
+        inline size_t getEntryCount() const { return count; }
+
+        /**
+         * @brief Looks up the statistics of a position.
+         */
+        bool lookup(const Board& board, Symbol mover, PositionStats& stats) const;
+
+        /**
+         * @brief Finds the entry of a canonical key.
+         */
+        const Entry* find(uint64_t key) const;
+
+        /**
+         * @brief Gets the canonical key of a position with a side to move and the symmetry that produces it.
+         */
+        static uint64_t canonicalKey(const Board& board, Symbol mover, int& symmetry, int* symmetries = nullptr);
+
+        /**
+         * @brief Maps a cell onto the canonical board as the smallest of its equivalent cells.
+         */
+        static uint16_t canonicalCell(const CellPos& pos, int size, int symmetries);
+
+        /**
+         * @brief Maps a cell through one of the 8 symmetries of the square.
+         */
+        static CellPos transformCell(const CellPos& pos, int size, int symmetry);
+
+        /**
+         * @brief Maps a cell back through one of the 8 symmetries of the square.
+         */
+        static CellPos inverseTransformCell(const CellPos& pos, int size, int symmetry);
+
+        /**
+         * @brief Writes a database file from entries sorted by key.
+         */
+        static bool write(const std::string& path, const std::vector<Entry>& entries, uint32_t indexStride = DEFAULT_INDEX_STRIDE);
+
+    private:
+        const uint8_t* data; /**< Start of the mapped file. */
+        size_t length; /**< Length of the mapped file. */
+        const Entry* entries; /**< The sorted entries inside the mapping. */
+        size_t count; /**< Number of entries. */
+        const uint64_t* index; /**< Key of every indexStride'th entry inside the mapping. */
+        size_t indexCount; /**< Number of index keys. */
+        uint32_t indexStride; /**< Entries per index key. */
+#if defined(_WIN32)
+        std::vector<uint64_t> contents; /**< The file, read into memory where mmap is unavailable. */
+#endif
+    };
+
+} // namespace tictactoe
+
+#endif // POSITIONDB_H
@@ -0,0 +1,41 @@
+/**
+ * @file qtadapter.h
+ * @brief Header file for the conversions between engine and Qt types.
+ *
+ * This file contains the helpers the Qt front end uses to convert the plain C++ types of the
+ * game engine to and from their Qt counterparts.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef QTADAPTER_H
+#define QTADAPTER_H
+
+#include <QString>
+#include <QPoint>
+#include <string_view>
+#include "commondef.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Converts an engine string to a QString.
+     */
+    inline QString toQString(std::string_view text) { return QString::fromUtf8(text.data(), static_cast<int>(text.size())); }
+
+    /**
+     * @brief Converts a cell coordinate to a QPoint.
+     */
+    inline QPoint toQPoint(const CellPos& pos) { return QPoint(pos.x, pos.y); }
+
+    /**
+     * @brief Converts a QPoint to a cell coordinate.
+     */
+    inline CellPos toCellPos(const QPoint& point) { return CellPos{ point.x(), point.y() }; }
+
+} // namespace tictactoe
+
+#endif // QTADAPTER_H
@@ -9,7 +9,6 @@
  */
 
 #include "randomai.h"
-#include <ctime>
 
 namespace tictactoe{
 
@@ -24,27 +23,23 @@ namespace tictactoe{
      * @brief Generates a random move for the AI player.
      *
      * This function generates a random move for the AI player by selecting a random empty cell on the board.
+     * The cell is picked from the board's list of empty cells with a single draw of the AI's own generator,
+     * so the moves follow from the seed set by the AI factory.
      *
      * @param board The current game board.
      * @param symbol The symbol of the AI player.
-     * @return QPoint The randomly selected move represented by the row and column indices.
+     * @return CellPos The randomly selected move represented by the row and column indices.
      */
-    QPoint RandomAI::makeMove(const Board& board, Symbol symbol) const {
-        // Seed the random number generator
-        srand(static_cast<unsigned int>(time(nullptr)));
-
-        // Get the board size
-        int size = board.getSize();
-
-        // Generate random row and column indices until an empty cell is found
-        int row, col;
-        do{
-            row = rand() % size;
-            col = rand() % size;
-        } while (!board.isEmpty(QPoint(col, row))); // Note: QPoint uses (x, y) coordinates, so we swap col and row
-
-        // Return the randomly selected move
-        return QPoint(col, row); // Note: Swap col and row when creating the QPoint
+    CellPos RandomAI::makeMove(const Board& board, Symbol symbol) const {
+        const int count = board.getEmptyCount();
+        if (0 == count){
+            LOG_ERROR("No empty cell to play");
+            return CellPos{ 0, 0 };
+        }
+        const CellPos move = board.getEmptyCell(static_cast<int>(rng.below(static_cast<uint32_t>(count))));
+        lastStats = SearchStats();
+        lastStats.pv.assign(1, move);
+        return move;
     }
 
 } // namespace tictactoe
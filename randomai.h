@@ -14,6 +14,7 @@
 #define RANDOMAI_H
 
 #include "gameai.h"
+#include "rng.h"
 
 namespace tictactoe{
 
@@ -30,7 +31,20 @@ namespace tictactoe{
         /**
          * @brief Makes a move on the board.
          */
-        QPoint makeMove(const Board& board, Symbol symbol) const override;
+        CellPos makeMove(const Board& board, Symbol symbol) const override;
+
+        /**
+         * @brief Gets the type of the AI.
+         */
+        inline AIType getType() const override { return AIType::Random; }
+
+        /**
+         * @brief Restarts the random choices of the AI from a seed.
+         */
+        inline void setSeed(uint64_t seed) override { rng.seed(seed); }
+
+    private:
+        mutable Rng rng; /**< Source of the moves, owned by this AI so AIs on other threads never share it. */
     };
 
 } // namespace tictactoe
@@ -0,0 +1,120 @@
+/**
+ * @file records.cpp
+ * @brief Implementation file for the game record inspection tool.
+ *
+ * This file contains a command line tool that summarizes a binary game record file or prints
+ * a range of its games in move notation.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "gamerecord.h"
+#include "notation.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    const char* playerName(const RecordedPlayer& player){
+        if (Player_Type::COMPUTER != player.type){
+            return "human";
+        }
+        return AIType::Random == player.aitype ? "random" : "minimax";
+    }
+
+    const char* resultName(const GameRecord& record){
+        if (!record.finished){
+            return "*";
+        }
+        return Symbol::X == record.winner ? "x" : Symbol::O == record.winner ? "o" : "draw";
+    }
+
+    /**
+     * @brief Prints the number of games and their results.
+     */
+    int printInfo(const GameRecordReader& reader){
+        GameRecord record;
+        unsigned long long results[4] = { 0, 0, 0, 0 }; // unfinished, X, O, draw
+        unsigned long long moves = 0;
+        for (size_t i = 0; i < reader.getGameCount(); i++){
+            if (!reader.readGame(i, record)){
+                std::fprintf(stderr, "game %zu is malformed\n", i);
+                return 1;
+            }
+            const int result = !record.finished ? 0 : Symbol::X == record.winner ? 1 : Symbol::O == record.winner ? 2 : 3;
+            results[result]++;
+            moves += record.moves.size();
+        }
+        std::printf("games        %zu\n", reader.getGameCount());
+        std::printf("moves        %llu\n", moves);
+        std::printf("X wins       %llu\n", results[1]);
+        std::printf("O wins       %llu\n", results[2]);
+        std::printf("draws        %llu\n", results[3]);
+        std::printf("unfinished   %llu\n", results[0]);
+        return 0;
+    }
+
+    /**
+     * @brief Prints games as "<index> <size> <x player> <o player> <result> [o-first] <moves...>".
+     */
+    int printGames(const GameRecordReader& reader, size_t first, size_t count){
+        GameRecord record;
+        for (size_t i = first; i < reader.getGameCount() && i - first < count; i++){
+            if (!reader.readGame(i, record)){
+                std::fprintf(stderr, "game %zu is malformed\n", i);
+                return 1;
+            }
+            std::string line = std::to_string(i) + " " + std::to_string(record.size) + " "
+                + playerName(record.players[0]) + ":" + std::to_string(static_cast<int>(record.players[0].level)) + " "
+                + playerName(record.players[1]) + ":" + std::to_string(static_cast<int>(record.players[1].level)) + " "
+                + resultName(record);
+            if (Symbol::O == record.firstMover){
+                line += " o-first";
+            }
+            for (const RecordedMove& move : record.moves){
+                line += " " + toNotation(move.pos);
+                if (record.hasTimes){
+                    line += "/" + std::to_string(move.timeUsec) + "us";
+                }
+                if (record.hasScores){
+                    line += "=" + std::to_string(move.score);
+                }
+            }
+            std::printf("%s\n", line.c_str());
+        }
+        return 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the record inspection tool.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 3 || (0 != std::strcmp(argv[1], "info") && 0 != std::strcmp(argv[1], "dump"))){
+        std::fprintf(stderr,
+            "Usage: %s info FILE\n"
+            "       %s dump FILE [FIRST [COUNT]]\n", argv[0], argv[0]);
+        return 1;
+    }
+    GameRecordReader reader;
+    if (!reader.open(argv[2])){
+        return 1;
+    }
+    if (0 == std::strcmp(argv[1], "info")){
+        return printInfo(reader);
+    }
+    const size_t first = (argc > 3) ? static_cast<size_t>(std::strtoull(argv[3], nullptr, 10)) : 0;
+    const size_t count = (argc > 4) ? static_cast<size_t>(std::strtoull(argv[4], nullptr, 10)) : reader.getGameCount();
+    return printGames(reader, first, count);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file rng.h
+ * @brief Header file for the Rng class.
+ *
+ * This file contains the Rng class, a small fast pseudo random number generator
+ * (xoshiro256**) that every AI, worker or benchmark owns its own instance of, so random
+ * choices are reproducible from a seed and never share state between threads.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+namespace tictactoe{
+
+    /**
+     * @brief The Rng class generates 64 bit pseudo random numbers with xoshiro256**.
+     *
+     * The state is expanded from a 64 bit seed with splitmix64. Independent streams, such as
+     * one per game of a match, are seeded with derive(seed, stream) so a stream depends only
+     * on the run seed and its counter, not on which thread plays it.
+     */
+    class Rng{
+    public:
+        /**
+         * @brief Constructs a generator with the given seed.
+         */
+        explicit Rng(uint64_t seed_i = 0) { seed(seed_i); }
+
+        /**
+         * @brief Restarts the generator from a seed.
+         */
+        inline void seed(uint64_t seed_i){
+            for (uint64_t& word : state){
+                seed_i += GOLDEN_GAMMA;
+                word = mix(seed_i);
+            }
+        }
+
+        /**
+         * @brief Gets the next 64 bit number.
+         */
+        inline uint64_t next(){
+            const uint64_t result = rotl(state[1] * 5, 7) * 9;
+            const uint64_t shifted = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= shifted;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+
+        /**
+         * @brief Gets a uniformly distributed number in [0, bound), bound must be positive.
+         *
+         * Uses Lemire's multiply and shift, rejecting the few products that would bias the result.
+         */
+        inline uint32_t below(uint32_t bound){
+            uint64_t product = (next() >> 32) * bound;
+            uint32_t low = static_cast<uint32_t>(product);
+            if (low < bound){
+                const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+                while (low < threshold){
+                    product = (next() >> 32) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            return static_cast<uint32_t>(product >> 32);
+        }
+
+        /**
+         * @brief Gets a uniformly distributed number in [0, 1).
+         */
+        inline double nextDouble() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+        /**
+         * @brief Gets the seed of an independent stream of a run seed.
+         */
+        static inline uint64_t derive(uint64_t seed_i, uint64_t stream) { return mix(seed_i ^ mix(stream + GOLDEN_GAMMA)); }
+
+    private:
+        static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        /**
+         * @brief Mixes a 64 bit value into a well distributed one (splitmix64 finalizer).
+         */
+        static inline uint64_t mix(uint64_t value){
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+
+        static inline uint64_t rotl(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+    private:
+        uint64_t state[4];
+    };
+
+} // namespace tictactoe
+
+#endif // RNG_H
@@ -0,0 +1,527 @@
+/**
+ * @file search_bench.cpp
+ * @brief Implementation file for the search benchmark.
+ *
+ * This file contains a command line tool that runs every AI on the positions of a fixed
+ * corpus, at every level or for a fixed time per move, and reports nodes, speed, time to move,
+ * the chosen move and its score. At fixed levels the chosen moves are checked against the
+ * moves the corpus expects, so a change that makes the search faster can not silently change
+ * how it plays. The moves of the tactical positions are the known-correct ones rather than a
+ * snapshot of the search, so they are never rewritten by --update.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "aifactory.h"
+#include "alloctracker.h"
+#include "gameai.h"
+#include "notation.h"
+#include "perfcounters.h"
+#include "searchtask.h"
+
+using namespace tictactoe;
+
+#ifndef SEARCH_CORPUS
+#define SEARCH_CORPUS "search_corpus.txt"
+#endif
+
+namespace {
+
+    /**
+     * @brief The levels every position is searched at, in the order of the corpus columns.
+     */
+    const GameLevel LEVELS[] = { GameLevel::EASY, GameLevel::MEDIUM, GameLevel::HARD, GameLevel::EXPERT, GameLevel::MASTER };
+    const int LEVEL_COUNT = static_cast<int>(sizeof(LEVELS) / sizeof(LEVELS[0]));
+
+    /**
+     * @brief Nodes searched between two checks of the clock in fixed time mode.
+     */
+    const int TIME_SLICE_NODES = 4096;
+
+    /**
+     * @brief Seed of the random AI, so its moves repeat from run to run.
+     */
+    const uint64_t RANDOM_SEED = 1;
+
+    /**
+     * @brief Category of the positions with a win to take or to stop, whose moves are known.
+     */
+    const std::string TACTICAL = "tactical";
+
+    /**
+     * @brief Settings of a benchmark run.
+     */
+    struct Config{
+        const char* corpusPath = SEARCH_CORPUS;
+        const char* updatePath = nullptr;
+        const char* filter = nullptr; // Substring of the position names to run, all if null
+        double moveSeconds = 0.0; // Time per move, 0 to search at the fixed levels
+        bool perf = false;
+        double maxAllocsPerNode = -1.0; // Allocation budget of the minimax searches, -1 for none
+    };
+
+    /**
+     * @brief Expectation of one level: not searched, not known yet, not checked, or the moves to find.
+     */
+    struct Expected{
+        bool skip = true; // Too slow at this level, not searched
+        bool known = false; // false until the corpus is updated
+        bool unchecked = false; // Searched, but too shallow to see the tactic of the position
+        std::vector<CellPos> moves; // Any of them is right
+    };
+
+    /**
+     * @brief A position of the corpus.
+     */
+    struct Position{
+        std::string name;
+        int size = 0;
+        std::string category;
+        std::string movesText;
+        Board board;
+        Symbol mover = Symbol::X;
+        Expected expected[LEVEL_COUNT];
+        int line = 0; // Index in the corpus lines
+    };
+
+    /**
+     * @brief A search of one position by one AI.
+     */
+    struct Run{
+        CellPos move{ -1, -1 };
+        SearchStats stats;
+        double seconds = 0.0;
+        int depth = 0; // Deepest completed level in fixed time mode
+    };
+
+    /**
+     * @brief Trims spaces from both ends of a string.
+     */
+    std::string trim(const std::string& text){
+        const size_t first = text.find_first_not_of(" \t\r");
+        if (std::string::npos == first){
+            return std::string();
+        }
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    /**
+     * @brief Parses the expectation of one level, "-", "?", "*" or moves separated by "/".
+     */
+    bool parseExpected(const std::string& token, Expected& expected){
+        if ("-" == token){
+            return true;
+        }
+        expected.skip = false;
+        if ("?" == token){
+            return true;
+        }
+        if ("*" == token){
+            expected.unchecked = true;
+            return true;
+        }
+        std::stringstream stream(token);
+        std::string text;
+        while (std::getline(stream, text, '/')){
+            CellPos move;
+            if (!parseNotation(text, move)){
+                return false;
+            }
+            expected.moves.push_back(move);
+        }
+        expected.known = !expected.moves.empty();
+        return expected.known;
+    }
+
+    /**
+     * @brief Writes the expectation of one level the way parseExpected reads it.
+     */
+    std::string expectedText(const Expected& expected){
+        if (expected.skip){
+            return "-";
+        }
+        if (expected.unchecked){
+            return "*";
+        }
+        if (!expected.known){
+            return "?";
+        }
+        std::string text;
+        for (const CellPos& move : expected.moves){
+            text += (text.empty() ? "" : "/") + toNotation(move);
+        }
+        return text;
+    }
+
+    /**
+     * @brief Checks whether the move is one of the expected ones.
+     */
+    bool isExpected(const Expected& expected, const CellPos& move){
+        return std::find(expected.moves.begin(), expected.moves.end(), move) != expected.moves.end();
+    }
+
+    /**
+     * @brief Parses a corpus line "name | size | category | moves | expected moves per level".
+     *
+     * An empty move list is written "-", as is a level that is not searched; "?" searches a
+     * level whose move is not known yet and "*" one whose move is not checked. A level that
+     * accepts several moves lists them separated by "/".
+     */
+    bool parsePosition(const std::string& text, Position& position){
+        std::vector<std::string> fields;
+        std::stringstream stream(text);
+        std::string field;
+        while (std::getline(stream, field, '|')){
+            fields.push_back(trim(field));
+        }
+        if (5 != fields.size()){
+            return false;
+        }
+        position.name = fields[0];
+        position.size = std::atoi(fields[1].c_str());
+        position.category = fields[2];
+        position.movesText = fields[3];
+        if (position.size < 2 || position.size > 26){
+            return false;
+        }
+
+        std::vector<CellPos> moves;
+        if ("-" != fields[3] && !parseMoveList(fields[3], moves)){
+            return false;
+        }
+        position.board.startNewGame(position.size);
+        position.mover = Symbol::X;
+        for (const CellPos& move : moves){
+            if (move.x >= position.size || move.y >= position.size || Symbol::None != position.board.checkForWinner()
+                || !position.board.makeMove(move, position.mover)){
+                return false;
+            }
+            position.mover = position.board.getOpponent(position.mover);
+        }
+        if (Symbol::None != position.board.checkForWinner() || position.board.isBoardFull()){
+            return false; // Nothing to search
+        }
+
+        std::stringstream expected(fields[4]);
+        std::string token;
+        int level = 0;
+        while (expected >> token){
+            if (level >= LEVEL_COUNT || !parseExpected(token, position.expected[level])){
+                return false;
+            }
+            level++;
+        }
+        return LEVEL_COUNT == level;
+    }
+
+    /**
+     * @brief Reads the corpus, keeping every line for rewriting it.
+     */
+    bool readCorpus(const char* path, std::vector<std::string>& lines, std::vector<Position>& positions){
+        std::ifstream file(path);
+        if (!file){
+            std::fprintf(stderr, "cannot read %s\n", path);
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)){
+            lines.push_back(line);
+            const std::string text = trim(line);
+            if (text.empty() || '#' == text[0]){
+                continue;
+            }
+            Position position;
+            if (!parsePosition(text, position)){
+                std::fprintf(stderr, "%s:%zu: invalid position\n", path, lines.size());
+                return false;
+            }
+            position.line = static_cast<int>(lines.size()) - 1;
+            positions.push_back(std::move(position));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Searches a position at a fixed level with cold caches.
+     */
+    Run searchAtLevel(GameAI& ai, const Position& position, GameLevel level){
+        ai.clearCaches();
+        ai.setLevel(level);
+        Run run;
+        const auto start = std::chrono::steady_clock::now();
+        run.move = ai.makeMove(position.board, position.mover);
+        run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        run.stats = ai.getLastStats();
+        run.depth = static_cast<int>(level);
+        return run;
+    }
+
+    /**
+     * @brief Searches a position deeper and deeper until the time is up.
+     *
+     * The move of the deepest level completed in time is played; the caches are kept between
+     * levels like in an iterative deepening search.
+     */
+    Run searchForTime(GameAI& ai, const Position& position, double seconds){
+        ai.clearCaches();
+        Run run;
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+        uint64_t nodes = 0;
+        const int maxDepth = position.board.getEmptyCount();
+        for (int depth = 0; depth <= maxDepth; depth++){
+            ai.setLevel(static_cast<GameLevel>(depth));
+            std::unique_ptr<SearchTask> task = ai.createSearch(position.board, position.mover);
+            bool late = false;
+            while (!task->step(TIME_SLICE_NODES)){
+                if (std::chrono::steady_clock::now() >= deadline){
+                    late = true;
+                    break;
+                }
+            }
+            nodes += task->getNodes();
+            if (late && depth > 0){
+                break; // Keep the move of the last complete level
+            }
+            run.move = task->getBestMove();
+            run.stats = task->getStats();
+            run.depth = depth;
+            if (late){
+                break;
+            }
+        }
+        run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        run.stats.nodes = nodes;
+        run.stats.elapsedNsec = static_cast<uint64_t>(run.seconds * 1e9);
+        return run;
+    }
+
+    /**
+     * @brief Gets the name of an AI type as it appears in the report.
+     */
+    const char* typeName(AIType type){
+        return (AIType::Random == type) ? "random" : "minimax";
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --corpus FILE   positions to search (default %s)\n"
+            "  --time MS       search each position for a fixed time instead of at every level\n"
+            "  --filter TEXT   only the positions whose name contains TEXT\n"
+            "  --perf 1        count cycles, instructions, cache and branch misses of each search (Linux)\n"
+            "  --update FILE   write the corpus with the moves found as the expected ones, except in\n"
+            "                  the tactical positions\n"
+            "  --max-allocs-per-node X  fail if the minimax searches allocate more often, needs a\n"
+            "                  -DTICTACTOE_ALLOC_TRACKING=ON build\n"
+            "Exits with 2 if a move differs from the expected one or is not known, or the searches allocate too often.\n",
+            program, SEARCH_CORPUS);
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--corpus")){
+                config.corpusPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--time")){
+                config.moveSeconds = std::atof(value) / 1000.0;
+                if (config.moveSeconds <= 0.0){
+                    return false;
+                }
+            }
+            else if (0 == std::strcmp(arg, "--filter")){
+                config.filter = value;
+            }
+            else if (0 == std::strcmp(arg, "--perf")){
+                config.perf = 0 != std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--update")){
+                config.updatePath = value;
+            }
+            else if (0 == std::strcmp(arg, "--max-allocs-per-node")){
+                config.maxAllocsPerNode = std::atof(value);
+                if (config.maxAllocsPerNode < 0.0){
+                    return false;
+                }
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return !(config.updatePath && config.moveSeconds > 0.0);
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the search benchmark.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application, 2 if a move differs from the expected one.
+ */
+int main(int argc, char* argv[])
+{
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    std::vector<Position> positions;
+    if (!readCorpus(config.corpusPath, lines, positions)){
+        return 1;
+    }
+
+    std::unique_ptr<GameAI> ais[] = { AIFactory::createAI(AIType::Minimax), AIFactory::createAI(AIType::Random) };
+    PerfCounters counters;
+    if (config.perf && !counters.open()){
+        std::fprintf(stderr, "warning: perf counters unavailable\n");
+    }
+    if (config.maxAllocsPerNode >= 0.0 && !AllocTracker::isHooked()){
+        std::fprintf(stderr, "allocations are not counted in this build, configure with -DTICTACTOE_ALLOC_TRACKING=ON\n");
+        return 1;
+    }
+
+    std::printf("%-24s %-7s %5s %5s %6s %12s %12s %10s  %s\n", "position", "ai", "level", "move", "score", "nodes", "nodes/s", "ms", "check");
+    int checked = 0;
+    int failed = 0;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+    PerfSample totalPerf;
+    uint64_t searchNodes = 0; // Nodes of the minimax searches
+    uint64_t searchAllocations = 0; // Allocations of the minimax searches
+    for (Position& position : positions){
+        if (config.filter && std::string::npos == position.name.find(config.filter)){
+            continue;
+        }
+        for (std::unique_ptr<GameAI>& ai : ais){
+            const bool scores = AIType::Minimax == ai->getType();
+            // The random AI ignores the level, so it moves once per position
+            const int levels = (scores && config.moveSeconds <= 0.0) ? LEVEL_COUNT : 1;
+            for (int level = 0; level < levels; level++){
+                if (scores && config.moveSeconds <= 0.0 && position.expected[level].skip){
+                    continue;
+                }
+                ai->setSeed(RANDOM_SEED);
+                const AllocCounts allocStart = AllocTracker::threadCounts();
+                const PerfSample perfStart = counters.read();
+                const Run run = (scores && config.moveSeconds > 0.0) ? searchForTime(*ai, position, config.moveSeconds)
+                    : searchAtLevel(*ai, position, LEVELS[level]);
+                const PerfSample perf = counters.read() - perfStart;
+                totalPerf += perf;
+                if (scores){
+                    searchNodes += run.stats.nodes;
+                    searchAllocations += (AllocTracker::threadCounts() - allocStart).allocations;
+                }
+                totalNodes += run.stats.nodes;
+                totalSeconds += run.seconds;
+
+                const char* check = "-";
+                if (run.move.x < 0 || run.move.y < 0 || run.move.x >= position.size || run.move.y >= position.size
+                    || !position.board.isEmpty(run.move)){
+                    check = "ILLEGAL";
+                    failed++;
+                }
+                else if (scores && config.moveSeconds <= 0.0 && position.expected[level].unchecked){
+                    check = "unchecked";
+                }
+                else if (scores && config.moveSeconds <= 0.0){
+                    checked++;
+                    if (config.updatePath && TACTICAL != position.category){
+                        position.expected[level].moves.assign(1, run.move);
+                        position.expected[level].known = true;
+                        check = "updated";
+                    }
+                    else if (!position.expected[level].known){
+                        check = "unknown";
+                        failed++;
+                    }
+                    else if (isExpected(position.expected[level], run.move)){
+                        check = "ok";
+                    }
+                    else{
+                        check = "FAIL";
+                        failed++;
+                    }
+                }
+
+                char levelText[16];
+                std::snprintf(levelText, sizeof(levelText), scores ? "%d" : "-", run.depth);
+                const double nodesPerSec = run.seconds > 0.0 ? static_cast<double>(run.stats.nodes) / run.seconds : 0.0;
+                std::printf("%-24s %-7s %5s %5s %6d %12llu %12.0f %10.3f  %s", position.name.c_str(), typeName(ai->getType()), levelText,
+                    toNotation(run.move).c_str(), run.stats.score, static_cast<unsigned long long>(run.stats.nodes), nodesPerSec,
+                    run.seconds * 1000.0, check);
+                if (0 == std::strcmp(check, "FAIL")){
+                    std::printf(" (expected %s)", expectedText(position.expected[level]).c_str());
+                }
+                std::printf("\n");
+                if (config.perf && counters.isOpen() && run.stats.nodes > 0){
+                    std::printf("%24s %s\n", "", perf.toString(run.stats.nodes).c_str());
+                }
+            }
+        }
+    }
+
+    std::printf("total        %llu nodes in %.3f s, %.0f nodes/s\n", static_cast<unsigned long long>(totalNodes), totalSeconds,
+        totalSeconds > 0.0 ? static_cast<double>(totalNodes) / totalSeconds : 0.0);
+    if (config.perf){
+        std::printf("perf         %s\n", totalPerf.toString(totalNodes).c_str());
+    }
+    bool overBudget = false;
+    if (AllocTracker::isHooked()){
+        const double perNode = searchNodes > 0 ? static_cast<double>(searchAllocations) / static_cast<double>(searchNodes) : 0.0;
+        std::printf("allocations  %llu in minimax searches, %.4f per node\n", static_cast<unsigned long long>(searchAllocations), perNode);
+        if (config.maxAllocsPerNode >= 0.0 && perNode > config.maxAllocsPerNode){
+            std::printf("allocations  over the budget of %.4f per node\n", config.maxAllocsPerNode);
+            overBudget = true;
+        }
+        if (AllocTracker::isCompiledIn()){
+            std::printf("%s", AllocTracker::scopesToString().c_str());
+        }
+    }
+    if (config.moveSeconds > 0.0){
+        std::printf("moves        not checked in fixed time mode, the depth reached depends on the machine\n");
+    }
+    else{
+        std::printf("moves        %d checked, %d failed\n", checked, failed);
+    }
+
+    if (config.updatePath){
+        for (const Position& position : positions){
+            std::string expected;
+            for (int level = 0; level < LEVEL_COUNT; level++){
+                expected += (level > 0 ? " " : "") + expectedText(position.expected[level]);
+            }
+            lines[static_cast<size_t>(position.line)] = position.name + " | " + std::to_string(position.size) + " | "
+                + position.category + " | " + position.movesText + " | " + expected;
+        }
+        std::ofstream file(config.updatePath, std::ios::trunc);
+        for (const std::string& line : lines){
+            file << line << "\n";
+        }
+        if (!file){
+            std::fprintf(stderr, "cannot write %s\n", config.updatePath);
+            return 1;
+        }
+    }
+    return (failed > 0 || overBudget) ? 2 : 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file searchstats.cpp
+ * @brief Implementation file for the SearchStats structure.
+ *
+ * This file contains the formatting of search statistics and the principal variation table.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include "searchstats.h"
+#include "notation.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Formats the statistics on one line.
+     *
+     * @return For example "depth 4, 812 nodes, 301 leaves, 95 cutoffs, cache 120/410, 0.214 ms, 3.79M nodes/s, pv b2 a1 c3".
+     */
+    std::string SearchStats::toString() const{
+        char text[256];
+        std::snprintf(text, sizeof(text), "depth %d, %llu nodes, %llu leaves, %llu cutoffs, cache %llu/%llu, %.3f ms, %.2fM nodes/s",
+            maxDepth, static_cast<unsigned long long>(nodes), static_cast<unsigned long long>(leafEvals),
+            static_cast<unsigned long long>(cutoffs), static_cast<unsigned long long>(cacheHits),
+            static_cast<unsigned long long>(cacheHits + cacheMisses), elapsedNsec / 1e6, getNodesPerSec() / 1e6);
+        std::string result = text;
+        if (!pv.empty()){
+            result += ", pv";
+            for (const CellPos& move : pv){
+                result += " " + toNotation(move);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Sizes the table for a search reaching at most the given ply and empties it.
+     *
+     * @param maxPly The deepest ply a node of the search can be at, 0 for the root.
+     */
+    void PVTable::reset(int maxPly){
+        stride = maxPly + 1;
+        moves.resize(static_cast<size_t>(stride * stride));
+        length.assign(static_cast<size_t>(stride), 0);
+    }
+
+    /**
+     * @brief Sets the variation of a ply to a move followed by the variation of the ply below.
+     *
+     * @param ply The ply of the node the move is made from, 0 for the root.
+     * @param move The best move of the node so far.
+     */
+    void PVTable::update(int ply, const CellPos& move){
+        CellPos* row = &moves[static_cast<size_t>(ply * stride)];
+        const int below = (ply + 1 < stride) ? length[ply + 1] : 0;
+        row[0] = move;
+        if (below > 0){
+            const CellPos* next = &moves[static_cast<size_t>((ply + 1) * stride)];
+            std::copy(next, next + below, row + 1);
+        }
+        length[ply] = below + 1;
+    }
+
+} // namespace tictactoe
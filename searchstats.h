@@ -0,0 +1,87 @@
+/**
+ * @file searchstats.h
+ * @brief Header file for the SearchStats structure and the PVTable class.
+ *
+ * This file contains the declaration of the SearchStats structure, the counters an AI collects
+ * while searching for a move, kept so callers can see where the time of a move went, and of
+ * the PVTable class the searches collect their principal variation with.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "commondef.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Statistics of one search for a move.
+     */
+    struct SearchStats{
+        uint64_t nodes = 0; /**< Positions visited below the root. */
+        uint64_t leafEvals = 0; /**< Positions scored at the depth limit. */
+        uint64_t cutoffs = 0; /**< Positions whose remaining moves were pruned. */
+        uint64_t cacheHits = 0; /**< Positions answered by the transposition table. */
+        uint64_t cacheMisses = 0; /**< Positions the transposition table could not answer. */
+        int maxDepth = 0; /**< Deepest ply below the root reached. */
+        uint64_t elapsedNsec = 0; /**< Wall time of the search. */
+        int score = 0; /**< Score of the chosen move for the side to move, 0 for AIs that do not score moves. */
+        std::vector<CellPos> pv; /**< Principal variation, the move played first, shorter where it reaches a cached position. */
+
+        /**
+         * @brief Gets the search speed.
+         */
+        inline double getNodesPerSec() const { return elapsedNsec > 0 ? nodes * 1e9 / static_cast<double>(elapsedNsec) : 0.0; }
+
+        /**
+         * @brief Formats the statistics on one line.
+         */
+        std::string toString() const;
+    };
+
+    /**
+     * @brief The PVTable class collects the principal variation during a depth-first search.
+     *
+     * Each ply of the current path has a row holding the best line found below it so far;
+     * when a move improves a node, the node's row becomes the move followed by the row of
+     * the ply below, so the root's row is the principal variation once the search ends.
+     */
+    class PVTable{
+    public:
+        /**
+         * @brief Sizes the table for a search reaching at most the given ply and empties it.
+         */
+        void reset(int maxPly);
+
+        /**
+         * @brief Empties the variation of a ply, called when the search enters a node there.
+         */
+        inline void clear(int ply) { length[ply] = 0; }
+
+        /**
+         * @brief Sets the variation of a ply to a move followed by the variation of the ply below.
+         */
+        void update(int ply, const CellPos& move);
+
+        /**
+         * @brief Gets the variation of the root.
+         */
+        inline std::vector<CellPos> getLine() const { return std::vector<CellPos>(moves.begin(), moves.begin() + length[0]); }
+
+    private:
+        int stride = 0; // Row length, one more than the deepest ply
+        std::vector<CellPos> moves; // One row per ply
+        std::vector<int> length; // Length of the variation in each row
+    };
+
+} // namespace tictactoe
+
+#endif // SEARCHSTATS_H
@@ -0,0 +1,82 @@
+/**
+ * @file searchstepper.cpp
+ * @brief Implementation file for the SearchStepper class.
+ *
+ * This file contains the implementation of the SearchStepper class.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <QElapsedTimer>
+#include "searchstepper.h"
+#include "qtadapter.h"
+#include "trace.h"
+
+/**
+ * @brief Constructor for the SearchStepper class.
+ *
+ * @param parent The parent object.
+ */
+SearchStepper::SearchStepper(QObject* parent)
+    : QObject(parent)
+    , nodesPerStep(DEFAULT_NODES_PER_STEP)
+    , sliceUsec(DEFAULT_SLICE_USEC) {
+    timer.setInterval(0);
+    connect(&timer, &QTimer::timeout, this, &SearchStepper::runSlice);
+}
+
+/**
+ * @brief Starts running the given search, replacing any running one.
+ *
+ * @param task_i The search to run.
+ */
+void SearchStepper::start(std::unique_ptr<tictactoe::SearchTask> task_i) {
+    if (!task_i) {
+        LOG_ERROR("Invalid search task");
+        return;
+    }
+    task = std::move(task_i);
+    timer.start();
+}
+
+/**
+ * @brief Stops and discards the running search.
+ */
+void SearchStepper::cancel() {
+    timer.stop();
+    task.reset();
+}
+
+/**
+ * @brief Advances the search for one time slice.
+ *
+ * The clock is only read between steps, so a slice overshoots its budget by at most one step.
+ */
+void SearchStepper::runSlice() {
+    TRACE_SCOPE("SearchStepper::runSlice");
+    if (!task) {
+        timer.stop();
+        return;
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+    const quint64 startNodes = task->getNodes();
+    const qint64 budgetNsec = static_cast<qint64>(sliceUsec) * 1000;
+
+    bool done = false;
+    do {
+        done = task->step(nodesPerStep);
+    } while (!done && clock.nsecsElapsed() < budgetNsec);
+
+    emit sliceFinished(task->getNodes() - startNodes, clock.nsecsElapsed());
+
+    if (done) {
+        timer.stop();
+        const QPoint move = tictactoe::toQPoint(task->getBestMove());
+        lastStats = task->getStats();
+        task.reset();
+        emit finished(move);
+    }
+}
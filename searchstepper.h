@@ -0,0 +1,97 @@
+/**
+ * @file searchstepper.h
+ * @brief Header file for the SearchStepper class.
+ *
+ * This file contains the declaration of the SearchStepper class, which drives a resumable
+ * search from the Qt event loop in short time slices, without a second thread.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef SEARCHSTEPPER_H
+#define SEARCHSTEPPER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QPoint>
+#include <memory>
+#include "searchtask.h"
+
+/**
+ * @brief The SearchStepper class runs a SearchTask cooperatively on the GUI thread.
+ *
+ * Each time the event loop is idle the task is advanced in steps of a fixed number of nodes
+ * until the slice budget is used up, then control returns to the event loop so painting and
+ * input stay responsive.
+ */
+class SearchStepper : public QObject{
+    Q_OBJECT
+
+public:
+    static const int DEFAULT_NODES_PER_STEP = 256; /**< Nodes visited between two clock checks. */
+    static const int DEFAULT_SLICE_USEC = 2000; /**< Time budget of one slice in microseconds. */
+
+    /**
+     * @brief Constructs a SearchStepper object.
+     */
+    explicit SearchStepper(QObject* parent = nullptr);
+
+    /**
+     * @brief Starts running the given search, replacing any running one.
+     */
+    void start(std::unique_ptr<tictactoe::SearchTask> task_i);
+
+    /**
+     * @brief Stops and discards the running search.
+     */
+    void cancel();
+
+    /**
+     * @brief Checks if a search is running.
+     */
+    inline bool isRunning() const { return task != nullptr; }
+
+    /**
+     * @brief Sets the number of nodes visited between two clock checks.
+     */
+    inline void setNodesPerStep(int nodes) { nodesPerStep = qMax(1, nodes); }
+
+    /**
+     * @brief Sets the time budget of one slice in microseconds.
+     */
+    inline void setSliceBudget(int usec) { sliceUsec = qMax(1, usec); }
+
+    /**
+     * @brief Gets the statistics of the last finished search.
+     */
+    inline const tictactoe::SearchStats& getLastStats() const { return lastStats; }
+
+signals:
+    /**
+     * @brief Emitted after every slice with the work done in it.
+     */
+    void sliceFinished(quint64 nodes, qint64 elapsedNsec);
+
+    /**
+     * @brief Emitted once the search has found its move.
+     */
+    void finished(QPoint move);
+
+private slots:
+    /**
+     * @brief Advances the search for one time slice.
+     */
+    void runSlice();
+
+private:
+    std::unique_ptr<tictactoe::SearchTask> task; /**< The running search, nullptr if idle. */
+    QTimer timer; /**< Zero interval timer scheduling the slices. */
+    int nodesPerStep; /**< Nodes visited between two clock checks. */
+    int sliceUsec; /**< Time budget of one slice in microseconds. */
+    tictactoe::SearchStats lastStats; /**< Statistics of the last finished search, kept after the task is discarded. */
+};
+
+#endif // SEARCHSTEPPER_H
@@ -0,0 +1,70 @@
+/**
+ * @file searchtask.h
+ * @brief Header file for the SearchTask class.
+ *
+ * This file contains the declaration of the SearchTask class, the interface of a resumable
+ * search that is advanced in bounded steps instead of running to completion at once.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef SEARCHTASK_H
+#define SEARCHTASK_H
+
+#include <cstdint>
+#include "commondef.h"
+#include "searchstats.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief The SearchTask class represents a search for a move that can be run in slices.
+     *
+     * A task is created by GameAI::createSearch and refers to the AI that created it, so it
+     * must not outlive that AI and the AI must not search elsewhere while the task runs.
+     */
+    class SearchTask{
+    public:
+        /**
+         * @brief Destructor for the SearchTask class.
+         */
+        virtual ~SearchTask() = default;
+
+        /**
+         * @brief Advances the search by at most the given number of nodes.
+         */
+        virtual bool step(int maxNodes) = 0;
+
+        /**
+         * @brief Checks if the search has finished.
+         */
+        inline bool isFinished() const { return finished; }
+
+        /**
+         * @brief Gets the best move, valid once the search has finished.
+         */
+        inline CellPos getBestMove() const { return bestMove; }
+
+        /**
+         * @brief Gets the number of nodes visited so far.
+         */
+        inline uint64_t getNodes() const { return nodes; }
+
+        /**
+         * @brief Gets the statistics of the search so far, complete once it has finished.
+         */
+        inline const SearchStats& getStats() const { return stats; }
+
+    protected:
+        bool finished = false; /**< true once the search has finished. */
+        CellPos bestMove{ 0, 0 }; /**< The best move found. */
+        uint64_t nodes = 0; /**< The number of nodes visited so far. */
+        SearchStats stats; /**< Statistics of the search, stats.nodes follows nodes. */
+    };
+
+} // namespace tictactoe
+
+#endif // SEARCHTASK_H
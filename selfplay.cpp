@@ -0,0 +1,353 @@
+/**
+ * @file selfplay.cpp
+ * @brief Implementation file for the headless self-play runner.
+ *
+ * This file contains a command line tool that plays AI-vs-AI games without the GUI, spread
+ * over all cores, and reports throughput, results and move latency percentiles, optionally
+ * with the hardware performance counters of the searches.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "aifactory.h"
+#include "computerplayer.h"
+#include "evalweights.h"
+#include "gamerecord.h"
+#include "latencyhistogram.h"
+#include "metrics.h"
+#include "neuraleval.h"
+#include "notation.h"
+#include "perfcounters.h"
+#include "rng.h"
+#include "trace.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Time between two dumps of the metrics file.
+     */
+    const std::chrono::milliseconds METRICS_INTERVAL(1000);
+
+    /**
+     * @brief Settings of one side of the self-play games.
+     */
+    struct SideConfig{
+        AIType type = AIType::Minimax;
+        GameLevel level = GameLevel::EASY;
+    };
+
+    /**
+     * @brief Settings of a self-play run.
+     */
+    struct Config{
+        int size = DEFAULT_BOARD_SIZE;
+        long long games = 10000;
+        int threads = 0;
+        SideConfig sides[PLAYER_COUNT]; // X first, then O
+        const char* recordPath = nullptr;
+        const char* metricsPath = nullptr;
+        const char* tracePath = nullptr;
+        const char* evalWeightsFile = nullptr;
+        std::shared_ptr<const EvalWeights> evalWeights; // Loaded from evalWeightsFile, shared by the workers
+        const char* neuralEvalFile = nullptr;
+        std::shared_ptr<const NeuralEval> neuralEval; // Loaded from neuralEvalFile, shared by the workers
+        uint64_t seed = 0; // Seed of the random choices, random unless given
+        bool hasSeed = false;
+        bool perf = false; // Count hardware events of the workers
+    };
+
+    /**
+     * @brief Results collected by one worker thread.
+     */
+    struct WorkerResult{
+        long long wins[PLAYER_COUNT] = { 0, 0 }; // X wins, O wins
+        long long draws = 0;
+        long long errors = 0; // Games stopped by an invalid move, recorded unfinished
+        long long moves = 0;
+        unsigned long long nodes = 0; // Search nodes of all moves
+        LatencyHistogram latency;
+        PerfSample perf; // Hardware events of the whole game loop
+    };
+
+    /**
+     * @brief Plays the games [firstGame, firstGame + games) with thread-local players and board.
+     */
+    void playGames(const Config& config, long long firstGame, long long games, GameRecordWriter* recorder, WorkerResult& result){
+        Board board(config.size);
+        ComputerPlayer players[PLAYER_COUNT] = {
+            ComputerPlayer(Symbol::X, AIFactory::acquireAI(config.sides[0].type, config.size), config.size),
+            ComputerPlayer(Symbol::O, AIFactory::acquireAI(config.sides[1].type, config.size), config.size)
+        };
+        GameRecord record;
+        record.size = config.size;
+        record.hasTimes = true;
+        for (int side = 0; side < PLAYER_COUNT; side++){
+            players[side].setLevel(config.sides[side].level);
+            players[side].setEvalWeights(config.evalWeights);
+            players[side].setNeuralEval(config.neuralEval);
+            record.players[side].type = Player_Type::COMPUTER;
+            record.players[side].aitype = config.sides[side].type;
+            record.players[side].level = config.sides[side].level;
+        }
+
+        Tracer::getInstance().setThreadName("selfplay worker");
+        // Counted over the whole loop, reading the counters around each move would cost more than the move
+        PerfCounters counters;
+        if (config.perf){
+            counters.open();
+        }
+        const PerfSample perfStart = counters.read();
+        for (long long game = firstGame; game < firstGame + games; game++){
+            TRACE_SCOPE_ARG("game", game);
+            // Every game has its own seeds, so the games do not depend on the number of threads
+            for (int side = 0; side < PLAYER_COUNT; side++){
+                players[side].setSeed(Rng::derive(config.seed, static_cast<uint64_t>(game * PLAYER_COUNT + side)));
+            }
+            board.startNewGame(config.size);
+            record.moves.clear();
+            record.finished = false;
+            int side = 0;
+            while (true){
+                const auto start = std::chrono::steady_clock::now();
+                const bool moved = players[side].makeMove(CellPos{ -1, -1 }, board);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                const uint64_t nsec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                result.latency.record(nsec);
+                result.moves++;
+                result.nodes += players[side].getLastStats().nodes;
+                if (!moved){
+                    LOG_ERROR("AI made an invalid move");
+                    result.errors++;
+                    break;
+                }
+                record.moves.push_back(RecordedMove{ players[side].getCurPos(), static_cast<uint32_t>(nsec / 1000), 0 });
+
+                const Symbol winner = board.checkForWinner();
+                if (Symbol::None != winner){
+                    result.wins[Symbol::X == winner ? 0 : 1]++;
+                    record.finished = true;
+                    record.winner = winner;
+                    break;
+                }
+                if (board.isBoardFull()){
+                    result.draws++;
+                    record.finished = true;
+                    record.winner = Symbol::None;
+                    break;
+                }
+                side = 1 - side;
+            }
+            if (recorder){
+                recorder->write(record);
+            }
+        }
+        result.perf = counters.read() - perfStart;
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --size N        board size (default %d)\n"
+            "  --games N       number of games (default 10000)\n"
+            "  --threads N     worker threads (default: all cores)\n"
+            "  --x-ai TYPE     AI of X: minimax or random (default minimax)\n"
+            "  --x-level N     search depth level of X (default 0)\n"
+            "  --o-ai TYPE     AI of O: minimax or random (default minimax)\n"
+            "  --o-level N     search depth level of O (default 0)\n"
+            "  --record FILE   append every game to a binary game record file\n"
+            "  --metrics FILE  dump the engine metrics every second, as JSON for a .json file, text otherwise\n"
+            "  --trace FILE    write a Chrome trace-event timeline, needs a -DTICTACTOE_TRACE=ON build\n"
+            "  --eval FILE     evaluation weights both sides score the depth limit with\n"
+            "  --net FILE      neural network both sides score and order moves with\n"
+            "  --seed N        seed of the random choices, to replay a run (default: random)\n"
+            "  --perf 1        count cycles, instructions, cache and branch misses per node (Linux)\n",
+            program, DEFAULT_BOARD_SIZE);
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--size")){
+                config.size = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--games")){
+                config.games = std::atoll(value);
+            }
+            else if (0 == std::strcmp(arg, "--threads")){
+                config.threads = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--x-ai")){
+                if (!parseAIType(value, config.sides[0].type)) return false;
+            }
+            else if (0 == std::strcmp(arg, "--o-ai")){
+                if (!parseAIType(value, config.sides[1].type)) return false;
+            }
+            else if (0 == std::strcmp(arg, "--x-level")){
+                config.sides[0].level = static_cast<GameLevel>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(arg, "--o-level")){
+                config.sides[1].level = static_cast<GameLevel>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(arg, "--record")){
+                config.recordPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--metrics")){
+                config.metricsPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--trace")){
+                config.tracePath = value;
+            }
+            else if (0 == std::strcmp(arg, "--eval")){
+                config.evalWeightsFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--net")){
+                config.neuralEvalFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--seed")){
+                config.seed = std::strtoull(value, nullptr, 10);
+                config.hasSeed = true;
+            }
+            else if (0 == std::strcmp(arg, "--perf")){
+                config.perf = 0 != std::atoi(value);
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.size >= 2 && config.games > 0 && config.threads >= 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the self-play runner.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int threads = config.threads;
+    if (0 == threads){
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threads = static_cast<int>(std::min<long long>(threads, config.games));
+
+    if (config.evalWeightsFile){
+        auto evalWeights = std::make_shared<EvalWeights>();
+        if (!evalWeights->load(config.evalWeightsFile)){
+            return 1;
+        }
+        config.evalWeights = std::move(evalWeights);
+    }
+    if (config.neuralEvalFile){
+        auto neuralEval = std::make_shared<NeuralEval>();
+        if (!neuralEval->load(config.neuralEvalFile)){
+            return 1;
+        }
+        config.neuralEval = std::move(neuralEval);
+    }
+
+    GameRecordWriter recorder;
+    if (config.recordPath && !recorder.open(config.recordPath)){
+        return 1;
+    }
+    if (config.tracePath){
+        if (!Tracer::isCompiledIn()){
+            std::fprintf(stderr, "warning: trace spans are not compiled in, the trace will be empty\n");
+        }
+        Tracer::getInstance().start();
+    }
+    if (config.metricsPath && !Metrics::getInstance().startDump(config.metricsPath, Metrics::formatOf(config.metricsPath), METRICS_INTERVAL)){
+        return 1;
+    }
+
+    // Each worker owns its board, players and AIs, only the record file is shared
+    if (!config.hasSeed){
+        config.seed = (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+    }
+
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    long long firstGame = 0;
+    for (int t = 0; t < threads; t++){
+        const long long games = config.games / threads + (t < config.games % threads ? 1 : 0);
+        workers.emplace_back(playGames, std::cref(config), firstGame, games, config.recordPath ? &recorder : nullptr, std::ref(results[t]));
+        firstGame += games;
+    }
+    for (std::thread& worker : workers){
+        worker.join();
+    }
+    if (config.metricsPath){
+        Metrics::getInstance().stopDump(); // Writes the totals of the finished workers
+    }
+    if (config.tracePath){
+        Tracer::getInstance().stop();
+        if (!Tracer::getInstance().writeChromeTrace(config.tracePath)){
+            return 1;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WorkerResult total;
+    for (const WorkerResult& result : results){
+        total.wins[0] += result.wins[0];
+        total.wins[1] += result.wins[1];
+        total.draws += result.draws;
+        total.errors += result.errors;
+        total.moves += result.moves;
+        total.nodes += result.nodes;
+        total.latency.merge(result.latency);
+        total.perf += result.perf;
+    }
+
+    const double games = static_cast<double>(config.games);
+    // The rates are of the games played to the end
+    const double finished = std::max(1.0, games - static_cast<double>(total.errors));
+    std::printf("games        %lld on %d threads in %.3f s\n", config.games, threads, seconds);
+    std::printf("seed         %llu\n", static_cast<unsigned long long>(config.seed));
+    std::printf("games/sec    %.1f\n", games / seconds);
+    std::printf("moves/sec    %.1f\n", static_cast<double>(total.moves) / seconds);
+    std::printf("nodes/sec    %.1f\n", static_cast<double>(total.nodes) / seconds);
+    std::printf("X wins       %lld (%.2f%%)\n", total.wins[0], 100.0 * total.wins[0] / finished);
+    std::printf("O wins       %lld (%.2f%%)\n", total.wins[1], 100.0 * total.wins[1] / finished);
+    std::printf("draws        %lld (%.2f%%)\n", total.draws, 100.0 * total.draws / finished);
+    std::printf("errors       %lld games stopped by an invalid move\n", total.errors);
+    std::printf("move latency p50 %llu ns, p90 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns\n",
+        static_cast<unsigned long long>(total.latency.percentile(0.50)),
+        static_cast<unsigned long long>(total.latency.percentile(0.90)),
+        static_cast<unsigned long long>(total.latency.percentile(0.99)),
+        static_cast<unsigned long long>(total.latency.percentile(0.999)),
+        static_cast<unsigned long long>(total.latency.percentile(1.0)));
+    if (config.perf){
+        std::printf("perf         %s\n", total.perf.toString(total.nodes).c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,887 @@
+/**
+ * @file server.cpp
+ * @brief Implementation file for the multi-session game server.
+ *
+ * This file contains a server daemon that hosts many games at once for clients connecting to
+ * a Unix domain socket. One thread owns the sockets and all sessions; computer moves are
+ * computed by a shared pool of worker threads. The protocol is line based:
+ *
+ *   new <2-8> <x|o> <minimax|random> <level>    open a game, the human plays the given symbol,
+ *                                               reply "session <id>"
+ *   play <id> <move>                            play the human's move, the computer's reply
+ *                                               arrives later as "move <id> <move>"
+ *   close <id>                                  end a game, reply "closed <id>"
+ *   stats                                       reply "stats ..." with server counters
+ *
+ * A finished game is reported as "over <id> <x|o|draw>". When too many computer moves are
+ * queued a move is refused with "busy <id>" and can be sent again, and a client that does
+ * not read its replies is not read from until it catches up. Errors are "error <id> <reason>".
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "aifactory.h"
+#include "gamerecord.h"
+#include "gamestate.h"
+#include "latencyhistogram.h"
+#include "metrics.h"
+#include "notation.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Time between two dumps of the metrics file.
+     */
+    const std::chrono::milliseconds METRICS_INTERVAL(1000);
+
+    const Metrics::Id SESSIONS = Metrics::getInstance().gauge("tictactoe_server_sessions", "Open games");
+    const Metrics::Id PENDING_MOVES = Metrics::getInstance().gauge("tictactoe_server_pending_moves", "Computer moves queued or being computed");
+    const Metrics::Id SERVER_MOVE_NSEC = Metrics::getInstance().histogram("tictactoe_server_move_nsec", "Time from queueing a computer move to its result");
+    const Metrics::Id BUSY_REPLIES = Metrics::getInstance().counter("tictactoe_server_busy_replies_total", "Moves refused because the queue was full");
+
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void onSignal(int){
+        stopRequested = 1;
+    }
+
+    /**
+     * @brief Settings of the server.
+     */
+    struct ServerConfig{
+        const char* socketPath = "/tmp/tictactoe.sock";
+        int workers = 0;
+        size_t maxSessions = 100000;
+        size_t maxPending = 4096;
+        size_t batchSize = 32;
+        int sloMsec = 50;
+        size_t maxOutput = size_t(1) << 20;
+        const char* recordPath = nullptr;
+        const char* metricsPath = nullptr;
+    };
+
+    /**
+     * @brief The hosted games in flat arrays indexed by slot, only touched by the socket thread.
+     *
+     * A session costs one GameState, its owner and two bytes of bookkeeping. Session ids carry
+     * the generation of their slot, so the id of a closed session never reaches a reused slot.
+     */
+    class SessionTable{
+    public:
+        static const int SLOT_BITS = 24;
+        static const uint32_t SLOT_MASK = (uint32_t(1) << SLOT_BITS) - 1;
+
+        static const uint8_t IN_USE = 1; /**< The slot holds a session. */
+        static const uint8_t PENDING = 2; /**< A computer move is being computed. */
+        static const uint8_t CLOSED = 4; /**< Closed while a computer move was pending. */
+        static const uint8_t OVER = 8; /**< The game has ended. */
+
+        /**
+         * @brief Stores a new session and returns its id, 0 if the table is full.
+         */
+        uint32_t open(int fd, const GameState& state){
+            uint32_t slot = 0;
+            if (!freeSlots.empty()){
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else if (states.size() < SLOT_MASK){
+                slot = static_cast<uint32_t>(states.size());
+                states.emplace_back();
+                owners.push_back(-1);
+                generations.push_back(0);
+                flags.push_back(0);
+            }
+            else{
+                return 0;
+            }
+            states[slot] = state;
+            owners[slot] = fd;
+            flags[slot] = IN_USE;
+            used++;
+            return (static_cast<uint32_t>(generations[slot]) << SLOT_BITS) | (slot + 1);
+        }
+
+        /**
+         * @brief Looks up the slot of a session id.
+         */
+        bool find(uint32_t id, uint32_t& slot) const{
+            const uint32_t index = id & SLOT_MASK;
+            if (0 == index || index > states.size()){
+                return false;
+            }
+            slot = index - 1;
+            return (flags[slot] & IN_USE) && generations[slot] == (id >> SLOT_BITS);
+        }
+
+        /**
+         * @brief Frees a slot for reuse.
+         */
+        void release(uint32_t slot){
+            flags[slot] = 0;
+            owners[slot] = -1;
+            generations[slot]++;
+            freeSlots.push_back(slot);
+            used--;
+        }
+
+        inline size_t size() const { return used; }
+        inline size_t capacity() const { return states.size(); }
+        inline GameState& state(uint32_t slot) { return states[slot]; }
+        inline int owner(uint32_t slot) const { return owners[slot]; }
+        inline uint8_t& flag(uint32_t slot) { return flags[slot]; }
+        inline uint8_t flag(uint32_t slot) const { return flags[slot]; }
+
+    private:
+        std::vector<GameState> states;
+        std::vector<int32_t> owners;
+        std::vector<uint8_t> generations;
+        std::vector<uint8_t> flags;
+        std::vector<uint32_t> freeSlots;
+        size_t used = 0;
+    };
+
+    /**
+     * @brief A computer move to compute, carrying a copy of the game.
+     */
+    struct MoveRequest{
+        uint32_t session = 0;
+        GameState state;
+        Clock::time_point enqueued;
+        Clock::time_point deadline;
+    };
+
+    /**
+     * @brief A computed computer move.
+     */
+    struct MoveResult{
+        uint32_t session = 0;
+        CellPos move{ -1, -1 };
+        Clock::time_point enqueued;
+    };
+
+    /**
+     * @brief Queues of pending computer moves, one per board geometry and AI type.
+     *
+     * Workers take a batch of requests from a single queue so one warm AI serves the whole
+     * batch. The queue whose oldest request has the earliest deadline is served first.
+     */
+    class Scheduler{
+    public:
+        using Key = std::pair<int, AIType>;
+
+        void submit(MoveRequest&& request){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queues[Key(request.state.getSize(), request.state.getAIType())].push_back(std::move(request));
+                pending++;
+            }
+            ready.notify_one();
+        }
+
+        /**
+         * @brief Waits for requests and takes up to maxBatch of the most urgent queue.
+         *
+         * @return false once the scheduler is stopped.
+         */
+        bool takeBatch(std::vector<MoveRequest>& batch, size_t maxBatch){
+            batch.clear();
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return stopping || hasWork(); });
+            if (stopping){
+                return false;
+            }
+            auto urgent = queues.end();
+            for (auto it = queues.begin(); it != queues.end(); ++it){
+                if (!it->second.empty() && (queues.end() == urgent || it->second.front().deadline < urgent->second.front().deadline)){
+                    urgent = it;
+                }
+            }
+            std::deque<MoveRequest>& queue = urgent->second;
+            while (!queue.empty() && batch.size() < maxBatch){
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Marks requests as done, they no longer count as pending.
+         */
+        void complete(size_t count){
+            std::lock_guard<std::mutex> lock(mutex);
+            pending -= count;
+        }
+
+        size_t getPending(){
+            std::lock_guard<std::mutex> lock(mutex);
+            return pending;
+        }
+
+        void stop(){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_all();
+        }
+
+    private:
+        bool hasWork() const{
+            for (const auto& entry : queues){
+                if (!entry.second.empty()){
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::map<Key, std::deque<MoveRequest>> queues;
+        size_t pending = 0; /**< Requests submitted and not completed, queued or running. */
+        bool stopping = false;
+    };
+
+    /**
+     * @brief Hands computed moves back to the socket thread and wakes it through an eventfd.
+     */
+    class CompletionQueue{
+    public:
+        CompletionQueue() : fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+        ~CompletionQueue() { if (fd >= 0) close(fd); }
+
+        void post(std::vector<MoveResult>& batch){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                results.insert(results.end(), batch.begin(), batch.end());
+            }
+            const uint64_t one = 1;
+            (void)!write(fd, &one, sizeof(one));
+        }
+
+        void drain(std::vector<MoveResult>& out){
+            uint64_t count = 0;
+            (void)!read(fd, &count, sizeof(count));
+            std::lock_guard<std::mutex> lock(mutex);
+            out.swap(results);
+            results.clear();
+        }
+
+        inline int getFd() const { return fd; }
+
+    private:
+        int fd;
+        std::mutex mutex;
+        std::vector<MoveResult> results;
+    };
+
+    /**
+     * @brief Computes batches of computer moves with AIs owned by the worker.
+     */
+    void runWorker(Scheduler& scheduler, CompletionQueue& completions, size_t batchSize){
+        std::map<Scheduler::Key, std::unique_ptr<GameAI>> ais;
+        Board board;
+        std::vector<MoveRequest> batch;
+        std::vector<MoveResult> results;
+        while (scheduler.takeBatch(batch, batchSize)){
+            if (batch.empty()){
+                continue;
+            }
+            const Scheduler::Key key(batch.front().state.getSize(), batch.front().state.getAIType());
+            std::unique_ptr<GameAI>& ai = ais[key];
+            if (!ai){
+                ai = AIFactory::acquireAI(key.second, key.first);
+            }
+            results.clear();
+            for (MoveRequest& request : batch){
+                MoveResult result;
+                result.session = request.session;
+                result.enqueued = request.enqueued;
+                if (ai){
+                    request.state.toBoard(board);
+                    ai->setLevel(request.state.getLevel());
+                    result.move = ai->makeMove(board, request.state.getComputer());
+                }
+                results.push_back(result);
+            }
+            scheduler.complete(batch.size());
+            completions.post(results);
+        }
+        for (auto& entry : ais){
+            AIFactory::releaseAI(std::move(entry.second), entry.first.first);
+        }
+    }
+
+    /**
+     * @brief A client connection with its unparsed input and unsent output.
+     */
+    struct Connection{
+        std::string input;
+        std::string output;
+        std::vector<uint32_t> slots; // Session slots opened by this client and not closed yet
+        bool reading = true;
+    };
+
+    bool parseNumber(std::string_view text, unsigned long& value){
+        if (text.empty() || text.size() > 10){
+            return false;
+        }
+        value = 0;
+        for (char c : text){
+            if (c < '0' || c > '9'){
+                return false;
+            }
+            value = value * 10 + static_cast<unsigned long>(c - '0');
+        }
+        return true;
+    }
+
+    const char* symbolName(Symbol symbol){
+        return Symbol::X == symbol ? "x" : "o";
+    }
+
+    /**
+     * @brief The socket thread: accepts clients, runs their commands and applies computed moves.
+     */
+    class Server{
+    public:
+        explicit Server(const ServerConfig& config_i) : config(config_i) {}
+
+        bool run(){
+            if (config.recordPath && !recorder.open(config.recordPath)){
+                return false;
+            }
+            if (!listen()){
+                return false;
+            }
+            if (config.metricsPath && !Metrics::getInstance().startDump(config.metricsPath, Metrics::formatOf(config.metricsPath), METRICS_INTERVAL)){
+                return false;
+            }
+            int workerCount = config.workers;
+            if (workerCount <= 0){
+                workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            }
+            std::vector<std::thread> workers;
+            for (int i = 0; i < workerCount; i++){
+                workers.emplace_back(runWorker, std::ref(scheduler), std::ref(completions), config.batchSize);
+            }
+            std::fprintf(stderr, "listening on %s with %d workers\n", config.socketPath, workerCount);
+
+            epoll_event events[64];
+            while (!stopRequested){
+                const int count = epoll_wait(epollFd, events, 64, 100);
+                Metrics::getInstance().set(SESSIONS, static_cast<int64_t>(sessions.size()));
+                Metrics::getInstance().set(PENDING_MOVES, static_cast<int64_t>(scheduler.getPending()));
+                for (int i = 0; i < count; i++){
+                    const int fd = events[i].data.fd;
+                    if (fd == listenFd){
+                        acceptClients();
+                    }
+                    else if (fd == completions.getFd()){
+                        applyResults();
+                    }
+                    else{
+                        if (events[i].events & (EPOLLERR | EPOLLHUP)){
+                            closeConnection(fd);
+                            continue;
+                        }
+                        if (events[i].events & EPOLLOUT){
+                            flush(fd);
+                        }
+                        if (events[i].events & EPOLLIN){
+                            readClient(fd);
+                        }
+                    }
+                }
+            }
+
+            scheduler.stop();
+            for (std::thread& worker : workers){
+                worker.join();
+            }
+            if (config.metricsPath){
+                Metrics::getInstance().stopDump();
+            }
+            for (auto& entry : connections){
+                close(entry.first);
+            }
+            close(listenFd);
+            close(epollFd);
+            unlink(config.socketPath);
+            return true;
+        }
+
+    private:
+        bool listen(){
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (std::strlen(config.socketPath) >= sizeof(address.sun_path)){
+                LOG_ERROR("Socket path too long");
+                return false;
+            }
+            std::strcpy(address.sun_path, config.socketPath);
+            unlink(config.socketPath);
+
+            listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+                || ::listen(listenFd, SOMAXCONN) < 0){
+                LOG_ERROR(std::string("Cannot listen on socket: ") + std::strerror(errno));
+                return false;
+            }
+            epollFd = epoll_create1(EPOLL_CLOEXEC);
+            watch(listenFd, EPOLLIN, EPOLL_CTL_ADD);
+            watch(completions.getFd(), EPOLLIN, EPOLL_CTL_ADD);
+            return true;
+        }
+
+        void watch(int fd, uint32_t events, int operation){
+            epoll_event event{};
+            event.events = events;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, operation, fd, &event);
+        }
+
+        void acceptClients(){
+            while (true){
+                const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0){
+                    return;
+                }
+                connections[fd] = Connection();
+                watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+            }
+        }
+
+        void closeConnection(int fd){
+            auto it = connections.find(fd);
+            if (connections.end() == it){
+                return;
+            }
+            for (uint32_t slot : it->second.slots){
+                closeSession(slot);
+            }
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            close(fd);
+            connections.erase(it);
+        }
+
+        void readClient(int fd){
+            char buffer[16384];
+            while (true){
+                auto it = connections.find(fd);
+                if (connections.end() == it || !it->second.reading){
+                    return;
+                }
+                const ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (0 == received || (received < 0 && EAGAIN != errno && EWOULDBLOCK != errno)){
+                    closeConnection(fd);
+                    return;
+                }
+                if (received < 0){
+                    return;
+                }
+                Connection& connection = it->second;
+                connection.input.append(buffer, static_cast<size_t>(received));
+                size_t start = 0;
+                size_t end = 0;
+                while (std::string::npos != (end = connection.input.find('\n', start))){
+                    handleLine(fd, connection, std::string_view(connection.input).substr(start, end - start));
+                    start = end + 1;
+                }
+                connection.input.erase(0, start);
+                flush(fd);
+            }
+        }
+
+        void handleLine(int fd, Connection& connection, std::string_view line){
+            const std::string_view command = nextWord(line);
+            if ("new" == command){
+                openSession(fd, connection, line);
+            }
+            else if ("play" == command){
+                playMove(fd, connection, line);
+            }
+            else if ("close" == command){
+                const std::string_view idText = nextWord(line);
+                uint32_t slot = 0;
+                if (!findSession(fd, idText, slot)){
+                    connection.output += "error - unknown session\n";
+                    return;
+                }
+                connection.output += "closed ";
+                connection.output += idText;
+                connection.output += '\n';
+                auto owned = std::find(connection.slots.begin(), connection.slots.end(), slot);
+                if (connection.slots.end() != owned){
+                    *owned = connection.slots.back();
+                    connection.slots.pop_back();
+                }
+                closeSession(slot);
+            }
+            else if ("stats" == command){
+                char text[256];
+                std::snprintf(text, sizeof(text),
+                    "stats sessions %zu pending %zu completed %llu slo_miss %llu busy %llu p50_us %.1f p99_us %.1f p999_us %.1f\n",
+                    sessions.size(), scheduler.getPending(), static_cast<unsigned long long>(latency.count()),
+                    static_cast<unsigned long long>(sloMisses), static_cast<unsigned long long>(busyReplies),
+                    latency.percentile(0.50) / 1000.0, latency.percentile(0.99) / 1000.0, latency.percentile(0.999) / 1000.0);
+                connection.output += text;
+            }
+            else if (!command.empty()){
+                connection.output += "error - unknown command\n";
+            }
+        }
+
+        void openSession(int fd, Connection& connection, std::string_view args){
+            unsigned long size = 0;
+            unsigned long level = 0;
+            AIType type = AIType::Minimax;
+            const bool validSize = parseNumber(nextWord(args), size) && size >= 2 && size <= GameState::MAX_SIZE;
+            const std::string_view human = nextWord(args);
+            if (!validSize || ("x" != human && "o" != human) || !parseAIType(nextWord(args), type) || !parseNumber(nextWord(args), level)){
+                connection.output += "error - usage: new <2-8> <x|o> <minimax|random> <level>\n";
+                return;
+            }
+            if (sessions.size() >= config.maxSessions){
+                connection.output += "error - too many sessions\n";
+                return;
+            }
+            // The computer opens as X, that needs room in the queue like any other move
+            if ("o" == human && scheduler.getPending() >= config.maxPending){
+                busyReplies++;
+                Metrics::getInstance().add(BUSY_REPLIES);
+                connection.output += "busy -\n";
+                return;
+            }
+
+            GameState state;
+            state.startNewGame(static_cast<int>(size), ("x" == human) ? Symbol::X : Symbol::O,
+                type, static_cast<GameLevel>(level));
+            const uint32_t id = sessions.open(fd, state);
+            uint32_t slot = 0;
+            if (0 == id || !sessions.find(id, slot)){
+                connection.output += "error - too many sessions\n";
+                return;
+            }
+            connection.slots.push_back(slot);
+            connection.output += "session " + std::to_string(id) + "\n";
+            if (config.recordPath){
+                if (histories.size() < sessions.capacity()){
+                    histories.resize(sessions.capacity());
+                }
+                histories[slot].clear();
+            }
+            if (Symbol::O == state.getHuman()){
+                submit(id, slot);
+            }
+        }
+
+        bool findSession(int fd, std::string_view idText, uint32_t& slot) const{
+            unsigned long id = 0;
+            return parseNumber(idText, id) && id <= UINT32_MAX && sessions.find(static_cast<uint32_t>(id), slot)
+                && sessions.owner(slot) == fd && !(sessions.flag(slot) & SessionTable::CLOSED);
+        }
+
+        /**
+         * @brief Ends a session, one with a move in flight is freed once the move comes back.
+         */
+        void closeSession(uint32_t slot){
+            if (sessions.flag(slot) & SessionTable::PENDING){
+                sessions.flag(slot) |= SessionTable::CLOSED;
+            }
+            else{
+                sessions.release(slot);
+            }
+        }
+
+        void playMove(int fd, Connection& connection, std::string_view args){
+            const std::string_view idText = nextWord(args);
+            uint32_t slot = 0;
+            if (!findSession(fd, idText, slot)){
+                connection.output += "error - unknown session\n";
+                return;
+            }
+            GameState& state = sessions.state(slot);
+            const std::string prefix(idText);
+            CellPos pos{ 0, 0 };
+            if (sessions.flag(slot) & SessionTable::OVER){
+                connection.output += "error " + prefix + " game over\n";
+                return;
+            }
+            if ((sessions.flag(slot) & SessionTable::PENDING) || state.getSideToMove() != state.getHuman()){
+                connection.output += "error " + prefix + " not your turn\n";
+                return;
+            }
+            if (!parseNotation(nextWord(args), pos) || !state.isEmpty(pos)){
+                connection.output += "error " + prefix + " illegal move\n";
+                return;
+            }
+            if (scheduler.getPending() >= config.maxPending){
+                busyReplies++;
+                Metrics::getInstance().add(BUSY_REPLIES);
+                connection.output += "busy " + prefix + "\n";
+                return;
+            }
+            const uint32_t id = static_cast<uint32_t>(std::strtoul(prefix.c_str(), nullptr, 10));
+            state.play(pos);
+            recordMove(slot, pos);
+            if (!checkOver(connection, id, slot)){
+                submit(id, slot);
+            }
+        }
+
+        void submit(uint32_t id, uint32_t slot){
+            MoveRequest request;
+            request.session = id;
+            request.state = sessions.state(slot);
+            request.enqueued = Clock::now();
+            request.deadline = request.enqueued + std::chrono::milliseconds(config.sloMsec);
+            sessions.flag(slot) |= SessionTable::PENDING;
+            scheduler.submit(std::move(request));
+        }
+
+        bool checkOver(Connection& connection, uint32_t id, uint32_t slot){
+            const GameState& state = sessions.state(slot);
+            const Symbol winner = state.checkForWinner();
+            if (Symbol::None == winner && !state.isBoardFull()){
+                return false;
+            }
+            sessions.flag(slot) |= SessionTable::OVER;
+            recordGame(slot, winner);
+            connection.output += "over " + std::to_string(id) + " " + (Symbol::None == winner ? "draw" : symbolName(winner)) + "\n";
+            return true;
+        }
+
+        /**
+         * @brief Keeps the moves of a game for its record, one cell index per byte.
+         */
+        void recordMove(uint32_t slot, const CellPos& pos){
+            if (config.recordPath){
+                histories[slot] += static_cast<char>(pos.y * sessions.state(slot).getSize() + pos.x);
+            }
+        }
+
+        void recordGame(uint32_t slot, Symbol winner){
+            if (!config.recordPath){
+                return;
+            }
+            const GameState& state = sessions.state(slot);
+            const int size = state.getSize();
+            record.size = size;
+            record.finished = true;
+            record.winner = winner;
+            for (int side = 0; side < PLAYER_COUNT; side++){
+                const bool human = (0 == side) == (Symbol::X == state.getHuman());
+                record.players[side].type = human ? Player_Type::HUMAN : Player_Type::COMPUTER;
+                record.players[side].aitype = state.getAIType();
+                record.players[side].level = human ? GameLevel::EASY : state.getLevel();
+            }
+            record.moves.clear();
+            for (char cell : histories[slot]){
+                record.moves.push_back(RecordedMove{ CellPos{ cell % size, cell / size }, 0, 0 });
+            }
+            recorder.write(record);
+        }
+
+        void applyResults(){
+            completions.drain(results);
+            const Clock::time_point now = Clock::now();
+            const auto slo = std::chrono::milliseconds(config.sloMsec);
+            std::vector<int> touched;
+            for (const MoveResult& result : results){
+                const Clock::duration elapsed = now - result.enqueued;
+                const uint64_t nsec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                latency.record(nsec);
+                Metrics::getInstance().record(SERVER_MOVE_NSEC, nsec);
+                if (elapsed > slo){
+                    sloMisses++;
+                }
+
+                uint32_t slot = 0;
+                if (!sessions.find(result.session, slot)){
+                    continue;
+                }
+                sessions.flag(slot) &= static_cast<uint8_t>(~SessionTable::PENDING);
+                if (sessions.flag(slot) & SessionTable::CLOSED){
+                    sessions.release(slot);
+                    continue;
+                }
+                const int fd = sessions.owner(slot);
+                auto connection = connections.find(fd);
+                if (connections.end() == connection){
+                    continue;
+                }
+                if (!sessions.state(slot).play(result.move)){
+                    connection->second.output += "error " + std::to_string(result.session) + " computer failed to move\n";
+                    sessions.flag(slot) |= SessionTable::OVER;
+                }
+                else{
+                    recordMove(slot, result.move);
+                    connection->second.output += "move " + std::to_string(result.session) + " " + toNotation(result.move) + "\n";
+                    checkOver(connection->second, result.session, slot);
+                }
+                touched.push_back(fd);
+            }
+            std::sort(touched.begin(), touched.end());
+            touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+            for (int fd : touched){
+                flush(fd);
+            }
+        }
+
+        /**
+         * @brief Writes as much pending output as the socket takes and applies backpressure.
+         */
+        void flush(int fd){
+            auto it = connections.find(fd);
+            if (connections.end() == it){
+                return;
+            }
+            Connection& connection = it->second;
+            size_t written = 0;
+            while (written < connection.output.size()){
+                const ssize_t sent = send(fd, connection.output.data() + written, connection.output.size() - written, MSG_NOSIGNAL);
+                if (sent <= 0){
+                    if (sent < 0 && (EAGAIN == errno || EWOULDBLOCK == errno)){
+                        break;
+                    }
+                    closeConnection(fd);
+                    return;
+                }
+                written += static_cast<size_t>(sent);
+            }
+            connection.output.erase(0, written);
+
+            // Stop reading from a client that does not read its replies
+            const bool reading = connection.output.size() < config.maxOutput;
+            uint32_t events = reading ? static_cast<uint32_t>(EPOLLIN) : 0u;
+            if (!connection.output.empty()){
+                events |= EPOLLOUT;
+            }
+            connection.reading = reading;
+            watch(fd, events, EPOLL_CTL_MOD);
+        }
+
+    private:
+        ServerConfig config;
+        int listenFd = -1;
+        int epollFd = -1;
+        Scheduler scheduler;
+        CompletionQueue completions;
+        std::unordered_map<int, Connection> connections;
+        SessionTable sessions;
+        std::vector<std::string> histories; /**< Moves per session slot, only kept when recording. */
+        GameRecordWriter recorder;
+        GameRecord record;
+        std::vector<MoveResult> results;
+        LatencyHistogram latency;
+        uint64_t sloMisses = 0;
+        uint64_t busyReplies = 0;
+    };
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --socket PATH       Unix socket to listen on (default /tmp/tictactoe.sock)\n"
+            "  --workers N         worker threads computing moves (default: all cores)\n"
+            "  --max-sessions N    maximum number of open games (default 100000)\n"
+            "  --max-pending N     queued computer moves before clients get busy replies (default 4096)\n"
+            "  --batch N           computer moves one worker takes at once (default 32)\n"
+            "  --slo-ms N          move latency objective in milliseconds (default 50)\n"
+            "  --record FILE       append every finished game to a binary game record file\n"
+            "  --metrics FILE      dump the engine metrics every second, as JSON for a .json file, text otherwise\n",
+            program);
+    }
+
+    bool parseArguments(int argc, char* argv[], ServerConfig& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--socket")){
+                config.socketPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--workers")){
+                config.workers = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--max-sessions")){
+                config.maxSessions = static_cast<size_t>(std::atoll(value));
+            }
+            else if (0 == std::strcmp(arg, "--max-pending")){
+                config.maxPending = static_cast<size_t>(std::atoll(value));
+            }
+            else if (0 == std::strcmp(arg, "--batch")){
+                config.batchSize = static_cast<size_t>(std::atoll(value));
+            }
+            else if (0 == std::strcmp(arg, "--slo-ms")){
+                config.sloMsec = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--record")){
+                config.recordPath = value;
+            }
+            else if (0 == std::strcmp(arg, "--metrics")){
+                config.metricsPath = value;
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.workers >= 0 && config.batchSize > 0 && config.maxPending > 0 && config.sloMsec > 0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the game server.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    ServerConfig config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    Server server(config);
+    return server.run() ? 0 : 1;
+}
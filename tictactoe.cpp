@@ -8,13 +8,22 @@
  * @date 2024-02-16
  */
 
+#include <chrono>
 #include "tictactoe.h"
+#include "alloctracker.h"
 #include "computerplayer.h"
 #include "humanplayer.h"
 #include "aifactory.h"
+#include "metrics.h"
+#include "trace.h"
 
 namespace tictactoe{
 
+    namespace {
+        const Metrics::Id HUMAN_MOVE_NSEC = Metrics::getInstance().histogram("tictactoe_human_move_nsec", "Time of TicTacToe::makeMove for human moves");
+        const Metrics::Id COMPUTER_MOVE_NSEC = Metrics::getInstance().histogram("tictactoe_computer_move_nsec", "Time of TicTacToe::makeMove for computer moves");
+    }
+
     /**
      * @brief Constructs a new TicTacToe object.
      *
@@ -22,6 +31,7 @@ namespace tictactoe{
      */
     TicTacToe::TicTacToe() : currentPlayer(nullptr),
         aitype_computer(AIType::Minimax),
+        level_computer(GameLevel::EASY),
         board(std::make_unique<Board>(DEFAULT_BOARD_SIZE)){
         createPlayers(Symbol::O);
     }
@@ -39,18 +49,32 @@ namespace tictactoe{
      * @param board_size The size of the game board.
      */
     void TicTacToe::startNewGame(Symbol human_player, AIType ai_type, int board_size){
+        ALLOC_SCOPE("TicTacToe::startNewGame");
 
         if (!board){
-            Logger::getInstance().logError("Invalid Board", LOG_LOCATION);
+            LOG_ERROR("Invalid Board");
             return;
         }
 
 
+        const bool sizeChanged = board->getSize() != board_size;
+
         // Start a new game
         board->startNewGame(board_size);
+        moveHistory.clear();
+        moveHistory.reserve(static_cast<size_t>(board_size) * board_size);
 
-        // Set the AI type for the computer player
-        setAITypeComputer(ai_type);
+        // Set the AI type for the computer player, taking a warm AI from the pool
+        // whenever the AI type or the board size changes
+        if (sizeChanged){
+            aitype_computer = ai_type;
+            if (Players[static_cast<int>(Player_Type::COMPUTER)]){
+                Players[static_cast<int>(Player_Type::COMPUTER)]->changeAI(aitype_computer, board_size);
+            }
+        }
+        else{
+            setAITypeComputer(ai_type);
+        }
 
         //set symbol
         Players[static_cast<int>(Player_Type::HUMAN)]->setSymbol(human_player);
@@ -60,7 +84,7 @@ namespace tictactoe{
         currentPlayer = Players[static_cast<int>(Player_Type::HUMAN)].get();
 
         if (!currentPlayer){
-            Logger::getInstance().logError("Invalid Current Player", LOG_LOCATION);
+            LOG_ERROR("Invalid Current Player");
         }
     }
 
@@ -71,13 +95,102 @@ namespace tictactoe{
      * @param type The type of player making the move (human or computer).
      * @return True if the move was successful, false otherwise.
      */
-    bool TicTacToe::makeMove(const QPoint pos, Player_Type type){
+    bool TicTacToe::makeMove(const CellPos pos, Player_Type type){
+        TRACE_SCOPE("TicTacToe::makeMove");
         if (!currentPlayer){
-            Logger::getInstance().logError("Invalid Current Player", LOG_LOCATION);
+            LOG_ERROR("Invalid Current Player");
             return false;
         }
+        const auto start = std::chrono::steady_clock::now();
         currentPlayer = Players[static_cast<int>(type)].get();
-        return currentPlayer->makeMove(pos, *board);
+        const bool played = currentPlayer->makeMove(pos, *board);
+        if (played){
+            moveHistory.push_back(currentPlayer->getCurPos());
+        }
+        Metrics::getInstance().record((Player_Type::HUMAN == type) ? HUMAN_MOVE_NSEC : COMPUTER_MOVE_NSEC,
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        return played;
+    }
+
+    /**
+     * @brief Creates a resumable search for the computer player's next move.
+     *
+     * The search works on a copy of the board and finds the move makeMove would make for the
+     * computer. It must not outlive the game or a change of the computer's AI.
+     *
+     * @return The search task, or nullptr on error.
+     */
+    std::unique_ptr<SearchTask> TicTacToe::createComputerSearch() const{
+        if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
+            LOG_ERROR("Invalid Computer Player");
+            return nullptr;
+        }
+        return Players[static_cast<int>(Player_Type::COMPUTER)]->createSearch(*board);
+    }
+
+    /**
+     * @brief Makes a computer move found by a search created with createComputerSearch.
+     *
+     * @param pos The position to place the computer's symbol.
+     * @return True if the move was successful, false otherwise.
+     */
+    bool TicTacToe::applyComputerMove(const CellPos& pos){
+        if (!currentPlayer){
+            LOG_ERROR("Invalid Current Player");
+            return false;
+        }
+        currentPlayer = Players[static_cast<int>(Player_Type::COMPUTER)].get();
+        if (!currentPlayer->playMove(pos, *board)){
+            return false;
+        }
+        moveHistory.push_back(pos);
+        return true;
+    }
+
+    /**
+     * @brief Scores every legal move of the computer player.
+     *
+     * @return The scores of the legal moves, empty on error.
+     */
+    std::vector<MoveScore> TicTacToe::analyzeComputerMoves() const{
+        if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
+            LOG_ERROR("Invalid Computer Player");
+            return std::vector<MoveScore>();
+        }
+        return Players[static_cast<int>(Player_Type::COMPUTER)]->analyze(*board);
+    }
+
+    /**
+     * @brief Gets the current game as a game record.
+     *
+     * The human always moves first, so the record's first mover is the human's symbol. The
+     * computer is recorded with its AI type and level at the time of the call.
+     *
+     * @return The record, unfinished while the game is still going on.
+     */
+    GameRecord TicTacToe::getRecord() const{
+        GameRecord record;
+        if (!board || !Players[static_cast<int>(Player_Type::HUMAN)]){
+            LOG_ERROR("Invalid Board");
+            return record;
+        }
+        const Symbol human = Players[static_cast<int>(Player_Type::HUMAN)]->getSymbol();
+        record.size = board->getSize();
+        record.firstMover = human;
+        for (int side = 0; side < PLAYER_COUNT; side++){
+            const Symbol symbol = (0 == side) ? Symbol::X : Symbol::O;
+            RecordedPlayer& player = record.players[side];
+            player.type = (human == symbol) ? Player_Type::HUMAN : Player_Type::COMPUTER;
+            player.aitype = aitype_computer;
+            player.level = (human == symbol) ? GameLevel::EASY : level_computer;
+        }
+        record.winner = board->checkForWinner();
+        record.finished = Symbol::None != record.winner || board->isBoardFull();
+        record.moves.reserve(moveHistory.size());
+        for (const CellPos& pos : moveHistory){
+            record.moves.push_back(RecordedMove{ pos, 0, 0 });
+        }
+        return record;
     }
 
     /**
@@ -88,7 +201,7 @@ namespace tictactoe{
     Player_Type TicTacToe::checkForWinner() const{
 
         if (!board){
-            Logger::getInstance().logError("Invalid Board", LOG_LOCATION);
+            LOG_ERROR("Invalid Board");
             return Player_Type::UNKNOWN;
         }
 
@@ -112,10 +225,10 @@ namespace tictactoe{
      *
      * @return The symbol of the current player.
      */
-    QString TicTacToe::getCurrentPlayerSymbol() const{
+    std::string_view TicTacToe::getCurrentPlayerSymbol() const{
         if (!currentPlayer){
-            Logger::getInstance().logError("Invalid Current Player", LOG_LOCATION);
-            return QString("");
+            LOG_ERROR("Invalid Current Player");
+            return std::string_view();
         }
         return currentPlayer->getSymbolString();
     }
@@ -125,15 +238,31 @@ namespace tictactoe{
      *
      * @return The coordinates of the last move made by the computer player.
      */
-    QPoint TicTacToe::getCurrentPosComputer() const{
+    CellPos TicTacToe::getCurrentPosComputer() const{
         if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
             // Handle error: Computer player not initialized
-            Logger::getInstance().logError("Invalid Computer Player", LOG_LOCATION);
-            return QPoint();
+            LOG_ERROR("Invalid Computer Player");
+            return CellPos{ 0, 0 };
         }
         return Players[static_cast<int>(Player_Type::COMPUTER)]->getCurPos();
     }
 
+    /**
+     * @brief Gets the statistics of the search for the computer player's last move.
+     *
+     * Moves found by a search task and played with applyComputerMove are not included, their
+     * statistics are kept by the task.
+     *
+     * @return The statistics, empty if the computer has not moved yet.
+     */
+    SearchStats TicTacToe::getComputerStats() const{
+        if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
+            LOG_ERROR("Invalid Computer Player");
+            return SearchStats();
+        }
+        return Players[static_cast<int>(Player_Type::COMPUTER)]->getLastStats();
+    }
+
     /**
      * @brief Checks if the game board is full.
      *
@@ -141,7 +270,7 @@ namespace tictactoe{
      */
     bool TicTacToe::isBoardFull() const{
         if (!board){
-            Logger::getInstance().logError("Invalid Board", LOG_LOCATION);
+            LOG_ERROR("Invalid Board");
             return false;
         }
         return board->isBoardFull();
@@ -156,13 +285,13 @@ namespace tictactoe{
         for (int player = 0; player < PLAYER_COUNT; player++){
             switch (player){
             case static_cast<int>(Player_Type::COMPUTER):{
-                std::unique_ptr<GameAI> ai = AIFactory::createAI(aitype_computer);
+                std::unique_ptr<GameAI> ai = AIFactory::acquireAI(aitype_computer, board->getSize());
 
                 if (ai){
-                    Players[player] = std::make_unique<ComputerPlayer>(board->getOpponent(human_player), std::move(ai));
+                    Players[player] = std::make_unique<ComputerPlayer>(board->getOpponent(human_player), std::move(ai), board->getSize());
                 }
                 else{
-                    Logger::getInstance().logError("AI Creation failed", LOG_LOCATION);
+                    LOG_ERROR("AI Creation failed");
                 }
                 break;
             }
@@ -182,12 +311,39 @@ namespace tictactoe{
      */
     void TicTacToe::setGameLevel(GameLevel level){
         if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
-            Logger::getInstance().logError("Invalid Player", LOG_LOCATION);
+            LOG_ERROR("Invalid Player");
             return;
         }
+        level_computer = level;
         Players[static_cast<int>(Player_Type::COMPUTER)]->setLevel(level);
     }
 
+    /**
+     * @brief Sets the evaluation weights of the computer player.
+     *
+     * @param evalWeights The weights, kept when the AI type changes, or nullptr to score cut off positions as draws.
+     */
+    void TicTacToe::setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights){
+        if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
+            LOG_ERROR("Invalid Player");
+            return;
+        }
+        Players[static_cast<int>(Player_Type::COMPUTER)]->setEvalWeights(std::move(evalWeights));
+    }
+
+    /**
+     * @brief Sets the neural network of the computer player.
+     *
+     * @param neuralEval The network, kept when the AI type changes, or nullptr to not use one.
+     */
+    void TicTacToe::setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval){
+        if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
+            LOG_ERROR("Invalid Player");
+            return;
+        }
+        Players[static_cast<int>(Player_Type::COMPUTER)]->setNeuralEval(std::move(neuralEval));
+    }
+
     /**
      * @brief Sets the AI type for the computer player.
      *
@@ -195,12 +351,12 @@ namespace tictactoe{
      */
     void TicTacToe::setAITypeComputer(AIType aitype_i){
         if (!Players[static_cast<int>(Player_Type::COMPUTER)]){
-            Logger::getInstance().logError("Invalid Player", LOG_LOCATION);
+            LOG_ERROR("Invalid Player");
             return;
         }
         if (aitype_computer != aitype_i){
             aitype_computer = aitype_i;
-            Players[static_cast<int>(Player_Type::COMPUTER)]->changeAI(aitype_computer);
+            Players[static_cast<int>(Player_Type::COMPUTER)]->changeAI(aitype_computer, board->getSize());
         }
     }
 
@@ -13,9 +13,11 @@
 #ifndef TICTACTOE_H
 #define TICTACTOE_H
 
-#include <QString>
 #include <memory>
+#include <string_view>
+#include <vector>
 #include "board.h"
+#include "gamerecord.h"
 #include "player.h"
 
 namespace tictactoe{
@@ -42,7 +44,22 @@ namespace tictactoe{
         /**
          * @brief Makes a move in the game.
          */
-        bool makeMove(const QPoint pos, Player_Type type);
+        bool makeMove(const CellPos pos, Player_Type type);
+
+        /**
+         * @brief Creates a resumable search for the computer player's next move.
+         */
+        std::unique_ptr<SearchTask> createComputerSearch() const;
+
+        /**
+         * @brief Makes a computer move found by a search created with createComputerSearch.
+         */
+        bool applyComputerMove(const CellPos& pos);
+
+        /**
+         * @brief Scores every legal move of the computer player.
+         */
+        std::vector<MoveScore> analyzeComputerMoves() const;
 
         /**
          * @brief Checks if there is a winner in the game.
@@ -52,23 +69,53 @@ namespace tictactoe{
         /**
          * @brief Gets the symbol of the current player.
          */
-        QString getCurrentPlayerSymbol() const;
+        std::string_view getCurrentPlayerSymbol() const;
 
         /**
          * @brief Gets the current position of the computer player.
          */
-        QPoint getCurrentPosComputer() const;
+        CellPos getCurrentPosComputer() const;
+
+        /**
+         * @brief Gets the statistics of the search for the computer player's last move.
+         */
+        SearchStats getComputerStats() const;
 
         /**
          * @brief Checks if the game board is full.
          */
         bool isBoardFull() const;
 
+        /**
+         * @brief Gets the game board.
+         */
+        inline const Board& getBoard() const { return *board; }
+
+        /**
+         * @brief Gets the moves of the current game in the order they were played.
+         */
+        inline const std::vector<CellPos>& getMoveHistory() const { return moveHistory; }
+
+        /**
+         * @brief Gets the current game as a game record.
+         */
+        GameRecord getRecord() const;
+
         /**
          * @brief Sets the game level.
          */
         void setGameLevel(GameLevel level);
 
+        /**
+         * @brief Sets the evaluation weights of the computer player.
+         */
+        void setEvalWeights(std::shared_ptr<const EvalWeights> evalWeights);
+
+        /**
+         * @brief Sets the neural network of the computer player.
+         */
+        void setNeuralEval(std::shared_ptr<const NeuralEval> neuralEval);
+
         /**
          * @brief Sets the AI type for the computer player.
          */
@@ -85,6 +132,8 @@ namespace tictactoe{
         Player* currentPlayer; ///< Pointer to the current player.
         std::unique_ptr<Player> Players[PLAYER_COUNT]; ///< Array of players.
         AIType aitype_computer; ///< The AI type for the computer player.
+        GameLevel level_computer; ///< The level of the computer player.
+        std::vector<CellPos> moveHistory; ///< Moves of the current game, the human's first.
     };
 }
 
@@ -0,0 +1,521 @@
+/**
+ * @file tournament.cpp
+ * @brief Implementation file for the engine tournament runner.
+ *
+ * This file contains a command line tool that plays two AI configurations against each other
+ * from a set of opening positions, each opening once with either side, and reports the Elo
+ * difference with its error bar. A sequential probability ratio test stops the match early
+ * once the result is statistically clear.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "aifactory.h"
+#include "computerplayer.h"
+#include "evalweights.h"
+#include "neuraleval.h"
+#include "notation.h"
+#include "positiondb.h"
+#include "rng.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Settings of one engine of the match.
+     */
+    struct EngineConfig{
+        AIType type = AIType::Minimax;
+        GameLevel level = GameLevel::EASY;
+        const char* positionDBFile = nullptr;
+        std::shared_ptr<const PositionDB> positionDB; // Loaded from positionDBFile, shared by the workers
+        const char* evalWeightsFile = nullptr;
+        std::shared_ptr<const EvalWeights> evalWeights; // Loaded from evalWeightsFile, shared by the workers
+        const char* neuralEvalFile = nullptr;
+        std::shared_ptr<const NeuralEval> neuralEval; // Loaded from neuralEvalFile, shared by the workers
+    };
+
+    /**
+     * @brief Settings of a tournament run.
+     */
+    struct Config{
+        int size = DEFAULT_BOARD_SIZE;
+        long long maxGames = 20000;
+        long long minGames = 100;
+        int threads = 0;
+        int openingPlies = 2;
+        const char* openingsFile = nullptr;
+        EngineConfig engines[2]; // A (candidate), then B (baseline)
+        double elo0 = -10.0;
+        double elo1 = 0.0;
+        double alpha = 0.05;
+        double beta = 0.05;
+        uint64_t seed = 0; // Seed of the random choices, random unless given
+        bool hasSeed = false;
+    };
+
+    /**
+     * @brief Game counts from the point of view of engine A.
+     */
+    struct Score{
+        long long wins = 0;
+        long long draws = 0;
+        long long losses = 0;
+
+        long long games() const { return wins + draws + losses; }
+    };
+
+    /**
+     * @brief State shared by the worker threads.
+     *
+     * The results and the SPRT are updated under the mutex once per finished game pair, the
+     * workers check the stop flag before taking the next pair.
+     */
+    struct Match{
+        std::atomic<long long> nextPair{ 0 };
+        std::atomic<bool> stop{ false };
+        std::mutex mutex;
+        Score score; // Results of the counted pairs
+        double llr = 0.0; // LLR of the counted pairs
+    };
+
+    /**
+     * @brief Collects every distinct undecided position reached after the given number of plies.
+     *
+     * Positions are deduplicated by board key, so transpositions are only played once.
+     */
+    void enumerateOpenings(Board& board, int plies, Symbol symbol, std::vector<CellPos>& line,
+                           std::set<uint64_t>& seen, std::vector<std::vector<CellPos>>& openings){
+        if (0 == plies){
+            if (seen.insert(board.getKey()).second){
+                openings.push_back(line);
+            }
+            return;
+        }
+        const int size = board.getSize();
+        for (int row = 0; row < size; row++){
+            for (int col = 0; col < size; col++){
+                const CellPos pos{ col, row };
+                if (!board.isEmpty(pos)){
+                    continue;
+                }
+                board.makeMove(pos, symbol);
+                if (Symbol::None == board.checkForWinner() && !board.isBoardFull()){
+                    line.push_back(pos);
+                    enumerateOpenings(board, plies - 1, board.getOpponent(symbol), line, seen, openings);
+                    line.pop_back();
+                }
+                board.undoMove(pos);
+            }
+        }
+    }
+
+    /**
+     * @brief Reads openings from a file, one line of moves in notation per opening.
+     */
+    bool loadOpenings(const char* path, int size, std::vector<std::vector<CellPos>>& openings){
+        std::ifstream file(path);
+        if (!file){
+            LOG_ERROR(std::string("Cannot open ") + path);
+            return false;
+        }
+        std::string text;
+        int lineNumber = 0;
+        while (std::getline(file, text)){
+            lineNumber++;
+            if (text.empty() || '#' == text[0]){
+                continue;
+            }
+            std::vector<CellPos> moves;
+            bool valid = parseMoveList(text, moves);
+            Board board(size);
+            Symbol symbol = Symbol::X;
+            for (size_t i = 0; valid && i < moves.size(); i++){
+                valid = moves[i].x < size && moves[i].y < size
+                    && board.isEmpty(moves[i])
+                    && Symbol::None == board.checkForWinner();
+                if (valid){
+                    board.makeMove(moves[i], symbol);
+                    symbol = board.getOpponent(symbol);
+                }
+            }
+            if (!valid || Symbol::None != board.checkForWinner() || board.isBoardFull()){
+                LOG_ERROR(std::string("Invalid opening on line ") + std::to_string(lineNumber));
+                return false;
+            }
+            openings.push_back(std::move(moves));
+        }
+        return !openings.empty();
+    }
+
+    /**
+     * @brief Expected score of the stronger side for the given Elo difference.
+     */
+    double eloToScore(double elo){
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    /**
+     * @brief Elo difference for the given expected score.
+     */
+    double scoreToElo(double score){
+        score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+
+    /**
+     * @brief Mean and per-game variance of the score of engine A.
+     */
+    void scoreMoments(const Score& score, double& mean, double& variance){
+        const double games = static_cast<double>(score.games());
+        const double w = score.wins / games;
+        const double d = score.draws / games;
+        const double l = score.losses / games;
+        mean = w + 0.5 * d;
+        variance = w * (1.0 - mean) * (1.0 - mean) + d * (0.5 - mean) * (0.5 - mean) + l * mean * mean;
+    }
+
+    /**
+     * @brief Log-likelihood ratio of H1 (elo1) against H0 (elo0).
+     *
+     * Uses the normal approximation of the trinomial game results. The variance is floored so
+     * a run of identical results, common between deterministic engines, still converges.
+     */
+    double logLikelihoodRatio(const Score& score, double elo0, double elo1){
+        if (0 == score.games()){
+            return 0.0;
+        }
+        double mean = 0.0;
+        double variance = 0.0;
+        scoreMoments(score, mean, variance);
+        variance = std::max(variance, 1e-3);
+        const double s0 = eloToScore(elo0);
+        const double s1 = eloToScore(elo1);
+        return static_cast<double>(score.games()) * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance);
+    }
+
+    /**
+     * @brief Adds the results of a finished game pair and stops the match once the SPRT decides.
+     *
+     * Pairs finishing after the decision are not counted, so the reported result is the one
+     * the test stopped on.
+     */
+    void addPair(const Config& config, double lowerBound, double upperBound, const Score& pair, Match& match){
+        std::lock_guard<std::mutex> lock(match.mutex);
+        if (match.stop.load(std::memory_order_relaxed)){
+            return;
+        }
+        match.score.wins += pair.wins;
+        match.score.draws += pair.draws;
+        match.score.losses += pair.losses;
+        match.llr = logLikelihoodRatio(match.score, config.elo0, config.elo1);
+        if (match.score.games() >= config.minGames && (match.llr <= lowerBound || match.llr >= upperBound)){
+            match.stop.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Plays game pairs from the shared pair counter until the match is over.
+     *
+     * Game 2k and 2k+1 use the same opening, engine A plays X in the first and O in the second.
+     * Both games of a pair are played by the same worker and counted together.
+     */
+    void playGames(const Config& config, const std::vector<std::vector<CellPos>>& openings,
+                   double lowerBound, double upperBound, Match& match){
+        Board board(config.size);
+        ComputerPlayer engines[2] = {
+            ComputerPlayer(Symbol::X, AIFactory::acquireAI(config.engines[0].type, config.size), config.size),
+            ComputerPlayer(Symbol::O, AIFactory::acquireAI(config.engines[1].type, config.size), config.size)
+        };
+        for (int e = 0; e < 2; e++){
+            engines[e].setLevel(config.engines[e].level);
+            engines[e].setPositionDB(config.engines[e].positionDB);
+            engines[e].setEvalWeights(config.engines[e].evalWeights);
+            engines[e].setNeuralEval(config.engines[e].neuralEval);
+        }
+
+        const long long pairs = static_cast<long long>(openings.size());
+        while (!match.stop.load(std::memory_order_relaxed)){
+            const long long pairIndex = match.nextPair.fetch_add(1, std::memory_order_relaxed);
+            if (pairIndex * 2 >= config.maxGames){
+                break;
+            }
+            Score pair;
+            const std::vector<CellPos>& opening = openings[static_cast<size_t>(pairIndex % pairs)];
+            for (long long game = pairIndex * 2; game < std::min(pairIndex * 2 + 2, config.maxGames); game++){
+                const int engineX = static_cast<int>(game % 2);
+                engines[engineX].setSymbol(Symbol::X);
+                engines[1 - engineX].setSymbol(Symbol::O);
+                // Seeds follow the game number, not the thread that happens to play the game
+                for (int e = 0; e < 2; e++){
+                    engines[e].setSeed(Rng::derive(config.seed, static_cast<uint64_t>(game * 2 + e)));
+                }
+
+                board.startNewGame(config.size);
+                Symbol toMove = Symbol::X;
+                for (const CellPos& pos : opening){
+                    board.makeMove(pos, toMove);
+                    toMove = board.getOpponent(toMove);
+                }
+
+                Symbol winner = Symbol::None;
+                int side = (Symbol::X == toMove) ? engineX : 1 - engineX;
+                while (true){
+                    if (!engines[side].makeMove(CellPos{ -1, -1 }, board)){
+                        LOG_ERROR("AI made an invalid move");
+                        winner = engines[1 - side].getSymbol();
+                        break;
+                    }
+                    winner = board.checkForWinner();
+                    if (Symbol::None != winner || board.isBoardFull()){
+                        break;
+                    }
+                    side = 1 - side;
+                }
+
+                if (Symbol::None == winner){
+                    pair.draws++;
+                }
+                else if (engines[0].getSymbol() == winner){
+                    pair.wins++;
+                }
+                else{
+                    pair.losses++;
+                }
+            }
+            addPair(config, lowerBound, upperBound, pair, match);
+        }
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --size N            board size (default %d)\n"
+            "  --games N           maximum number of games (default 20000)\n"
+            "  --min-games N       games played before the SPRT may stop the match (default 100)\n"
+            "  --threads N         worker threads (default: all cores)\n"
+            "  --a-ai TYPE         AI of engine A: minimax or random (default minimax)\n"
+            "  --a-level N         search depth level of engine A (default 0)\n"
+            "  --b-ai TYPE         AI of engine B: minimax or random (default minimax)\n"
+            "  --b-level N         search depth level of engine B (default 0)\n"
+            "  --a-posdb FILE      position database engine A orders its moves with\n"
+            "  --b-posdb FILE      position database engine B orders its moves with\n"
+            "  --a-eval FILE       evaluation weights engine A scores the depth limit with\n"
+            "  --b-eval FILE       evaluation weights engine B scores the depth limit with\n"
+            "  --a-net FILE        neural network engine A scores and orders moves with\n"
+            "  --b-net FILE        neural network engine B scores and orders moves with\n"
+            "  --opening-plies N   play all distinct N-ply openings (default 2)\n"
+            "  --openings FILE     read openings from FILE, one line of moves per opening\n"
+            "  --elo0 X            SPRT null hypothesis, Elo of A over B (default -10)\n"
+            "  --elo1 X            SPRT alternative hypothesis (default 0)\n"
+            "  --alpha X           SPRT false positive rate (default 0.05)\n"
+            "  --beta X            SPRT false negative rate (default 0.05)\n"
+            "  --seed N            seed of the random choices, to replay a match (default: random)\n",
+            program, DEFAULT_BOARD_SIZE);
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--size")){
+                config.size = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--games")){
+                config.maxGames = std::atoll(value);
+            }
+            else if (0 == std::strcmp(arg, "--min-games")){
+                config.minGames = std::atoll(value);
+            }
+            else if (0 == std::strcmp(arg, "--threads")){
+                config.threads = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--a-ai")){
+                if (!parseAIType(value, config.engines[0].type)) return false;
+            }
+            else if (0 == std::strcmp(arg, "--b-ai")){
+                if (!parseAIType(value, config.engines[1].type)) return false;
+            }
+            else if (0 == std::strcmp(arg, "--a-level")){
+                config.engines[0].level = static_cast<GameLevel>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(arg, "--b-level")){
+                config.engines[1].level = static_cast<GameLevel>(std::atoi(value));
+            }
+            else if (0 == std::strcmp(arg, "--a-posdb")){
+                config.engines[0].positionDBFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--b-posdb")){
+                config.engines[1].positionDBFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--a-eval")){
+                config.engines[0].evalWeightsFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--b-eval")){
+                config.engines[1].evalWeightsFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--a-net")){
+                config.engines[0].neuralEvalFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--b-net")){
+                config.engines[1].neuralEvalFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--opening-plies")){
+                config.openingPlies = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--openings")){
+                config.openingsFile = value;
+            }
+            else if (0 == std::strcmp(arg, "--elo0")){
+                config.elo0 = std::atof(value);
+            }
+            else if (0 == std::strcmp(arg, "--elo1")){
+                config.elo1 = std::atof(value);
+            }
+            else if (0 == std::strcmp(arg, "--alpha")){
+                config.alpha = std::atof(value);
+            }
+            else if (0 == std::strcmp(arg, "--beta")){
+                config.beta = std::atof(value);
+            }
+            else if (0 == std::strcmp(arg, "--seed")){
+                config.seed = std::strtoull(value, nullptr, 10);
+                config.hasSeed = true;
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.size >= 2 && config.size <= MAX_NOTATION_SIZE && config.maxGames > 0 && config.minGames >= 0
+            && config.threads >= 0 && config.openingPlies >= 0 && config.elo0 < config.elo1
+            && config.alpha > 0.0 && config.alpha < 1.0 && config.beta > 0.0 && config.beta < 1.0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the tournament runner.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int 0 unless the arguments are invalid.
+ */
+int main(int argc, char* argv[])
+{
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    for (EngineConfig& engine : config.engines){
+        if (engine.positionDBFile){
+            auto positionDB = std::make_shared<PositionDB>();
+            if (!positionDB->open(engine.positionDBFile)){
+                return 1;
+            }
+            engine.positionDB = std::move(positionDB);
+        }
+        if (engine.evalWeightsFile){
+            auto evalWeights = std::make_shared<EvalWeights>();
+            if (!evalWeights->load(engine.evalWeightsFile)){
+                return 1;
+            }
+            engine.evalWeights = std::move(evalWeights);
+        }
+        if (engine.neuralEvalFile){
+            auto neuralEval = std::make_shared<NeuralEval>();
+            if (!neuralEval->load(engine.neuralEvalFile)){
+                return 1;
+            }
+            engine.neuralEval = std::move(neuralEval);
+        }
+    }
+
+    std::vector<std::vector<CellPos>> openings;
+    if (config.openingsFile){
+        if (!loadOpenings(config.openingsFile, config.size, openings)){
+            return 1;
+        }
+    }
+    else{
+        Board board(config.size);
+        std::vector<CellPos> line;
+        std::set<uint64_t> seen;
+        enumerateOpenings(board, config.openingPlies, Symbol::X, line, seen, openings);
+        if (openings.empty()){
+            LOG_ERROR("No undecided opening with that many plies");
+            return 1;
+        }
+    }
+
+    int threads = config.threads;
+    if (0 == threads){
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threads = static_cast<int>(std::min<long long>(threads, config.maxGames));
+
+    if (!config.hasSeed){
+        config.seed = (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+    }
+
+    const double lowerBound = std::log(config.beta / (1.0 - config.alpha));
+    const double upperBound = std::log((1.0 - config.beta) / config.alpha);
+
+    Match match;
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++){
+        workers.emplace_back(playGames, std::cref(config), std::cref(openings), lowerBound, upperBound, std::ref(match));
+    }
+    for (std::thread& worker : workers){
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const Score score = match.score;
+    const double games = static_cast<double>(score.games());
+    double mean = 0.0;
+    double variance = 0.0;
+    scoreMoments(score, mean, variance);
+    const double margin = 1.96 * std::sqrt(variance / games);
+    const double llr = match.llr;
+
+    const char* verdict = "inconclusive";
+    if (llr >= upperBound){
+        verdict = "H1 accepted";
+    }
+    else if (llr <= lowerBound){
+        verdict = "H0 accepted";
+    }
+
+    std::printf("openings     %zu, %lld games on %d threads in %.3f s\n", openings.size(), score.games(), threads, seconds);
+    std::printf("seed         %llu\n", static_cast<unsigned long long>(config.seed));
+    std::printf("A            W %lld  D %lld  L %lld  score %.2f%%\n", score.wins, score.draws, score.losses, 100.0 * mean);
+    std::printf("Elo          %+.1f (95%% CI %+.1f .. %+.1f)\n",
+        scoreToElo(mean), scoreToElo(mean - margin), scoreToElo(mean + margin));
+    std::printf("SPRT         elo0 %+.1f elo1 %+.1f alpha %.3f beta %.3f\n", config.elo0, config.elo1, config.alpha, config.beta);
+    std::printf("LLR          %.3f (%.3f, %.3f) %s\n", llr, lowerBound, upperBound, verdict);
+    return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation file for the Tracer class.
+ *
+ * This file contains the per-thread event buffers and the Chrome trace-event JSON export.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <cstdio>
+#include "trace.h"
+#include "logger.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Names the calling thread in the exported timeline.
+     *
+     * Does nothing while the tracer is not recording, so threads that never record get no buffer.
+     *
+     * @param name The thread name, a string literal or otherwise outliving the tracer.
+     */
+    void Tracer::setThreadName(const char* name){
+        if (!isRecording()){
+            return;
+        }
+        localBuffer().threadName.store(name, std::memory_order_release);
+    }
+
+    /**
+     * @brief Records a completed span of the calling thread.
+     *
+     * @param name The span name.
+     * @param startNsec When the span started, from now().
+     * @param endNsec When the span ended, from now().
+     * @param arg The argument of the span.
+     * @param hasArg false if the span has no argument.
+     */
+    void Tracer::complete(const char* name, uint64_t startNsec, uint64_t endNsec, int64_t arg, bool hasArg){
+        append(Event{ name, startNsec, endNsec - startNsec, arg, Phase::Complete, hasArg });
+    }
+
+    /**
+     * @brief Records the start or end of an arrow between spans, possibly on different threads.
+     *
+     * The arrow starts in the span enclosing the start and ends in the span enclosing the end
+     * with the same name and id.
+     *
+     * @param name The arrow name.
+     * @param id Identifies the arrow among arrows of the same name.
+     * @param start true for the start of the arrow, false for its end.
+     */
+    void Tracer::flow(const char* name, uint64_t id, bool start){
+        if (isRecording()){
+            append(Event{ name, now(), 0, static_cast<int64_t>(id), start ? Phase::FlowStart : Phase::FlowEnd, true });
+        }
+    }
+
+    /**
+     * @brief Gets the buffer of the calling thread, creating it on first use.
+     *
+     * @return The buffer, kept by the tracer until the process exits.
+     */
+    Tracer::Buffer& Tracer::localBuffer(){
+        if (!current){
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.push_back(std::make_unique<Buffer>());
+            buffers.back()->tid = static_cast<int>(buffers.size());
+            current = buffers.back().get();
+        }
+        return *current;
+    }
+
+    /**
+     * @brief Appends an event to the calling thread's buffer.
+     *
+     * The event is published by advancing the count, so an export running at the same time
+     * reads only complete events.
+     *
+     * @param event The event, dropped if the buffer is full.
+     */
+    void Tracer::append(const Event& event){
+        Buffer& buffer = localBuffer();
+        const size_t count = buffer.count.load(std::memory_order_relaxed);
+        if (count >= BUFFER_EVENTS){
+            buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[count] = event;
+        buffer.count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Writes the recorded events as a Chrome trace-event JSON file.
+     *
+     * Spans are complete ("X") events, arrows are flow ("s" and "f") events and every thread
+     * gets a thread_name metadata event. Times are in microseconds since the tracer was created.
+     *
+     * @param path The file to write.
+     * @return true on success, false if the file can not be written.
+     */
+    bool Tracer::writeChromeTrace(const std::string& path) const{
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file){
+            LOG_ERROR("Cannot open trace file " + path);
+            return false;
+        }
+
+        std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        bool first = true;
+        uint64_t dropped = 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<Buffer>& buffer : buffers){
+            const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+            if (threadName){
+                std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",\n", buffer->tid, threadName);
+                first = false;
+            }
+            const size_t count = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; i++){
+                const Event& event = buffer->events[i];
+                std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"tictactoe\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+                    first ? "" : ",\n", event.name, buffer->tid, event.startNsec / 1000.0);
+                first = false;
+                if (Phase::Complete == event.phase){
+                    std::fprintf(file, ",\"ph\":\"X\",\"dur\":%.3f", event.durationNsec / 1000.0);
+                    if (event.hasArg){
+                        std::fprintf(file, ",\"args\":{\"value\":%lld}", static_cast<long long>(event.arg));
+                    }
+                }
+                else{
+                    // The end binds to the enclosing span rather than the next one
+                    std::fprintf(file, ",\"ph\":%s,\"id\":%lld", (Phase::FlowStart == event.phase) ? "\"s\"" : "\"f\",\"bp\":\"e\"",
+                        static_cast<long long>(event.arg));
+                }
+                std::fputc('}', file);
+            }
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        std::fprintf(file, "\n]}\n");
+
+        if (dropped > 0){
+            LOG_ERROR(std::to_string(dropped) + " trace events dropped, the thread buffers were full");
+        }
+        if (0 != std::fclose(file)){
+            LOG_ERROR("Cannot write trace file " + path);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace tictactoe
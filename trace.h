@@ -0,0 +1,218 @@
+/**
+ * @file trace.h
+ * @brief Header file for the Tracer class.
+ *
+ * This file contains the declaration of the Tracer class, which records timed spans of engine
+ * and UI work into per-thread buffers and exports them as a Chrome trace-event JSON file that
+ * chrome://tracing or Perfetto show as a timeline. Spans are placed with the TRACE_SCOPE
+ * macros, which compile to nothing unless the build sets TICTACTOE_TRACE (the CMake option of
+ * the same name), and record only while the tracer is started.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 1 to compile the trace spans in, 0 to leave them out
+#ifndef TICTACTOE_TRACE
+#define TICTACTOE_TRACE 0
+#endif
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if TICTACTOE_TRACE
+#define TRACE_SCOPE(name) ::tictactoe::TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_SCOPE_ARG(name, value) ::tictactoe::TraceSpan TRACE_CONCAT(traceSpan, __LINE__)((name), static_cast<int64_t>(value))
+#define TRACE_FLOW_START(name, id) ::tictactoe::Tracer::getInstance().flow((name), (id), true)
+#define TRACE_FLOW_END(name, id) ::tictactoe::Tracer::getInstance().flow((name), (id), false)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_ARG(name, value) ((void)0)
+#define TRACE_FLOW_START(name, id) ((void)0)
+#define TRACE_FLOW_END(name, id) ((void)0)
+#endif
+
+namespace tictactoe{
+
+    /**
+     * @brief The Tracer class collects trace events of all threads.
+     *
+     * Each thread appends to a fixed-size buffer of its own, so recording takes no lock; a
+     * full buffer drops further events and counts them. Buffers are kept after their thread
+     * exits so the export covers short-lived worker threads. Event names must be string
+     * literals or otherwise outlive the tracer.
+     */
+    class Tracer{
+    public:
+        static constexpr size_t BUFFER_EVENTS = 65536; // Events kept per thread
+
+        /**
+         * @brief Get the single instance of the tracer.
+         */
+        inline static Tracer& getInstance(){
+            static Tracer instance;
+            return instance;
+        }
+
+        /**
+         * @brief Checks whether the trace spans are compiled in.
+         */
+        static constexpr bool isCompiledIn() { return 0 != TICTACTOE_TRACE; }
+
+        /**
+         * @brief Starts recording, events of an earlier recording are kept.
+         */
+        inline void start() { recording.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Stops recording, the recorded events are kept for export.
+         */
+        inline void stop() { recording.store(false, std::memory_order_relaxed); }
+
+        /**
+         * @brief Checks if events are being recorded.
+         */
+        inline bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Names the calling thread in the exported timeline.
+         */
+        void setThreadName(const char* name);
+
+        /**
+         * @brief Records a completed span of the calling thread.
+         */
+        void complete(const char* name, uint64_t startNsec, uint64_t endNsec, int64_t arg, bool hasArg);
+
+        /**
+         * @brief Records the start or end of an arrow between spans, possibly on different threads.
+         */
+        void flow(const char* name, uint64_t id, bool start);
+
+        /**
+         * @brief Writes the recorded events as a Chrome trace-event JSON file.
+         */
+        bool writeChromeTrace(const std::string& path) const;
+
+        /**
+         * @brief Gets the time since the tracer was created in nanoseconds.
+         */
+        inline uint64_t now() const{
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - epoch).count());
+        }
+
+    private:
+        /**
+         * @brief Kind of a trace event.
+         */
+        enum class Phase : uint8_t { Complete, FlowStart, FlowEnd };
+
+        /**
+         * @brief One trace event.
+         */
+        struct Event{
+            const char* name;
+            uint64_t startNsec;
+            uint64_t durationNsec;
+            int64_t arg; // Span argument or flow id
+            Phase phase;
+            bool hasArg;
+        };
+
+        /**
+         * @brief The events of one thread, written by that thread only.
+         */
+        struct Buffer{
+            std::unique_ptr<Event[]> events{ new Event[BUFFER_EVENTS] };
+            std::atomic<size_t> count{ 0 }; // Events written, published after each event
+            std::atomic<uint64_t> dropped{ 0 };
+            std::atomic<const char*> threadName{ nullptr };
+            int tid = 0;
+        };
+
+        // Private constructor to prevent external instantiation
+        Tracer() = default;
+
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        /**
+         * @brief Gets the buffer of the calling thread, creating it on first use.
+         */
+        Buffer& localBuffer();
+
+        /**
+         * @brief Appends an event to the calling thread's buffer.
+         */
+        void append(const Event& event);
+
+    private:
+        static inline thread_local Buffer* current = nullptr; // Buffer of the calling thread, null until it records
+
+        const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        std::atomic<bool> recording{ false };
+        mutable std::mutex mutex; // Guards the buffer list
+        std::vector<std::unique_ptr<Buffer>> buffers; // One per thread that recorded, kept until exit
+    };
+
+    /**
+     * @brief Records the lifetime of a scope as a span, used through TRACE_SCOPE.
+     */
+    class TraceSpan{
+    public:
+        /**
+         * @brief Starts a span without an argument.
+         */
+        explicit TraceSpan(const char* name_i) : TraceSpan(name_i, 0, false) {}
+
+        /**
+         * @brief Starts a span with an integer argument shown with it.
+         */
+        TraceSpan(const char* name_i, int64_t arg_i) : TraceSpan(name_i, arg_i, true) {}
+
+        /**
+         * @brief Records the span if the tracer was recording when it started.
+         */
+        ~TraceSpan(){
+            if (active){
+                Tracer& tracer = Tracer::getInstance();
+                tracer.complete(name, startNsec, tracer.now(), arg, hasArg);
+            }
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        TraceSpan(const char* name_i, int64_t arg_i, bool hasArg_i)
+            : name(name_i), arg(arg_i), hasArg(hasArg_i), startNsec(0), active(Tracer::getInstance().isRecording()){
+            if (active){
+                startNsec = Tracer::getInstance().now();
+            }
+        }
+
+    private:
+        const char* name;
+        int64_t arg;
+        bool hasArg;
+        uint64_t startNsec;
+        bool active;
+    };
+
+} // namespace tictactoe
+
+#endif // TRACE_H
@@ -0,0 +1,82 @@
+/**
+ * @file transpositiontable.cpp
+ * @brief Implementation file for the TranspositionTable class.
+ *
+ * This file contains the implementation of the TranspositionTable class.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include "transpositiontable.h"
+
+namespace tictactoe{
+
+    /**
+     * @brief Constructs a table with the given number of slots.
+     *
+     * @param entries The number of slots, rounded up to a power of two.
+     */
+    TranspositionTable::TranspositionTable(std::size_t entries){
+        std::size_t count = 1;
+        while (count < entries){
+            count <<= 1;
+        }
+        this->entries.resize(count);
+        mask = count - 1;
+    }
+
+    /**
+     * @brief Looks up the score of a position searched to the given depth.
+     *
+     * A result is reused if it was searched to exactly the same depth, or if its search only
+     * reached terminal positions and so holds for any deeper search as well.
+     *
+     * @param key The key of the position.
+     * @param depth The remaining search depth.
+     * @param score Receives the stored score on a hit.
+     * @param bound Receives how the stored score bounds the true score.
+     * @param complete Receives whether the stored search only reached terminal positions.
+     * @return true if a usable result was found, false otherwise.
+     */
+    bool TranspositionTable::probe(uint64_t key, int depth, int& score, Bound& bound, bool& complete) const{
+        const Entry& entry = entries[key & mask];
+        if (!(entry.flags & VALID) || entry.key != key){
+            return false;
+        }
+        const bool entryComplete = 0 != (entry.flags & COMPLETE);
+        if (entry.depth == depth || (entryComplete && entry.depth <= depth)){
+            score = entry.score;
+            bound = static_cast<Bound>(entry.flags >> BOUND_SHIFT);
+            complete = entryComplete;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Stores the score of a position searched to the given depth.
+     *
+     * @param key The key of the position.
+     * @param depth The remaining search depth.
+     * @param score The minimax score of the position.
+     * @param bound How the score bounds the true score, searches cut off by alpha-beta store bounds.
+     * @param complete true if the search only reached terminal positions.
+     */
+    void TranspositionTable::store(uint64_t key, int depth, int score, Bound bound, bool complete){
+        Entry& entry = entries[key & mask];
+        entry.key = key;
+        entry.score = score;
+        entry.depth = static_cast<int16_t>(depth);
+        entry.flags = static_cast<uint8_t>(VALID | (complete ? COMPLETE : 0) | (static_cast<uint8_t>(bound) << BOUND_SHIFT));
+    }
+
+    /**
+     * @brief Removes all entries.
+     */
+    void TranspositionTable::clear(){
+        std::fill(entries.begin(), entries.end(), Entry());
+    }
+
+} // namespace tictactoe
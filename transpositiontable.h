@@ -0,0 +1,86 @@
+/**
+ * @file transpositiontable.h
+ * @brief Header file for the TranspositionTable class.
+ *
+ * This file contains the declaration of the TranspositionTable class, a fixed size hash table
+ * that caches minimax results of already searched positions.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ *
+ * @license MIT License
+ */
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace tictactoe{
+
+    /**
+     * @brief The TranspositionTable class caches search results by position key.
+     *
+     * The table has a fixed number of slots and always replaces on collision, so storing
+     * and probing never allocate.
+     */
+    class TranspositionTable{
+    public:
+        /**
+         * @brief Default number of slots, must be a power of two.
+         */
+        static constexpr std::size_t DEFAULT_ENTRIES = std::size_t(1) << 18;
+
+        /**
+         * @brief How a stored score relates to the true score of the position.
+         */
+        enum class Bound : uint8_t{
+            Exact, /**< The score is exact. */
+            Lower, /**< The true score is at least the stored score. */
+            Upper  /**< The true score is at most the stored score. */
+        };
+
+        /**
+         * @brief Constructs a table with the given number of slots.
+         */
+        explicit TranspositionTable(std::size_t entries = DEFAULT_ENTRIES);
+
+        /**
+         * @brief Looks up the score of a position searched to the given depth.
+         */
+        bool probe(uint64_t key, int depth, int& score, Bound& bound, bool& complete) const;
+
+        /**
+         * @brief Stores the score of a position searched to the given depth.
+         */
+        void store(uint64_t key, int depth, int score, Bound bound, bool complete);
+
+        /**
+         * @brief Removes all entries.
+         */
+        void clear();
+
+    private:
+        /**
+         * @brief A single slot of the table.
+         */
+        struct Entry{
+            uint64_t key = 0; /**< Full key of the stored position. */
+            int32_t score = 0; /**< Minimax score of the position. */
+            int16_t depth = 0; /**< Remaining depth the position was searched to. */
+            uint8_t flags = 0; /**< VALID and COMPLETE bits, and the Bound shifted by BOUND_SHIFT. */
+        };
+
+        static constexpr uint8_t VALID = 1; /**< The slot holds a position. */
+        static constexpr uint8_t COMPLETE = 2; /**< The search reached only terminal positions. */
+        static constexpr int BOUND_SHIFT = 2;
+
+        std::vector<Entry> entries; /**< The slots of the table. */
+        std::size_t mask; /**< Mask mapping a key to a slot index. */
+    };
+
+} // namespace tictactoe
+
+#endif // TRANSPOSITIONTABLE_H
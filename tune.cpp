@@ -0,0 +1,360 @@
+/**
+ * @file tune.cpp
+ * @brief Implementation file for the evaluation weight tuner.
+ *
+ * This file contains a command line tool that fits the weights of the heuristic evaluation
+ * to the outcomes of recorded games. Every position before a move of a finished game is a
+ * sample labelled with the result for the side to move; identical positions are merged into
+ * one row of a contiguous feature matrix weighted by their count. The weights are fitted by
+ * logistic regression (Texel tuning) with full-batch gradient descent, the gradient summed
+ * over row slices by all cores, and written to a weights file the engine loads at startup.
+ *
+ * @author Binu Melit Devassy
+ * @date 2026-10-18
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "evalweights.h"
+#include "gamerecord.h"
+#include "notation.h"
+#include "positiondb.h"
+
+using namespace tictactoe;
+
+namespace {
+
+    /**
+     * @brief Settings of a tuning run.
+     */
+    struct Config{
+        const char* output = nullptr;
+        std::vector<std::string> inputs;
+        int size = DEFAULT_BOARD_SIZE;
+        int threads = 0;
+        int iterations = 2000;
+        double rate = 0.05;
+        double l2 = 1e-4;
+    };
+
+    /**
+     * @brief Labelled positions, one row per distinct position.
+     *
+     * Features are stored row-major in one array so a pass over the data streams through memory.
+     */
+    struct Samples{
+        int features = 0; // Columns of the matrix
+        std::vector<float> matrix; // rows x features
+        std::vector<float> labels; // Mean result for the side to move, 1 win, 0.5 draw, 0 loss
+        std::vector<float> counts; // Games the position occurred in
+        std::unordered_map<uint64_t, size_t> rows; // Canonical key to row, only while loading
+
+        inline size_t rowCount() const { return labels.size(); }
+    };
+
+    /**
+     * @brief Adds the positions of the finished games of the chunks taken from the shared counter.
+     */
+    void loadSamples(const Config& config, const std::vector<std::unique_ptr<GameRecordReader>>& readers,
+                     const std::vector<GameChunk>& chunks, std::atomic<size_t>& nextChunk, Samples& samples){
+        GameRecord record;
+        Board board(config.size);
+        std::vector<float> features(static_cast<size_t>(samples.features));
+        for (size_t c = nextChunk.fetch_add(1); c < chunks.size(); c = nextChunk.fetch_add(1)){
+            for (size_t game = chunks[c].first; game < chunks[c].last; game++){
+                if (!readers[chunks[c].file]->readGame(game, record) || !record.finished || record.size != config.size){
+                    continue;
+                }
+                board.startNewGame(record.size);
+                Symbol mover = record.firstMover;
+                for (const RecordedMove& move : record.moves){
+                    const float label = (Symbol::None == record.winner) ? 0.5f : (mover == record.winner) ? 1.0f : 0.0f;
+                    int symmetry = 0;
+                    const uint64_t key = PositionDB::canonicalKey(board, mover, symmetry);
+                    auto found = samples.rows.find(key);
+                    if (samples.rows.end() == found){
+                        EvalWeights::extractFeatures(board, mover, features.data());
+                        samples.rows.emplace(key, samples.rowCount());
+                        samples.matrix.insert(samples.matrix.end(), features.begin(), features.end());
+                        samples.labels.push_back(label);
+                        samples.counts.push_back(1.0f);
+                    }
+                    else{
+                        const size_t row = found->second;
+                        samples.labels[row] += label; // Summed here, averaged once merged
+                        samples.counts[row] += 1.0f;
+                    }
+                    if (!board.makeMove(move.pos, mover)){
+                        break;
+                    }
+                    mover = board.getOpponent(mover);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Merges the samples of all workers into the first one and averages the labels.
+     */
+    void mergeSamples(std::vector<Samples>& parts){
+        Samples& merged = parts[0];
+        for (size_t p = 1; p < parts.size(); p++){
+            Samples& part = parts[p];
+            for (const auto& item : part.rows){
+                const size_t row = item.second;
+                auto found = merged.rows.find(item.first);
+                if (merged.rows.end() == found){
+                    merged.rows.emplace(item.first, merged.rowCount());
+                    merged.matrix.insert(merged.matrix.end(), part.matrix.begin() + static_cast<std::ptrdiff_t>(row * part.features),
+                                         part.matrix.begin() + static_cast<std::ptrdiff_t>((row + 1) * part.features));
+                    merged.labels.push_back(part.labels[row]);
+                    merged.counts.push_back(part.counts[row]);
+                }
+                else{
+                    merged.labels[found->second] += part.labels[row];
+                    merged.counts[found->second] += part.counts[row];
+                }
+            }
+            part = Samples();
+        }
+        for (size_t row = 0; row < merged.rowCount(); row++){
+            merged.labels[row] /= merged.counts[row];
+        }
+        merged.rows.clear();
+    }
+
+    inline double sigmoid(double x){
+        return 1.0 / (1.0 + std::exp(-x));
+    }
+
+    /**
+     * @brief Adds the count weighted gradient, and if asked the loss, of rows [first, last) to the sums.
+     */
+    void accumulateGradient(const Samples& samples, const std::vector<double>& weights, size_t first, size_t last,
+                            bool withLoss, std::vector<double>& gradient, double& loss){
+        const int features = samples.features;
+        for (size_t row = first; row < last; row++){
+            const float* x = &samples.matrix[row * static_cast<size_t>(features)];
+            double sum = 0.0;
+            for (int j = 0; j < features; j++){
+                sum += weights[j] * x[j];
+            }
+            const double p = std::min(std::max(sigmoid(sum), 1e-12), 1.0 - 1e-12);
+            const double y = samples.labels[row];
+            const double count = samples.counts[row];
+            if (withLoss){
+                loss -= count * (y * std::log(p) + (1.0 - y) * std::log(1.0 - p));
+            }
+            const double error = count * (p - y);
+            for (int j = 0; j < features; j++){
+                gradient[j] += error * x[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the mean gradient, and if asked the mean loss, over all rows with the given number of threads.
+     */
+    double computeGradient(const Samples& samples, const std::vector<double>& weights, double totalCount, int threads,
+                           bool withLoss, std::vector<double>& gradient){
+        const size_t features = static_cast<size_t>(samples.features);
+        std::vector<std::vector<double>> partial(static_cast<size_t>(threads), std::vector<double>(features, 0.0));
+        std::vector<double> losses(static_cast<size_t>(threads), 0.0);
+        const size_t slice = (samples.rowCount() + static_cast<size_t>(threads) - 1) / static_cast<size_t>(threads);
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++){
+            const size_t first = std::min(samples.rowCount(), slice * static_cast<size_t>(t));
+            const size_t last = std::min(samples.rowCount(), first + slice);
+            workers.emplace_back(accumulateGradient, std::cref(samples), std::cref(weights), first, last, withLoss,
+                                 std::ref(partial[static_cast<size_t>(t)]), std::ref(losses[static_cast<size_t>(t)]));
+        }
+        accumulateGradient(samples, weights, 0, std::min(samples.rowCount(), slice), withLoss, partial[0], losses[0]);
+        for (std::thread& worker : workers){
+            worker.join();
+        }
+
+        double loss = 0.0;
+        std::fill(gradient.begin(), gradient.end(), 0.0);
+        for (int t = 0; t < threads; t++){
+            loss += losses[static_cast<size_t>(t)];
+            for (size_t j = 0; j < features; j++){
+                gradient[j] += partial[static_cast<size_t>(t)][j];
+            }
+        }
+        for (size_t j = 0; j < features; j++){
+            gradient[j] /= totalCount;
+        }
+        return loss / totalCount;
+    }
+
+    int run(const Config& config){
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::unique_ptr<GameRecordReader>> readers;
+        std::vector<GameChunk> chunks;
+        for (const std::string& input : config.inputs){
+            readers.push_back(std::make_unique<GameRecordReader>());
+            if (!readers.back()->open(input)){
+                return 1;
+            }
+            readers.back()->appendChunks(readers.size() - 1, chunks);
+        }
+
+        int threads = config.threads;
+        if (0 == threads){
+            threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+
+        // Load, every worker fills its own samples which are merged afterwards
+        const int loaders = std::max(1, std::min(threads, static_cast<int>(chunks.size())));
+        std::vector<Samples> parts(static_cast<size_t>(loaders));
+        for (Samples& part : parts){
+            part.features = EvalWeights::featureCount(config.size);
+        }
+        std::atomic<size_t> nextChunk{ 0 };
+        std::vector<std::thread> workers;
+        for (int t = 0; t < loaders; t++){
+            workers.emplace_back(loadSamples, std::cref(config), std::cref(readers), std::cref(chunks), std::ref(nextChunk),
+                                 std::ref(parts[static_cast<size_t>(t)]));
+        }
+        for (std::thread& worker : workers){
+            worker.join();
+        }
+        mergeSamples(parts);
+        const Samples& samples = parts[0];
+        if (0 == samples.rowCount()){
+            std::fprintf(stderr, "no finished games of size %d\n", config.size);
+            return 1;
+        }
+        double totalCount = 0.0;
+        for (float count : samples.counts){
+            totalCount += count;
+        }
+        const double loaded = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("samples      %.0f positions, %zu distinct, loaded in %.3f s\n", totalCount, samples.rowCount(), loaded);
+
+        // Fit with Adam on the full batch, the L2 term keeps weights of rare features small
+        const size_t features = static_cast<size_t>(samples.features);
+        std::vector<double> weights(features, 0.0);
+        std::vector<double> gradient(features, 0.0);
+        std::vector<double> moment(features, 0.0);
+        std::vector<double> velocity(features, 0.0);
+        const double beta1 = 0.9;
+        const double beta2 = 0.999;
+        for (int iteration = 1; iteration <= config.iterations; iteration++){
+            const double loss = computeGradient(samples, weights, totalCount, threads, 1 == iteration, gradient);
+            if (1 == iteration){
+                std::printf("loss         %.6f initial\n", loss);
+            }
+            for (size_t j = 0; j < features; j++){
+                const double g = gradient[j] + config.l2 * weights[j];
+                moment[j] = beta1 * moment[j] + (1.0 - beta1) * g;
+                velocity[j] = beta2 * velocity[j] + (1.0 - beta2) * g * g;
+                const double mHat = moment[j] / (1.0 - std::pow(beta1, iteration));
+                const double vHat = velocity[j] / (1.0 - std::pow(beta2, iteration));
+                weights[j] -= config.rate * mHat / (std::sqrt(vHat) + 1e-8);
+            }
+        }
+        const double loss = computeGradient(samples, weights, totalCount, threads, true, gradient);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("loss         %.6f after %d iterations, %.3f s with %d threads\n", loss, config.iterations, seconds, threads);
+
+        // Keep the weights of other board sizes already in the file
+        EvalWeights evalWeights;
+        if (std::ifstream(config.output).good() && !evalWeights.load(config.output)){
+            return 1;
+        }
+        std::vector<float> tuned(weights.begin(), weights.end());
+        evalWeights.setWeights(config.size, tuned);
+        if (!evalWeights.save(config.output)){
+            return 1;
+        }
+        std::printf("weights     ");
+        for (float weight : tuned){
+            std::printf(" %.4f", weight);
+        }
+        std::printf("\n");
+        return 0;
+    }
+
+    void printUsage(const char* program){
+        std::fprintf(stderr,
+            "Usage: %s OUT RECORDS... [options]\n"
+            "  --size N         board size to tune (default %d)\n"
+            "  --threads N      worker threads (default: all cores)\n"
+            "  --iterations N   gradient descent iterations (default 2000)\n"
+            "  --rate X         learning rate (default 0.05)\n"
+            "  --l2 X           L2 regularization (default 0.0001)\n"
+            "The weights of the size are written to OUT, keeping those of other sizes.\n",
+            program, DEFAULT_BOARD_SIZE);
+    }
+
+    bool parseArguments(int argc, char* argv[], Config& config){
+        for (int i = 1; i < argc; i++){
+            const char* arg = argv[i];
+            if (0 != std::strncmp(arg, "--", 2)){
+                if (!config.output){
+                    config.output = arg;
+                }
+                else{
+                    config.inputs.push_back(arg);
+                }
+                continue;
+            }
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value){
+                return false;
+            }
+            if (0 == std::strcmp(arg, "--size")){
+                config.size = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--threads")){
+                config.threads = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--iterations")){
+                config.iterations = std::atoi(value);
+            }
+            else if (0 == std::strcmp(arg, "--rate")){
+                config.rate = std::atof(value);
+            }
+            else if (0 == std::strcmp(arg, "--l2")){
+                config.l2 = std::atof(value);
+            }
+            else{
+                return false;
+            }
+            i++;
+        }
+        return config.output && !config.inputs.empty() && config.size >= 2 && config.size <= MAX_NOTATION_SIZE && config.threads >= 0
+            && config.iterations > 0 && config.rate > 0.0 && config.l2 >= 0.0;
+    }
+
+} // namespace
+
+/**
+ * @brief Entry point of the evaluation weight tuner.
+ *
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments.
+ * @return int The exit code of the application.
+ */
+int main(int argc, char* argv[])
+{
+    Config config;
+    if (!parseArguments(argc, argv, config)){
+        printUsage(argv[0]);
+        return 1;
+    }
+    return run(config);
+}